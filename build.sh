@@ -239,6 +239,11 @@ if test "$enable_pt" = "yes"; then
     LD_LIBRARY_PATH="$LD_LIBRARY_PATH:$build_dir/libpysdcxx" \
     python src/perf_test/matching.py -T0.8 \
         -t src/perf_test/short.txt -s src/perf_test/sequences.txt
+
+    if test -x "$build_dir/perf_test/cxx/perf_bigrams"; then
+        echo "Native code performance (results in $build_dir/perf_test/cxx/*.json):"
+        cmake --build "$build_dir" --target perf_test_cxx
+    fi
 fi
 
 
@@ -30,9 +30,14 @@ setup(name="pysdcxx",
         "libpysdcxx",
         sources=[
             "src/libpysdcxx/bigrams.cxx",
+            "src/libpysdcxx/flat_bigrams.cxx",
             "src/libpysdcxx/bigram_multiset.cxx",
             "src/libpysdcxx/unordered_bigram_multiset.cxx",
+            "src/libpysdcxx/hashed_bigram_multiset.cxx",
             "src/libpysdcxx/sequence_matcher.cxx",
+            "src/libpysdcxx/bigram_index.cxx",
+            "src/libpysdcxx/pattern_set.cxx",
+            "src/libpysdcxx/stream_matcher.cxx",
         ],
         extra_compile_args=["-Isrc", "-std=c++17"],
     )],
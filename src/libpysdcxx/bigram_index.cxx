@@ -0,0 +1,106 @@
+/**
+ *  \file
+ *  \brief  Inverted bigram index: Python binding
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "libsdcxx/bigram_index.hxx"
+#include "libsdcxx/bigrams.hxx"
+
+#include <vector>
+
+
+using wbigram_index = libsdcxx::wbigram_index;
+using wbigrams = libsdcxx::wbigrams;
+using bigram_index_match = libsdcxx::bigram_index_match;
+using bigram_index_matches = std::vector<bigram_index_match>;
+
+
+extern "C" {
+
+/** Constructor */
+wbigram_index * new_wbigram_index() { return new wbigram_index(); }
+
+/** Destructor */
+void delete_wbigram_index(wbigram_index * index) { delete index; }
+
+/** Reserve space for entries */
+void wbigram_index_reserve(wbigram_index * index, size_t entry_cnt) {
+    index->reserve(entry_cnt);
+}
+
+/** Number of entries */
+size_t wbigram_index_size(const wbigram_index * index) { return index->size(); }
+
+/** Remove all entries */
+void wbigram_index_clear(wbigram_index * index) { index->clear(); }
+
+/** Insert entry (returns entry ID) */
+size_t wbigram_index_insert(wbigram_index * index, const wbigrams * bgrms) {
+    return index->insert(*bgrms);
+}
+
+/** Threshold lookup (returns number of matches) */
+size_t wbigram_index_lookup(
+    const wbigram_index * index,
+    const wbigrams * query,
+    double threshold,
+    bigram_index_matches * matches)
+{
+    matches->clear();
+    index->lookup(*query, threshold,
+        [matches](const bigram_index_match & match) { matches->push_back(match); });
+
+    return matches->size();
+}
+
+
+/** Matches buffer constructor */
+bigram_index_matches * new_bigram_index_matches() { return new bigram_index_matches(); }
+
+/** Matches buffer destructor */
+void delete_bigram_index_matches(bigram_index_matches * matches) { delete matches; }
+
+/** Matches buffer data (array of match records) */
+const bigram_index_match * bigram_index_matches_data(
+    const bigram_index_matches * matches)
+{
+    return matches->data();
+}
+
+}  // end of extern "C" decl
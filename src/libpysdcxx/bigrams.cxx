@@ -39,11 +39,15 @@
  */
 
 #include "libsdcxx/bigrams.hxx"
+#include "libsdcxx/binary.hxx"
 
 #include "util.hxx"
 
 #include <sstream>
+#include <string_view>
+#include <vector>
 #include <cwchar>
+#include <cstring>
 
 
 using wbigrams = libsdcxx::wbigrams;
@@ -59,6 +63,44 @@ wbigrams * new_wbigrams_str(const wchar_t * str) {
     return new wbigrams(str);
 }
 
+/** Constructor (from UTF-8 string) */
+wbigrams * new_wbigrams_utf8(const char * str, size_t len) {
+    return new wbigrams(libsdcxx::utf8, std::string_view(str, len));
+}
+
+/** Bulk constructor (from UTF-8 text; i-th string is at [offsets[i], offsets[i+1])) */
+void new_wbigrams_bulk_utf8(
+    const char * text, const size_t * offsets, size_t cnt, wbigrams ** bgrms)
+{
+    for (size_t i = 0; i < cnt; ++i)
+        bgrms[i] = new wbigrams(libsdcxx::utf8,
+            std::string_view(text + offsets[i], offsets[i + 1] - offsets[i]));
+}
+
+/** Constructor (from binary representation, returns NULL if malformed) */
+wbigrams * new_wbigrams_binary(const char * data, size_t size) {
+    try { return new wbigrams(libsdcxx::deserialise_binary<wbigrams>(data, size)); }
+    catch (const libsdcxx::binary_format_error & ) { return nullptr; }
+}
+
+/** Bulk constructor (from array of strings, handles are stored to bgrms array) */
+void new_wbigrams_bulk(const wchar_t * const * strs, size_t cnt, wbigrams ** bgrms) {
+    for (size_t i = 0; i < cnt; ++i) bgrms[i] = new wbigrams(strs[i]);
+}
+
+/** Union constructor (from array of strings) */
+wbigrams * new_wbigrams_union(const wchar_t * const * strs, size_t cnt) {
+    std::vector<wbigrams> bgrms;
+    bgrms.reserve(cnt);
+    for (size_t i = 0; i < cnt; ++i) bgrms.emplace_back(strs[i]);
+    return new wbigrams(wbigrams::unite(bgrms.cbegin(), bgrms.cend()));
+}
+
+/** Union constructor (from array of bigrams) */
+wbigrams * new_wbigrams_unite(const wbigrams * const * bgrms, size_t cnt) {
+    return new wbigrams(wbigrams::unite(bgrms, bgrms + cnt));
+}
+
 /** Copy constructor */
 wbigrams * new_wbigrams_copy(const wbigrams * bgrms) { return new wbigrams(*bgrms); }
 
@@ -69,6 +111,14 @@ void delete_wbigrams(wbigrams * bgrms) { delete bgrms; }
 /** Bigrams size */
 size_t wbigrams_size(const wbigrams * bgrms) { return bgrms->size(); }
 
+/** Binary representation (returns its size, stored to buff if it fits) */
+size_t wbigrams_binary(const wbigrams * bgrms, char * buff, size_t buff_size) {
+    const auto binary = libsdcxx::serialise_binary(*bgrms);
+    if (binary.size() <= buff_size) std::memcpy(buff, binary.data(), binary.size());
+
+    return binary.size();
+}
+
 
 /** Begin const. iterator */
 wbigrams::const_iterator * wbigrams_cbegin(const wbigrams * bgrms) {
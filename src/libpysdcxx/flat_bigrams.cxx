@@ -0,0 +1,151 @@
+/**
+ *  \file
+ *  \brief  Sørensen–Dice coefficient on multisets of bigrams (flat storage):
+ *          Python binding
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libsdcxx/bigrams.hxx"
+
+#include "util.hxx"
+
+#include <sstream>
+#include <cwchar>
+
+
+using wflat_bigrams = libsdcxx::wflat_bigrams;
+
+
+extern "C" {
+
+/** Default constructor */
+wflat_bigrams * new_wflat_bigrams() { return new wflat_bigrams(); }
+
+/** Constructor (from string) */
+wflat_bigrams * new_wflat_bigrams_str(const wchar_t * str) {
+    return new wflat_bigrams(str);
+}
+
+/** Copy constructor */
+wflat_bigrams * new_wflat_bigrams_copy(const wflat_bigrams * bgrms) {
+    return new wflat_bigrams(*bgrms);
+}
+
+/** Destructor */
+void delete_wflat_bigrams(wflat_bigrams * bgrms) { delete bgrms; }
+
+
+/** Bigrams size */
+size_t wflat_bigrams_size(const wflat_bigrams * bgrms) { return bgrms->size(); }
+
+
+/** Begin const. iterator */
+wflat_bigrams::const_iterator * wflat_bigrams_cbegin(const wflat_bigrams * bgrms) {
+    return new wflat_bigrams::const_iterator(bgrms->cbegin());
+}
+
+/** End const. iterator */
+wflat_bigrams::const_iterator * wflat_bigrams_cend(const wflat_bigrams * bgrms) {
+    return new wflat_bigrams::const_iterator(bgrms->cend());
+}
+
+/** Compare const. iterators (!=) */
+int wflat_bigrams_citer_ne(
+    const wflat_bigrams::const_iterator * iter1,
+    const wflat_bigrams::const_iterator * iter2)
+{
+    return *iter1 != *iter2 ? 1 : 0;
+}
+
+/** Dereference const. iterator */
+void wflat_bigrams_citer_deref(
+    const wflat_bigrams::const_iterator * iter,
+    wchar_t * ch1, wchar_t * ch2, size_t * cnt)
+{
+    const auto & bigram_cnt = **iter;
+    const auto & bigram = std::get<0>(bigram_cnt);
+    *ch1 = std::get<0>(bigram);
+    *ch2 = std::get<1>(bigram);
+    *cnt = std::get<1>(bigram_cnt);
+}
+
+/** Increment const. iterator */
+void wflat_bigrams_citer_inc(wflat_bigrams::const_iterator * iter) { ++*iter; }
+
+/** Iterator destructor */
+void delete_wflat_bigrams_citer(wflat_bigrams::const_iterator * iter) { delete iter; }
+
+
+/** += operator (add right argument bigrams to left argument) */
+wflat_bigrams * wflat_bigrams_iadd(wflat_bigrams * larg, const wflat_bigrams * rarg) {
+    *larg += *rarg;
+    return larg;
+}
+
+/** + operator (produce new union of 2 bigrams) */
+wflat_bigrams * wflat_bigrams_add(
+    const wflat_bigrams * arg1,
+    const wflat_bigrams * arg2)
+{
+    return new wflat_bigrams(*arg1 + *arg2);
+}
+
+
+/** Calculate intersection size */
+size_t wflat_bigrams_intersect_size(
+    const wflat_bigrams * bgrms1,
+    const wflat_bigrams * bgrms2)
+{
+    return wflat_bigrams::intersect_size(*bgrms1, *bgrms2);
+}
+
+
+/** Calculate Sørensen–Dice coefficient */
+double wflat_bigrams_sorensen_dice_coef(
+    const wflat_bigrams * bgrms1,
+    const wflat_bigrams * bgrms2)
+{
+    return wflat_bigrams::sorensen_dice_coef(*bgrms1, *bgrms2);
+}
+
+
+/** Serialise bigrams */
+size_t wflat_bigrams_str(const wflat_bigrams * bgrms, wchar_t * buffer, size_t max_len) {
+    return libpysdc::serialise(*bgrms, buffer, max_len);
+}
+
+}  // end of extern "C" decl
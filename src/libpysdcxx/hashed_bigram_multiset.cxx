@@ -0,0 +1,173 @@
+/**
+ *  \file
+ *  \brief  Hashed bigram multiset: Python binding
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "libsdcxx/hashed_bigram_multiset.hxx"
+
+#include "util.hxx"
+
+#include <sstream>
+#include <cwchar>
+
+
+using hashed_wbigram_multiset = libsdcxx::hashed_wbigram_multiset;
+
+
+extern "C" {
+
+/** Default constructor */
+hashed_wbigram_multiset * new_hashed_wbigram_multiset() {
+    return new hashed_wbigram_multiset();
+}
+
+/** Constructor (from string) */
+hashed_wbigram_multiset * new_hashed_wbigram_multiset_str(const wchar_t * str) {
+    return new hashed_wbigram_multiset(str);
+}
+
+/** Copy constructor */
+hashed_wbigram_multiset * new_hashed_wbigram_multiset_copy(
+    const hashed_wbigram_multiset * bgrms)
+{
+    return new hashed_wbigram_multiset(*bgrms);
+}
+
+/** Destructor */
+void delete_hashed_wbigram_multiset(hashed_wbigram_multiset * bgrms) {
+    delete bgrms;
+}
+
+
+/** Bigrams size */
+size_t hashed_wbigram_multiset_size(const hashed_wbigram_multiset * bgrms) {
+    return bgrms->size();
+}
+
+
+/** Begin const. iterator */
+hashed_wbigram_multiset::const_iterator * hashed_wbigram_multiset_cbegin(
+    const hashed_wbigram_multiset * bgrms)
+{
+    return new hashed_wbigram_multiset::const_iterator(bgrms->cbegin());
+}
+
+/** End const. iterator */
+hashed_wbigram_multiset::const_iterator * hashed_wbigram_multiset_cend(
+    const hashed_wbigram_multiset * bgrms)
+{
+    return new hashed_wbigram_multiset::const_iterator(bgrms->cend());
+}
+
+/** Compare const. iterators (!=) */
+int hashed_wbigram_multiset_citer_ne(
+    const hashed_wbigram_multiset::const_iterator * iter1,
+    const hashed_wbigram_multiset::const_iterator * iter2)
+{
+    return *iter1 != *iter2 ? 1 : 0;
+}
+
+/** Dereference const. iterator */
+void hashed_wbigram_multiset_citer_deref(
+    const hashed_wbigram_multiset::const_iterator * iter,
+    wchar_t * ch1, wchar_t * ch2)
+{
+    const auto & bigram = **iter;
+    *ch1 = std::get<0>(bigram);
+    *ch2 = std::get<1>(bigram);
+}
+
+/** Increment const. iterator */
+void hashed_wbigram_multiset_citer_inc(
+    hashed_wbigram_multiset::const_iterator * iter)
+{
+    ++*iter;
+}
+
+/** Iterator destructor */
+void delete_hashed_wbigram_multiset_citer(
+    hashed_wbigram_multiset::const_iterator * iter)
+{
+    delete iter;
+}
+
+
+/** += operator (add right argument bigrams to left argument) */
+hashed_wbigram_multiset * hashed_wbigram_multiset_iadd(
+    hashed_wbigram_multiset * larg,
+    const hashed_wbigram_multiset * rarg)
+{
+    *larg += *rarg;
+    return larg;
+}
+
+/** + operator (produce new union of 2 bigrams) */
+hashed_wbigram_multiset * hashed_wbigram_multiset_add(
+    const hashed_wbigram_multiset * arg1,
+    const hashed_wbigram_multiset * arg2)
+{
+    return new hashed_wbigram_multiset(*arg1 + *arg2);
+}
+
+
+/** Calculate intersection size */
+size_t hashed_wbigram_multiset_intersect_size(
+    const hashed_wbigram_multiset * bgrms1,
+    const hashed_wbigram_multiset * bgrms2)
+{
+    return hashed_wbigram_multiset::intersect_size(*bgrms1, *bgrms2);
+}
+
+
+/** Calculate Sørensen–Dice coefficient */
+double hashed_wbigram_multiset_sorensen_dice_coef(
+    const hashed_wbigram_multiset * bgrms1,
+    const hashed_wbigram_multiset * bgrms2)
+{
+    return hashed_wbigram_multiset::sorensen_dice_coef(*bgrms1, *bgrms2);
+}
+
+
+/** Serialise bigrams */
+size_t hashed_wbigram_multiset_str(
+    const hashed_wbigram_multiset * bgrms,
+    wchar_t * buffer, size_t max_len)
+{
+    return libpysdc::serialise(*bgrms, buffer, max_len);
+}
+
+}  // end of extern "C" decl
@@ -0,0 +1,169 @@
+/**
+ *  \file
+ *  \brief  Frozen pattern set: Python binding
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "libsdcxx/pattern_set.hxx"
+#include "libsdcxx/sequence_matcher.hxx"
+#include "libsdcxx/bigrams.hxx"
+
+#include <vector>
+#include <exception>
+
+
+using wpattern_set = libsdcxx::wpattern_set;
+using wsequence_matcher =  // counts matching statistics (see wsequence_matcher_stats)
+    libsdcxx::basic_sequence_matcher<libsdcxx::wbigrams, libsdcxx::match_counters>;
+using wbigrams = libsdcxx::wbigrams;
+using sequence_match = libsdcxx::sequence_match;
+using sequence_matches = std::vector<sequence_match>;
+using bigram_index_match = libsdcxx::bigram_index_match;
+using bigram_index_matches = std::vector<bigram_index_match>;
+
+
+namespace {
+
+/** Range of patterns given as an array of pointers */
+class pattern_ptrs {
+    private:
+
+    const wbigrams * const * m_begin;
+    const wbigrams * const * m_end;
+
+    public:
+
+    /** Dereferencing iterator */
+    class iterator {
+        private:
+
+        const wbigrams * const * m_ptr;
+
+        public:
+
+        iterator(const wbigrams * const * ptr): m_ptr(ptr) {}
+
+        const wbigrams & operator * () const { return **m_ptr; }
+        iterator & operator ++ () { ++m_ptr; return *this; }
+        bool operator != (const iterator & rarg) const { return m_ptr != rarg.m_ptr; }
+
+    };  // end of class iterator
+
+    pattern_ptrs(const wbigrams * const * patterns, size_t pattern_cnt):
+        m_begin(patterns), m_end(patterns + pattern_cnt)
+    {}
+
+    iterator begin() const { return m_begin; }
+    iterator end() const { return m_end; }
+
+};  // end of class pattern_ptrs
+
+}  // end of anonymous namespace
+
+
+extern "C" {
+
+/** Constructor (freezes patterns) */
+wpattern_set * new_wpattern_set(
+    const wbigrams * const * patterns, size_t pattern_cnt,
+    int with_index)
+{
+    return new wpattern_set(pattern_ptrs(patterns, pattern_cnt), with_index
+        ? wpattern_set::INDEX
+        : wpattern_set::NO_INDEX);
+}
+
+/** Load saved set (memory-mapped, returns NULL on error) */
+wpattern_set * wpattern_set_load(const char * path, int with_index) {
+    try {
+        return new wpattern_set(wpattern_set::load(path, with_index
+            ? wpattern_set::INDEX
+            : wpattern_set::NO_INDEX));
+    }
+    catch (const std::exception & ) { return nullptr; }
+}
+
+/** Destructor */
+void delete_wpattern_set(wpattern_set * set) { delete set; }
+
+/** Number of patterns */
+size_t wpattern_set_size(const wpattern_set * set) { return set->size(); }
+
+/** Blob size (in bytes) */
+size_t wpattern_set_blob_size(const wpattern_set * set) { return set->blob_size(); }
+
+/** Inverted index available */
+int wpattern_set_indexed(const wpattern_set * set) { return set->indexed() ? 1 : 0; }
+
+/** Save the set (returns 0 on success) */
+int wpattern_set_save(const wpattern_set * set, const char * path) {
+    try { set->save(path); }
+    catch (const std::exception & ) { return -1; }
+
+    return 0;
+}
+
+/** Threshold lookup (returns number of matches, requires the inverted index) */
+size_t wpattern_set_lookup(
+    const wpattern_set * set,
+    const wbigrams * query,
+    double threshold,
+    bigram_index_matches * matches)
+{
+    matches->clear();
+    set->lookup(*query, threshold,
+        [matches](const bigram_index_match & match) { matches->push_back(match); });
+
+    return matches->size();
+}
+
+/** Match all patterns of a set (returns number of matches) */
+size_t wsequence_matcher_match_set(
+    wsequence_matcher * matcher,
+    const wpattern_set * set,
+    double threshold,
+    sequence_matches * matches)
+{
+    matches->clear();
+    matcher->match_all(*set, threshold,
+        [matches](const sequence_match & match) { matches->push_back(match); });
+
+    return matches->size();
+}
+
+}  // end of extern "C" decl
@@ -44,11 +44,17 @@
 #include "util.hxx"
 
 #include <sstream>
+#include <string_view>
+#include <vector>
 #include <cwchar>
 
 
-using wsequence_matcher = libsdcxx::wsequence_matcher;
+using wsequence_matcher =  // counts matching statistics (see wsequence_matcher_stats)
+    libsdcxx::basic_sequence_matcher<libsdcxx::wbigrams, libsdcxx::match_counters>;
 using wbigrams = libsdcxx::wbigrams;
+using sequence_match = libsdcxx::sequence_match;
+using sequence_matches = std::vector<sequence_match>;
+using match_stats = libsdcxx::match_stats;
 
 
 extern "C" {
@@ -64,6 +70,9 @@ void wsequence_matcher_reserve(wsequence_matcher * matcher, size_t len) {
     matcher->reserve(len);
 }
 
+/** Remove the sequence (memory is kept for re-use) */
+void wsequence_matcher_clear(wsequence_matcher * matcher) { matcher->clear(); }
+
 /** Size getter */
 size_t wsequence_matcher_size(const wsequence_matcher * matcher) {
     return matcher->size();
@@ -84,6 +93,140 @@ void wsequence_matcher_emplace_back(
 {
     matcher->emplace_back(str, 0 != strip);
 }
+/** Push in-place created bigrams of UTF-8 string back */
+void wsequence_matcher_emplace_back_utf8(
+    wsequence_matcher * matcher,
+    const char * str, size_t len, int strip)
+{
+    matcher->emplace_back(libsdcxx::utf8, std::string_view(str, len), 0 != strip);
+}
+
+
+/** Assign token sequence (bulk; strip flags may be NULL, meaning no strip tokens) */
+void wsequence_matcher_assign_tokens(
+    wsequence_matcher * matcher,
+    const wchar_t * const * tokens, const int * strips, size_t cnt)
+{
+    matcher->clear();
+    matcher->reserve(cnt);
+    for (size_t i = 0; i < cnt; ++i)
+        matcher->emplace_back(tokens[i], strips && 0 != strips[i]);
+}
+
+/**
+ *  Assign UTF-8 token sequence (bulk)
+ *
+ *  i-th token is at [offsets[i], offsets[i+1]) of the text (there are \c cnt + 1
+ *  offsets); strip flags may be NULL, meaning no strip tokens.
+ */
+void wsequence_matcher_assign_utf8(
+    wsequence_matcher * matcher,
+    const char * text, const size_t * offsets, const int * strips, size_t cnt)
+{
+    matcher->clear();
+    matcher->reserve(cnt);
+    for (size_t i = 0; i < cnt; ++i)
+        matcher->emplace_back(libsdcxx::utf8,
+            std::string_view(text + offsets[i], offsets[i + 1] - offsets[i]),
+            strips && 0 != strips[i]);
+}
+
+
+/**
+ *  Match (bulk; match records are stored to caller-provided buffer)
+ *
+ *  No sub-sequence bigrams are computed (see \c wsequence_matcher_subsequence).
+ *
+ *  Returns the total number of matches; if it exceeds the buffer capacity,
+ *  only the first \c capacity matches are stored.
+ */
+size_t wsequence_matcher_match(
+    wsequence_matcher * matcher,
+    const wbigrams * bgrms,
+    double threshold,
+    sequence_match * buffer, size_t capacity)
+{
+    size_t match_cnt = 0;
+    matcher->match(*bgrms, threshold, [&](const sequence_match & match) {
+        if (match_cnt < capacity) buffer[match_cnt] = match;
+        ++match_cnt;
+    });
+
+    return match_cnt;
+}
+
+
+/** Matching statistics (since construction or reset, stored to \c stats) */
+void wsequence_matcher_stats(const wsequence_matcher * matcher, match_stats * stats) {
+    *stats = matcher->stats();
+}
+
+/** Reset matching statistics */
+void wsequence_matcher_reset_stats(wsequence_matcher * matcher) {
+    matcher->reset_stats();
+}
+
+
+/** Sub-sequence bigrams (no copy; valid while the matcher generation is the same) */
+const wbigrams * wsequence_matcher_subsequence(
+    wsequence_matcher * matcher,
+    size_t begin, size_t end)
+{
+    return &matcher->subsequence(begin, end);
+}
+
+/** Matcher generation (changes when sub-sequence bigrams may be invalidated) */
+size_t wsequence_matcher_generation(const wsequence_matcher * matcher) {
+    return matcher->generation();
+}
+
+
+/** Match multiple patterns (matches are stored to the matches buffer) */
+size_t wsequence_matcher_match_all(
+    wsequence_matcher * matcher,
+    const wbigrams * const * patterns, size_t pattern_cnt,
+    double threshold,
+    sequence_matches * matches)
+{
+    matches->clear();
+    matcher->match_all(patterns, pattern_cnt, threshold,
+        [matches](const sequence_match & match) { matches->push_back(match); });
+
+    return matches->size();
+}
+
+
+/** Best matches (returns number of matches) */
+size_t wsequence_matcher_best_matches(
+    wsequence_matcher * matcher,
+    const wbigrams * bgrms, size_t k,
+    double threshold,
+    int non_overlapping,
+    sequence_matches * matches)
+{
+    *matches = matcher->best_matches(*bgrms, k, threshold, non_overlapping
+        ? wsequence_matcher::NO_OVERLAP
+        : wsequence_matcher::ALLOW_OVERLAP);
+
+    return matches->size();
+}
+
+
+/** Matches buffer constructor */
+sequence_matches * new_sequence_matches() { return new sequence_matches(); }
+
+/** Matches buffer destructor */
+void delete_sequence_matches(sequence_matches * matches) { delete matches; }
+
+/** Matches buffer size */
+size_t sequence_matches_size(const sequence_matches * matches) {
+    return matches->size();
+}
+
+/** Matches buffer data (array of match records) */
+const sequence_match * sequence_matches_data(const sequence_matches * matches) {
+    return matches->data();
+}
 
 
 /** Begin match iterator */
@@ -0,0 +1,117 @@
+/**
+ *  \file
+ *  \brief  Sliding window stream matcher: Python binding
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libsdcxx/stream_matcher.hxx"
+#include "libsdcxx/bigrams.hxx"
+
+#include <string_view>
+#include <vector>
+
+
+using wstream_matcher = libsdcxx::wstream_matcher;
+using wbigrams = libsdcxx::wbigrams;
+using sequence_match = libsdcxx::sequence_match;
+using sequence_matches = std::vector<sequence_match>;
+
+
+extern "C" {
+
+/** Constructor (patterns are copied) */
+wstream_matcher * new_wstream_matcher(
+    const wbigrams * const * patterns, size_t pattern_cnt,
+    double threshold, size_t window)
+{
+    return new wstream_matcher(patterns, pattern_cnt, threshold, window);
+}
+
+/** Destructor */
+void delete_wstream_matcher(wstream_matcher * matcher) { delete matcher; }
+
+/** Max. match length (number of tokens) */
+size_t wstream_matcher_window(const wstream_matcher * matcher) { return matcher->window(); }
+
+/** Stream position (number of tokens pushed) */
+size_t wstream_matcher_position(const wstream_matcher * matcher) {
+    return matcher->position();
+}
+
+/** Start new stream */
+void wstream_matcher_reset(wstream_matcher * matcher) { matcher->reset(); }
+
+/** Push token bigrams (matches ending with the token are stored to the matches buffer) */
+size_t wstream_matcher_push_back(
+    wstream_matcher * matcher,
+    const wbigrams * bgrms, int strip,
+    sequence_matches * matches)
+{
+    matches->clear();
+    matcher->push_back(*bgrms, 0 != strip,
+        [matches](const sequence_match & match) { matches->push_back(match); });
+
+    return matches->size();
+}
+
+/** Push token (see \c wstream_matcher_push_back) */
+size_t wstream_matcher_emplace_back(
+    wstream_matcher * matcher,
+    const wchar_t * str, int strip,
+    sequence_matches * matches)
+{
+    matches->clear();
+    matcher->emplace_back(str, 0 != strip,
+        [matches](const sequence_match & match) { matches->push_back(match); });
+
+    return matches->size();
+}
+
+/** Push UTF-8 token (see \c wstream_matcher_push_back) */
+size_t wstream_matcher_emplace_back_utf8(
+    wstream_matcher * matcher,
+    const char * str, size_t len, int strip,
+    sequence_matches * matches)
+{
+    matches->clear();
+    matcher->emplace_back(libsdcxx::utf8, std::string_view(str, len), 0 != strip,
+        [matches](const sequence_match & match) { matches->push_back(match); });
+
+    return matches->size();
+}
+
+}  // end of extern "C" decl
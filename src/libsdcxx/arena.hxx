@@ -0,0 +1,244 @@
+#ifndef libsdcxx__arena_hxx
+#define libsdcxx__arena_hxx
+
+/**
+ *  \file
+ *  \brief  Monotonic memory arena
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <memory_resource>
+#include <algorithm>
+
+
+namespace libsdcxx {
+
+/**
+ *  \brief  Monotonic memory arena
+ *
+ *  Allocations are served from large chunks by simply bumping a pointer;
+ *  deallocation is a no-op.
+ *  The whole arena is released at once: either on destruction, or logically
+ *  by \c reset, which keeps the chunks for re-use (so a recurring workload
+ *  doesn't return memory to the heap just to allocate it again).
+ *
+ *  Unlike \c std::pmr::monotonic_buffer_resource, the chunks survive reset.
+ *  Not thread-safe.
+ */
+class arena: public std::pmr::memory_resource {
+    private:
+
+    /** Chunk header (the chunk memory follows) */
+    struct chunk {
+        chunk * next;   /**< Next chunk     */
+        size_t  size;   /**< Chunk size     */
+    };
+
+    static constexpr size_t header_size =
+        (sizeof(chunk) + alignof(std::max_align_t) - 1) &
+        ~(alignof(std::max_align_t) - 1);  /**< Chunk header size (aligned) */
+
+    chunk *     m_chunks;       /**< Chunks (current one first)     */
+    chunk *     m_spare;        /**< Spare chunks (after reset)     */
+    uintptr_t   m_ptr;          /**< Free memory in current chunk   */
+    uintptr_t   m_end;          /**< Current chunk end              */
+    size_t      m_next_size;    /**< Next chunk size                */
+    size_t      m_allocated;    /**< Bytes allocated since reset    */
+
+    /** Start using chunk */
+    void use(chunk * c) {
+        c->next = m_chunks;
+        m_chunks = c;
+        m_ptr = reinterpret_cast<uintptr_t>(c) + header_size;
+        m_end = reinterpret_cast<uintptr_t>(c) + c->size;
+    }
+
+    /** Get chunk with at least the required space (spare one if possible) */
+    void add_chunk(size_t bytes, size_t alignment) {
+        const size_t required = header_size + bytes + alignment;
+
+        if (m_spare && m_spare->size >= required) {
+            chunk * c = m_spare;
+            m_spare = c->next;
+            use(c);
+            return;
+        }
+
+        const size_t size = std::max(required, m_next_size);
+        m_next_size = 2 * size;
+
+        use(new (::operator new(size)) chunk{nullptr, size});
+    }
+
+    /** Free chunk list */
+    static void free_chunks(chunk * c) {
+        while (c) {
+            chunk * next = c->next;
+            ::operator delete(c);
+            c = next;
+        }
+    }
+
+    protected:
+
+    /** Allocation */
+    void * do_allocate(size_t bytes, size_t alignment) override {
+        uintptr_t ptr = (m_ptr + alignment - 1) & ~(uintptr_t(alignment) - 1);
+        if (!m_chunks || ptr + bytes > m_end) {  // chunk exhausted (or none yet)
+            add_chunk(bytes, alignment);
+            ptr = (m_ptr + alignment - 1) & ~(uintptr_t(alignment) - 1);
+        }
+
+        m_ptr = ptr + bytes;
+        m_allocated += bytes;
+        return reinterpret_cast<void *>(ptr);
+    }
+
+    /** Deallocation (no-op) */
+    void do_deallocate(void * , size_t , size_t ) override {}
+
+    /** Resources are only equal if identical */
+    bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override {
+        return this == &other;
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  chunk_size  Initial chunk size
+     */
+    explicit arena(size_t chunk_size = 4096):
+        m_chunks(nullptr), m_spare(nullptr), m_ptr(0), m_end(0),
+        m_next_size(chunk_size), m_allocated(0)
+    {}
+
+    arena(const arena & ) = delete;
+    arena & operator = (const arena & ) = delete;
+
+    /** Destructor */
+    ~arena() override { release(); }
+
+    /** Bytes allocated since construction or the last reset */
+    size_t allocated() const { return m_allocated; }
+
+    /**
+     *  \brief  Reset the arena
+     *
+     *  All the allocated memory is logically freed at once; the chunks are kept
+     *  for re-use.
+     *  Objects allocated in the arena must be destroyed (or abandoned) beforehand.
+     */
+    void reset() {
+        while (m_chunks) {  // move chunks to spares
+            chunk * next = m_chunks->next;
+            m_chunks->next = m_spare;
+            m_spare = m_chunks;
+            m_chunks = next;
+        }
+
+        m_ptr = m_end = 0;
+        m_allocated = 0;
+    }
+
+    /** Release all the memory back to the heap */
+    void release() {
+        free_chunks(m_chunks);
+        free_chunks(m_spare);
+        m_chunks = m_spare = nullptr;
+        m_ptr = m_end = 0;
+        m_allocated = 0;
+    }
+
+};  // end of class arena
+
+
+/**
+ *  \brief  Counting memory resource
+ *
+ *  Passes (de)allocations to an upstream resource, counting the bytes in use
+ *  (as requested, i.e. the upstream overhead isn't counted).
+ *  Not thread-safe.
+ */
+class counting_resource: public std::pmr::memory_resource {
+    private:
+
+    std::pmr::memory_resource * m_upstream;     /**< Upstream resource  */
+    size_t                      m_used;         /**< Bytes in use       */
+
+    protected:
+
+    /** Allocation */
+    void * do_allocate(size_t bytes, size_t alignment) override {
+        void * ptr = m_upstream->allocate(bytes, alignment);
+        m_used += bytes;
+        return ptr;
+    }
+
+    /** Deallocation */
+    void do_deallocate(void * ptr, size_t bytes, size_t alignment) override {
+        m_upstream->deallocate(ptr, bytes, alignment);
+        m_used -= bytes;
+    }
+
+    /** Resources are equal only if they're the same */
+    bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override {
+        return this == &other;
+    }
+
+    public:
+
+    /** Constructor */
+    explicit counting_resource(std::pmr::memory_resource * upstream):
+        m_upstream(upstream), m_used(0)
+    {}
+
+    counting_resource(const counting_resource & ) = delete;
+    counting_resource & operator = (const counting_resource & ) = delete;
+
+    /** Bytes in use */
+    size_t used() const { return m_used; }
+
+};  // end of class counting_resource
+
+}  // end of namespace libsdcxx
+
+#endif  // end of #ifndef libsdcxx__arena_hxx
@@ -0,0 +1,499 @@
+#ifndef libsdcxx__bigram_index_hxx
+#define libsdcxx__bigram_index_hxx
+
+/**
+ *  \file
+ *  \brief  Inverted bigram index (fuzzy dictionary lookup)
+ *
+ *  See https://en.wikipedia.org/wiki/S%C3%B8rensen%E2%80%93Dice_coefficient
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bigrams.hxx"
+#include "bigram_storage.hxx"
+#include "simd_intersect.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <limits>
+#include <tuple>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+
+namespace libsdcxx {
+
+/**
+ *  \brief  Bigram index match
+ */
+struct bigram_index_match {
+    size_t entry;   /**< Matching entry ID          */
+    double score;   /**< Sørensen–Dice coefficient  */
+};  // end of struct bigram_index_match
+
+
+/**
+ *  \brief  Inverted bigram index
+ *
+ *  Dictionary of bigram multisets (entries) allowing for fast lookup of all the entries
+ *  that match a query with Sørensen–Dice coefficient reaching a threshold.
+ *
+ *  Each (packed) bigram key maps to a posting list of [entry ID, bigram count] pairs.
+ *  A threshold query doesn't visit all the entries; it uses the SDC upper bound
+ *  (see \c doc/sequence_matcher.adoc):
+ *  1. Only entries within the cardinality window may match:
+ *     \f$ 2 min{|A|,|Q|} / (|A|+|Q|) \ge M \f$
+ *  2. A match must share at least \f$ t \f$ bigrams with the query \f$ Q \f$, where
+ *     \f$ t \f$ is the least intersection size reaching \f$ M \f$ for the smallest
+ *     acceptable entry.
+ *     Therefore, it must share at least one of any \f$ |Q| - t + 1 \f$ query bigrams
+ *     (prefix filter).
+ *     The prefix is formed by the rarest query bigrams (those with shortest posting
+ *     lists), so only the short posting lists are scanned.
+ *
+ *  Candidates are generated by accumulating intersection counts over the prefix
+ *  posting lists.
+ *  The posting lists are kept sorted by entry size, so only the postings within
+ *  the cardinality window are visited.
+ *  Candidates that can't reach the threshold even if they shared all the remaining
+ *  (non-prefix) query bigrams are pruned; the rest are scored exactly.
+ *
+ *  Entry IDs are assigned in insertion order, starting from 0.
+ *
+ *  \tparam  Char  Character type
+ */
+template <typename Char>
+class basic_bigram_index {
+    public:
+
+    using char_t = Char;                                /**< Character type     */
+    using bigram_t = std::tuple<char_t, char_t>;        /**< Bigram type        */
+    using key_traits = bigram_key<char_t>;              /**< Bigram key traits  */
+    using key_t = typename key_traits::key_t;           /**< Packed bigram key  */
+    using match_t = bigram_index_match;                 /**< Match type         */
+
+    private:
+
+    /** Posting (posting lists are limited to 32 bits to save memory) */
+    struct posting {
+        std::uint32_t entry;    /**< Entry ID       */
+        std::uint32_t cnt;      /**< Bigram count   */
+    };  // end of struct posting
+
+    using postings_t = std::vector<posting>;
+
+    /**
+     *  \brief  Posting list
+     *
+     *  Postings are sorted by entry size (and ID), so that postings within
+     *  the cardinality window are found by binary search.
+     *  New postings are appended to an unsorted tail, which is merged once it
+     *  gets too long (so that the insertion is amortised O(1) moves).
+     */
+    struct posting_list {
+        postings_t postings;    /**< Postings                   */
+        size_t sorted = 0;      /**< Length of the sorted part  */
+    };  // end of struct posting_list
+
+    using index_t = std::unordered_map<key_t, posting_list>;
+    using sizes_t = std::vector<size_t>;
+    using keys_t = std::vector<key_t>;
+    using cnts_t = std::vector<size_t>;
+
+    /** Query bigram */
+    struct query_bigram {
+        key_t key;                  /**< Packed bigram key          */
+        size_t cnt;                 /**< Bigram count               */
+        const posting_list * list;  /**< Posting list (if any)      */
+    };  // end of struct query_bigram
+
+    /** Query scratch space (reused) */
+    struct scratch {
+        std::vector<query_bigram> query;    /**< Query bigrams          */
+        keys_t keys;                        /**< Query keys (sorted)    */
+        cnts_t cnts;                        /**< Query counts           */
+        sizes_t acc;                        /**< Accumulated counts     */
+        sizes_t candidates;                 /**< Candidate entries      */
+        std::vector<match_t> matches;       /**< Matches (to be sunk)   */
+
+        /** Candidate accumulators reset (also if an exception is thrown) */
+        struct reset {
+            scratch & sc;   /**< Scratch space */
+
+            ~reset() {
+                for (const auto entry: sc.candidates) sc.acc[entry] = 0;
+                sc.candidates.clear();
+            }
+        };  // end of struct reset
+    };  // end of struct scratch
+
+    /** Per-thread query scratch space (shared by all the lookups) */
+    static scratch & thread_scratch() {
+        thread_local scratch sc;
+        return sc;
+    }
+
+    index_t m_index;        /**< Posting lists  */
+    sizes_t m_offsets;      /**< Entry offsets to packed keys & counts  */
+    sizes_t m_sizes;        /**< Entry sizes (individual bigram counts) */
+    keys_t  m_keys;         /**< Entry keys (sorted per entry)          */
+    cnts_t  m_cnts;         /**< Entry bigram counts                    */
+    size_t  m_max_size;     /**< Max. entry size                        */
+
+    /** Minimal posting list unsorted tail length to merge */
+    static constexpr size_t s_tail_min = 32;
+
+    /**
+     *  \brief  Append posting to list (merge the unsorted tail if it's too long)
+     *
+     *  The tail postings come in entry ID order, so a stable sort by entry size
+     *  and a stable merge keep the list sorted by [size, ID].
+     *
+     *  \param  list  Posting list
+     *  \param  post  Posting
+     */
+    void append(posting_list & list, const posting & post) {
+        list.postings.push_back(post);
+
+        const size_t tail = list.postings.size() - list.sorted;
+        if (tail < std::max(s_tail_min, list.sorted / 8)) return;
+
+        const auto by_size = [this](const posting & post1, const posting & post2) {
+            return m_sizes[post1.entry] < m_sizes[post2.entry];
+        };
+
+        const auto sorted_end = list.postings.begin() + list.sorted;
+        std::stable_sort(sorted_end, list.postings.end(), by_size);
+        std::inplace_merge(list.postings.begin(), sorted_end, list.postings.end(), by_size);
+        list.sorted = list.postings.size();
+    }
+
+    /** Cardinality check (the SDC upper bound reaches the threshold) */
+    static bool check_cardinality(size_t size, size_t qsize, double threshold) {
+        return 2.0 * std::min(size, qsize) / (size + qsize) >= threshold;
+    }
+
+    /** Intersection size check (the SDC reaches the threshold) */
+    static bool check_isect_size(
+        size_t isect_size, size_t size, size_t qsize, double threshold)
+    {
+        return 2.0 * isect_size / (size + qsize) >= threshold;
+    }
+
+    /**
+     *  \brief  Scoring
+     *
+     *  \param  entry      Entry ID
+     *  \param  keys       Query keys (sorted)
+     *  \param  cnts       Query counts
+     *  \param  qsize      Query size
+     *
+     *  \return Sørensen–Dice coefficient (computed like \c basic_bigrams does)
+     */
+    double score(
+        size_t entry, const keys_t & keys, const cnts_t & cnts, size_t qsize) const
+    {
+        const size_t offset = m_offsets[entry];
+        const auto isect_size = simd::intersect_size(
+            keys.data(), cnts.data(), keys.size(),
+            m_keys.data() + offset, m_cnts.data() + offset,
+            m_offsets[entry + 1] - offset);
+
+        return isect_size ? 2.0 * isect_size / (m_sizes[entry] + qsize) : 0.0;
+    }
+
+    public:
+
+    /** Constructor */
+    basic_bigram_index(): m_offsets(1, 0), m_max_size(0) {}
+
+    /**
+     *  \brief  Number of entries
+     *
+     *  \return Number of entries
+     */
+    size_t size() const { return m_sizes.size(); }
+
+    /**
+     *  \brief  Entry size getter
+     *
+     *  \param  entry  Entry ID
+     *
+     *  \return Number of the entry bigrams
+     */
+    size_t entry_size(size_t entry) const { return m_sizes[entry]; }
+
+    /**
+     *  \brief  Reserve space for entries
+     *
+     *  \param  entry_cnt  Number of entries
+     */
+    void reserve(size_t entry_cnt) {
+        m_offsets.reserve(entry_cnt + 1);
+        m_sizes.reserve(entry_cnt);
+    }
+
+    /** Remove all entries */
+    void clear() {
+        m_index.clear();
+        m_offsets.resize(1);
+        m_sizes.clear();
+        m_keys.clear();
+        m_cnts.clear();
+        m_max_size = 0;
+    }
+
+    /**
+     *  \brief  Insert entry
+     *
+     *  Any bigram multiset type iterating over [bigram, count] tuples in sorted
+     *  order will do (\c basic_bigrams of any storage, \c basic_bigrams_view).
+     *
+     *  \param  bgrms  Entry bigrams
+     *
+     *  \return Entry ID
+     */
+    template <class Bigrams>
+    size_t insert(const Bigrams & bgrms) {
+        const size_t entry = size();
+        assert(entry < std::numeric_limits<std::uint32_t>::max());
+
+        m_sizes.push_back(bgrms.size());
+        m_max_size = std::max(m_max_size, bgrms.size());
+
+        for (const auto & bigram_cnt: bgrms) {
+            const key_t key = key_traits::pack(std::get<0>(bigram_cnt));
+            const size_t cnt = std::get<1>(bigram_cnt);
+
+            m_keys.push_back(key);
+            m_cnts.push_back(cnt);
+            append(m_index[key], posting{
+                static_cast<std::uint32_t>(entry),
+                static_cast<std::uint32_t>(cnt)});
+        }
+
+        m_offsets.push_back(m_keys.size());
+
+        return entry;
+    }
+
+    private:
+
+    /**
+     *  \brief  Collect threshold lookup matches (see \c lookup)
+     *
+     *  \param  query      Query bigrams
+     *  \param  threshold  Matching score (SDC) threshold (positive)
+     *  \param  sc         Scratch space (candidate accumulators are reset on return)
+     *  \param  matches    Matches (appended in ascending entry ID order)
+     */
+    template <class Storage>
+    void collect(
+        const basic_bigrams<char_t, Storage> & query,
+        double threshold,
+        scratch & sc,
+        std::vector<match_t> & matches) const
+    {
+        assert(threshold > 0.0);
+
+        const size_t qsize = query.size();
+        if (0 == qsize || 0 == size() || threshold > 1.0) return;
+
+        // Cardinality window
+        size_t min_size = static_cast<size_t>(qsize * threshold / (2.0 - threshold));
+        while (min_size > 1 && check_cardinality(min_size - 1, qsize, threshold))
+            --min_size;
+        while (min_size <= qsize && !check_cardinality(min_size, qsize, threshold))
+            ++min_size;
+        if (min_size > qsize) return;
+
+        size_t max_size = static_cast<size_t>(std::min<double>(
+            qsize * (2.0 - threshold) / threshold, m_max_size));
+        max_size = std::max(max_size, qsize);
+        while (max_size > qsize && !check_cardinality(max_size, qsize, threshold))
+            --max_size;
+        while (max_size < m_max_size && check_cardinality(max_size + 1, qsize, threshold))
+            ++max_size;
+
+        // Minimal intersection size
+        size_t min_isect = static_cast<size_t>(threshold * (min_size + qsize) / 2.0);
+        while (min_isect > 1 && check_isect_size(min_isect - 1, min_size, qsize, threshold))
+            --min_isect;
+        while (!check_isect_size(min_isect, min_size, qsize, threshold))
+            ++min_isect;
+        min_isect = std::max<size_t>(min_isect, 1);
+
+        const typename scratch::reset reset{sc};
+
+        sc.query.clear();
+        sc.keys.clear();
+        sc.cnts.clear();
+        if (sc.acc.size() < size()) sc.acc.resize(size(), 0);
+
+        for (const auto & bigram_cnt: query) {
+            const key_t key = key_traits::pack(std::get<0>(bigram_cnt));
+            const size_t cnt = std::get<1>(bigram_cnt);
+            const auto list = m_index.find(key);
+
+            sc.keys.push_back(key);
+            sc.cnts.push_back(cnt);
+            sc.query.push_back(query_bigram{
+                key, cnt, list == m_index.end() ? nullptr : &list->second});
+        }
+
+        // Rarest bigrams first (bigrams not indexed at all are the rarest)
+        std::sort(sc.query.begin(), sc.query.end(),
+            [](const query_bigram & qb1, const query_bigram & qb2) {
+                const size_t len1 = qb1.list ? qb1.list->postings.size() : 0;
+                const size_t len2 = qb2.list ? qb2.list->postings.size() : 0;
+                return len1 < len2;
+            });
+
+        // Accumulate intersection counts over the prefix posting lists
+        const size_t prefix_size = qsize - min_isect + 1;
+        size_t covered = 0;
+        for (auto qb = sc.query.cbegin(); covered < prefix_size; ++qb) {
+            assert(qb != sc.query.cend());
+            covered += qb->cnt;
+
+            if (!qb->list) continue;
+
+            const auto accumulate = [&sc, qb](const posting & post) {
+                auto & acc = sc.acc[post.entry];
+                if (0 == acc) sc.candidates.push_back(post.entry);
+                acc += std::min<size_t>(qb->cnt, post.cnt);
+            };
+
+            // Cardinality window in the sorted part
+            const auto & postings = qb->list->postings;
+            const auto sorted_end = postings.cbegin() + qb->list->sorted;
+            const auto window_begin = std::partition_point(
+                postings.cbegin(), sorted_end, [this, min_size](const posting & post) {
+                    return m_sizes[post.entry] < min_size;
+                });
+            const auto window_end = std::partition_point(
+                window_begin, sorted_end, [this, max_size](const posting & post) {
+                    return m_sizes[post.entry] <= max_size;
+                });
+
+            std::for_each(window_begin, window_end, accumulate);
+
+            // Unsorted tail
+            std::for_each(sorted_end, postings.cend(), [&](const posting & post) {
+                const size_t entry_size = m_sizes[post.entry];
+                if (entry_size < min_size || entry_size > max_size) return;
+                accumulate(post);
+            });
+        }
+
+        // Score candidates
+        const size_t rest = qsize - std::min(covered, qsize);
+        std::sort(sc.candidates.begin(), sc.candidates.end());
+        for (const auto entry: sc.candidates) {
+            const size_t entry_size = m_sizes[entry];
+            const size_t isect_ub = std::min(
+                sc.acc[entry] + rest, std::min(entry_size, qsize));
+
+            if (!check_isect_size(isect_ub, entry_size, qsize, threshold)) continue;
+
+            const double sdc = score(entry, sc.keys, sc.cnts, qsize);
+            if (sdc >= threshold) matches.push_back(match_t{entry, sdc});
+        }
+    }
+
+    public:
+
+    /**
+     *  \brief  Threshold lookup
+     *
+     *  Reports all the entries with SDC to the query reaching the threshold,
+     *  in ascending entry ID order.
+     *  The matches are collected before they are sunk, so the sink may throw
+     *  or even do another lookup.
+     *
+     *  \param  query      Query bigrams
+     *  \param  threshold  Matching score (SDC) threshold (positive)
+     *  \param  sink       Match sink (callable with \c bigram_index_match argument)
+     */
+    template <class Storage, class Sink>
+    void lookup(
+        const basic_bigrams<char_t, Storage> & query,
+        double threshold,
+        Sink && sink) const
+    {
+        auto & sc = thread_scratch();
+        auto matches = std::move(sc.matches);  // keeps capacity, sc.matches is left empty
+        matches.clear();
+        collect(query, threshold, sc, matches);
+
+        for (const auto & match: matches) sink(match);
+
+        matches.clear();
+        sc.matches = std::move(matches);  // keep capacity for the next lookup
+    }
+
+    /**
+     *  \brief  Threshold lookup
+     *
+     *  \param  query      Query bigrams
+     *  \param  threshold  Matching score (SDC) threshold (positive)
+     *
+     *  \return Matches (in ascending entry ID order)
+     */
+    template <class Storage>
+    std::vector<match_t> lookup(
+        const basic_bigrams<char_t, Storage> & query,
+        double threshold) const
+    {
+        std::vector<match_t> matches;
+        lookup(query, threshold,
+            [&matches](const match_t & match) { matches.push_back(match); });
+
+        return matches;
+    }
+
+};  // end of template class basic_bigram_index
+
+
+using bigram_index = basic_bigram_index<char>;      /**< ASCII/ANSI bigram index    */
+using wbigram_index = basic_bigram_index<wchar_t>;  /**< UNICODE bigram index       */
+
+}  // end of namespace libsdcxx
+
+#endif  // end of #ifndef libsdcxx__bigram_index_hxx
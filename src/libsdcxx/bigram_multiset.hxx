@@ -43,6 +43,8 @@
  *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include "bigram_storage.hxx"
+
 #include <cstddef>
 #include <set>
 #include <unordered_set>
@@ -52,6 +54,7 @@
 #include <iterator>
 #include <iostream>
 #include <functional>
+#include <type_traits>
 
 
 namespace libsdcxx {
@@ -179,10 +182,23 @@ class basic_bigram_multiset {
         return unite(*this, other);
     }
 
+    private:
+
+    /** Implementation is a sorted container */
+    template <class Impl, class = void>
+    struct is_sorted: std::false_type {};
+
+    template <class Impl>
+    struct is_sorted<Impl, std::void_t<typename Impl::key_compare>>: std::true_type {};
+
+    public:
+
     /**
      *  \brief  Bigram multisets intersection size
      *
      *  Calculate bigram multiset intersection cardinality.
+     *  Sorted multisets are merged; for unordered ones, the count of each distinct
+     *  bigram is looked up in the other multiset (equal bigrams are adjacent).
      *
      *  \param  bigrams1  Bigram multiset
      *  \param  bigrams2  Bigram multiset
@@ -193,24 +209,37 @@ class basic_bigram_multiset {
         const basic_bigram_multiset & bigrams1,
         const basic_bigram_multiset & bigrams2)
     {
-        struct insert_counter {  // we shall only count the number of attempted insertions
-            size_t & m_cnt;
-
-            insert_counter(size_t & cnt): m_cnt(cnt) {}
-
-            insert_counter & operator * () { return *this; }  // don't do anything
-
-            void operator ++ () {}  // ditto
-
-            void operator = (const bigram_t & ) { ++m_cnt; }  // count inserted bigrams
-        };
-
-        size_t size = 0;
-        std::set_intersection(
-            bigrams1.m_impl.begin(), bigrams1.m_impl.end(),
-            bigrams2.m_impl.begin(), bigrams2.m_impl.end(),
-            insert_counter(size));
-        return size;
+        if constexpr (!is_sorted<impl_t>::value) {
+            size_t size = 0;
+            for (auto bigram = bigrams1.m_impl.begin(); bigram != bigrams1.m_impl.end(); ) {
+                const auto range = bigrams1.m_impl.equal_range(*bigram);
+                const size_t cnt = std::distance(range.first, range.second);
+                size += std::min(cnt, bigrams2.m_impl.count(*bigram));
+                bigram = range.second;
+            }
+
+            return size;
+        }
+        else {
+            struct insert_counter {  // we shall only count the number of attempted insertions
+                size_t & m_cnt;
+
+                insert_counter(size_t & cnt): m_cnt(cnt) {}
+
+                insert_counter & operator * () { return *this; }  // don't do anything
+
+                void operator ++ () {}  // ditto
+
+                void operator = (const bigram_t & ) { ++m_cnt; }  // count inserted bigrams
+            };
+
+            size_t size = 0;
+            std::set_intersection(
+                bigrams1.m_impl.begin(), bigrams1.m_impl.end(),
+                bigrams2.m_impl.begin(), bigrams2.m_impl.end(),
+                insert_counter(size));
+            return size;
+        }
     }
 
     /**
@@ -287,11 +316,9 @@ struct hash_bigram {};
 
 template <typename Char>
 struct hash_bigram<Char, true> {
-    /** Simply concatenate bytes, whole tuple fits in size_t */
+    /** Simply use the packed bigram key, whole tuple fits in size_t */
     size_t operator () (const std::tuple<Char, Char> & bigram) const noexcept {
-        return
-            static_cast<size_t>(std::get<1>(bigram)) << (8 * sizeof(Char)) |
-            static_cast<size_t>(std::get<0>(bigram));
+        return static_cast<size_t>(bigram_key<Char>::pack(bigram));
     }
 };
 
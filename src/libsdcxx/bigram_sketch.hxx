@@ -0,0 +1,291 @@
+#ifndef libsdcxx__bigram_sketch_hxx
+#define libsdcxx__bigram_sketch_hxx
+
+/**
+ *  \file
+ *  \brief  Bigram multiset sketches (cheap intersection size upper bound)
+ *
+ *  Bigrams are hashed to a small fixed number of buckets; the sketch keeps total
+ *  bigram count per bucket.  Common bigrams fall to the same bucket, so
+ *  \f$ |A \cap B| \le \sum_b min(A_b, B_b) \f$.
+ *  Unlike a (Bloom-like) bitmap, the bucket counts bound multiset intersections, too,
+ *  and the sketch of a union is simply the sum of the sketches.
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bigram_storage.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <algorithm>
+
+
+namespace libsdcxx {
+
+/**
+ *  \brief  Bigram multiset sketch
+ *
+ *  Bucket counts are 32 bit (i.e. for multisets of less than 4G bigrams).
+ *  With the default 16 buckets, the sketch fills a single cache line.
+ *
+ *  \tparam  Char     Character type
+ *  \tparam  Buckets  Number of buckets (power of 2)
+ */
+template <typename Char, size_t Buckets = 16>
+class bigram_sketch {
+    public:
+
+    using char_t = Char;                        /**< Character type         */
+    using key_traits = bigram_key<char_t>;      /**< Bigram key traits      */
+    using key_t = typename key_traits::key_t;   /**< Packed bigram key      */
+    using cnt_t = std::uint32_t;                /**< Bucket count           */
+
+    static constexpr size_t buckets = Buckets;  /**< Number of buckets */
+
+    static_assert(Buckets >= 2 && 0 == (Buckets & (Buckets - 1)),
+        "Number of sketch buckets must be a power of 2");
+
+    private:
+
+    /** Bucket index bits */
+    static constexpr unsigned bucket_bits() {
+        unsigned bits = 0;
+        while ((size_t(1) << bits) < Buckets) ++bits;
+        return bits;
+    }
+
+    cnt_t m_cnts[Buckets];  /**< Bucket counts */
+
+    public:
+
+    /** Constructor (empty multiset sketch) */
+    bigram_sketch(): m_cnts{} {}
+
+    /**
+     *  \brief  Bucket of bigram
+     *
+     *  Fibonacci hashing of the packed key (top bits of the product are taken,
+     *  so that bigrams differing in either character spread well).
+     *
+     *  \param  key  Packed bigram key
+     *
+     *  \return Bucket index
+     */
+    static size_t bucket(key_t key) {
+        return static_cast<size_t>(
+            (static_cast<std::uint64_t>(key) * 0x9e3779b97f4a7c15ull) >> (64 - bucket_bits()));
+    }
+
+    /**
+     *  \brief  Bucket count getter
+     *
+     *  \param  bckt  Bucket index
+     *
+     *  \return Total count of bigrams in the bucket
+     */
+    cnt_t count(size_t bckt) const { return m_cnts[bckt]; }
+
+    /**
+     *  \brief  Add bigram(s)
+     *
+     *  \param  key  Packed bigram key
+     *  \param  cnt  Bigram count
+     */
+    void add(key_t key, size_t cnt) { m_cnts[bucket(key)] += static_cast<cnt_t>(cnt); }
+
+    /**
+     *  \brief  Update sketch by other multiset sketch (sketch of multiset union)
+     *
+     *  \param  other  Other sketch
+     */
+    bigram_sketch & operator += (const bigram_sketch & other) {
+        for (size_t i = 0; i < Buckets; ++i) m_cnts[i] += other.m_cnts[i];
+        return *this;
+    }
+
+    /**
+     *  \brief  Intersection size upper bound
+     *
+     *  \param  sketch1  Bigram multiset sketch
+     *  \param  sketch2  Bigram multiset sketch
+     *
+     *  \return Upper bound of the bigram multisets intersection size
+     */
+    static size_t intersect_bound(
+        const bigram_sketch & sketch1,
+        const bigram_sketch & sketch2)
+    {
+        size_t bound = 0;
+        for (size_t i = 0; i < Buckets; ++i)
+            bound += std::min(sketch1.m_cnts[i], sketch2.m_cnts[i]);
+
+        return bound;
+    }
+
+};  // end of template class bigram_sketch
+
+
+/**
+ *  \brief  Bigram multiset storage with sketch
+ *
+ *  Storage adaptor keeping a sketch of the stored multiset along with it; the sketch
+ *  is updated incrementally by the storage unions.
+ *  Use it to reject candidates which can't match before the (exact) intersection
+ *  size is computed (see \c basic_bigrams::intersect_bound).
+ *
+ *  \tparam  Storage  Bigram multiset storage (see \c bigram_storage.hxx)
+ *  \tparam  Buckets  Number of sketch buckets
+ */
+template <class Storage, size_t Buckets = 16>
+class sketched_bigram_storage: public Storage {
+    public:
+
+    using storage_t = Storage;                          /**< Underlying storage     */
+    using char_t = typename storage_t::char_t;          /**< Character type         */
+    using bigram_t = typename storage_t::bigram_t;      /**< Bigram type            */
+    using key_traits = typename storage_t::key_traits;  /**< Bigram key traits      */
+    using sketch_t = bigram_sketch<char_t, Buckets>;    /**< Sketch type            */
+
+    /** Allocator type */
+    using allocator_type = typename storage_t::allocator_type;
+
+    private:
+
+    sketch_t m_sketch;  /**< Bigrams sketch */
+
+    public:
+
+    /** Default constructor */
+    sketched_bigram_storage() = default;
+
+    /** Constructor (with allocator) */
+    explicit sketched_bigram_storage(const allocator_type & alloc): storage_t(alloc) {}
+
+    /** Copy constructor (allocator-extended) */
+    sketched_bigram_storage(
+        const sketched_bigram_storage & orig, const allocator_type & alloc)
+    :
+        storage_t(orig, alloc), m_sketch(orig.m_sketch)
+    {}
+
+    /** Sketch getter */
+    const sketch_t & sketch() const { return m_sketch; }
+
+    /**
+     *  \brief  Append bigram
+     *
+     *  The bigram must be greater than the last stored one.
+     *
+     *  \param  bigram  Bigram
+     *  \param  cnt     Bigram count
+     */
+    void emplace_back(const bigram_t & bigram, size_t cnt) {
+        storage_t::emplace_back(bigram, cnt);
+        m_sketch.add(key_traits::pack(bigram), cnt);
+    }
+
+    /**
+     *  \brief  Merge other bigrams into the storage (multiset union)
+     *
+     *  \param  other  Other bigrams
+     */
+    void merge(const sketched_bigram_storage & other) {
+        storage_t::merge(other);
+        m_sketch += other.m_sketch;
+    }
+
+    /**
+     *  \brief  Store union of 2 bigram multisets
+     *
+     *  \param  storage1  Bigrams storage
+     *  \param  storage2  Bigrams storage
+     */
+    void unite(
+        const sketched_bigram_storage & storage1,
+        const sketched_bigram_storage & storage2)
+    {
+        storage_t::unite(storage1, storage2);
+        m_sketch = storage1.m_sketch;
+        m_sketch += storage2.m_sketch;
+    }
+
+    /**
+     *  \brief  Intersection size
+     *
+     *  \param  storage1  Bigrams storage
+     *  \param  storage2  Bigrams storage
+     *
+     *  \return Size of the bigram multisets intersection
+     */
+    static size_t intersect_size(
+        const sketched_bigram_storage & storage1,
+        const sketched_bigram_storage & storage2)
+    {
+        return storage_t::intersect_size(storage1, storage2);
+    }
+
+    /**
+     *  \brief  Intersection size upper bound (by the sketches)
+     *
+     *  \param  storage1  Bigrams storage
+     *  \param  storage2  Bigrams storage
+     *
+     *  \return Upper bound of the bigram multisets intersection size
+     */
+    static size_t intersect_bound(
+        const sketched_bigram_storage & storage1,
+        const sketched_bigram_storage & storage2)
+    {
+        return sketch_t::intersect_bound(storage1.m_sketch, storage2.m_sketch);
+    }
+
+};  // end of template class sketched_bigram_storage
+
+
+/** Storage keeps bigrams sketch (see \c sketched_bigram_storage) */
+template <class Storage, class = void>
+struct is_sketched_storage: std::false_type {};
+
+template <class Storage>
+struct is_sketched_storage<Storage, std::void_t<decltype(Storage::intersect_bound(
+    std::declval<const Storage &>(), std::declval<const Storage &>()))>>:
+    std::true_type {};
+
+}  // end of namespace libsdcxx
+
+#endif  // end of #ifndef libsdcxx__bigram_sketch_hxx
@@ -0,0 +1,152 @@
+#ifndef libsdcxx__bigram_sort_hxx
+#define libsdcxx__bigram_sort_hxx
+
+/**
+ *  \file
+ *  \brief  Packed bigram keys sorting
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+
+namespace libsdcxx {
+
+/** Max. length of keys array sorted by insertion sort */
+constexpr size_t bigram_insertion_sort_max = 16;
+
+/** Min. length of 16-bit keys array sorted by radix sort */
+constexpr size_t bigram_radix_sort_min = 64;
+
+
+/**
+ *  \brief  Insertion sort of keys
+ *
+ *  The best choice for short arrays (short tokens are the most common input).
+ *
+ *  \param  keys  Keys array
+ *  \param  len   Keys array length
+ */
+template <typename Key>
+void insertion_sort_keys(Key * keys, size_t len) {
+    for (size_t i = 1; i < len; ++i) {
+        const Key key = keys[i];
+
+        size_t j = i;
+        for (; j > 0 && key < keys[j - 1]; --j)
+            keys[j] = keys[j - 1];
+
+        keys[j] = key;
+    }
+}
+
+
+/**
+ *  \brief  LSD radix sort of 16-bit keys (O(n))
+ *
+ *  2 counting passes (one per byte); the histograms are computed at once.
+ *
+ *  \param  keys     Keys array
+ *  \param  len      Keys array length
+ *  \param  scratch  Scratch array of (at least) the same length
+ */
+inline void radix_sort_keys(uint16_t * keys, size_t len, uint16_t * scratch) {
+    uint32_t lo_cnts[256] = { 0 };
+    uint32_t hi_cnts[256] = { 0 };
+
+    for (size_t i = 0; i < len; ++i) {
+        ++lo_cnts[keys[i] & 0xff];
+        ++hi_cnts[keys[i] >> 8];
+    }
+
+    // Counts to offsets
+    uint32_t lo_off = 0, hi_off = 0;
+    for (size_t b = 0; b < 256; ++b) {
+        const uint32_t lo_cnt = lo_cnts[b];
+        const uint32_t hi_cnt = hi_cnts[b];
+        lo_cnts[b] = lo_off; lo_off += lo_cnt;
+        hi_cnts[b] = hi_off; hi_off += hi_cnt;
+    }
+
+    for (size_t i = 0; i < len; ++i)  // lower byte pass (keys -> scratch)
+        scratch[lo_cnts[keys[i] & 0xff]++] = keys[i];
+
+    for (size_t i = 0; i < len; ++i)  // upper byte pass (scratch -> keys)
+        keys[hi_cnts[scratch[i] >> 8]++] = scratch[i];
+}
+
+
+/**
+ *  \brief  Sort keys
+ *
+ *  Generic keys are sorted by \c std::sort (unless the array is short).
+ *
+ *  \param  keys     Keys array
+ *  \param  len      Keys array length
+ *  \param  scratch  Scratch array of (at least) the same length (may be unused)
+ */
+template <typename Key>
+void sort_keys(Key * keys, size_t len, Key * /* scratch */) {
+    if (len <= bigram_insertion_sort_max)
+        insertion_sort_keys(keys, len);
+    else
+        std::sort(keys, keys + len);
+}
+
+/**
+ *  \brief  Sort 16-bit keys (8-bit character bigrams)
+ *
+ *  Long arrays are sorted by radix sort in linear time.
+ *
+ *  \param  keys     Keys array
+ *  \param  len      Keys array length
+ *  \param  scratch  Scratch array of (at least) the same length
+ */
+inline void sort_keys(uint16_t * keys, size_t len, uint16_t * scratch) {
+    if (len <= bigram_insertion_sort_max)
+        insertion_sort_keys(keys, len);
+    else if (len < bigram_radix_sort_min)
+        std::sort(keys, keys + len);
+    else
+        radix_sort_keys(keys, len, scratch);
+}
+
+}  // end of namespace libsdcxx
+
+#endif  // end of #ifndef libsdcxx__bigram_sort_hxx
@@ -0,0 +1,528 @@
+#ifndef libsdcxx__bigram_storage_hxx
+#define libsdcxx__bigram_storage_hxx
+
+/**
+ *  \file
+ *  \brief  Bigram multiset storage implementations
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "simd_intersect.hxx"
+#include "small_vector.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <list>
+#include <iterator>
+#include <utility>
+#include <type_traits>
+#include <memory_resource>
+#include <algorithm>
+
+
+namespace libsdcxx {
+
+/**
+ *  \brief  Unsigned integer of given size
+ *
+ *  \tparam  size  Integer size in bytes
+ */
+template <size_t size>
+struct uint_of_size {};
+
+template <> struct uint_of_size<2> { using type = uint16_t; };
+template <> struct uint_of_size<4> { using type = uint32_t; };
+template <> struct uint_of_size<8> { using type = uint64_t; };
+
+
+/**
+ *  \brief  Packed bigram key
+ *
+ *  Bigram is packed into a single unsigned integer twice the size of the character.
+ *  The packing preserves the lexicographic order of the characters tuple
+ *  (signed characters are biased so that negative values sort first), so keys
+ *  may be compared directly instead of the bigram tuples.
+ *
+ *  \tparam  Char  Character type
+ */
+template <typename Char>
+struct bigram_key {
+    using char_t = Char;                                /**< Character type     */
+    using bigram_t = std::tuple<char_t, char_t>;        /**< Bigram type        */
+    using uchar_t = std::make_unsigned_t<char_t>;       /**< Unsigned character */
+
+    /** Packed bigram key type */
+    using key_t = typename uint_of_size<2 * sizeof(char_t)>::type;
+
+    static constexpr unsigned char_bits = 8 * sizeof(char_t);  /**< Character bits */
+
+    /** Sign bias (flips sign bit of signed characters) */
+    static constexpr uchar_t bias = std::is_signed_v<char_t>
+        ? static_cast<uchar_t>(uchar_t(1) << (char_bits - 1))
+        : uchar_t(0);
+
+    /** Pack characters to key */
+    static constexpr key_t pack(char_t ch1, char_t ch2) noexcept {
+        return
+            static_cast<key_t>(static_cast<uchar_t>(ch1) ^ bias) << char_bits |
+            static_cast<key_t>(static_cast<uchar_t>(ch2) ^ bias);
+    }
+
+    /** Pack bigram to key */
+    static constexpr key_t pack(const bigram_t & bigram) noexcept {
+        return pack(std::get<0>(bigram), std::get<1>(bigram));
+    }
+
+    /** Unpack key to bigram */
+    static constexpr bigram_t unpack(key_t key) noexcept {
+        return bigram_t(
+            static_cast<char_t>(static_cast<uchar_t>(key >> char_bits) ^ bias),
+            static_cast<char_t>(static_cast<uchar_t>(key) ^ bias));
+    }
+
+};  // end of template struct bigram_key
+
+
+/**
+ *  \brief  Bigram multiset storage: sorted list of [bigram, count] tuples
+ *
+ *  Like all the storages, the list allocates from a polymorphic allocator
+ *  (the default memory resource unless specified, see \c arena.hxx).
+ *
+ *  \tparam  Char  Character type
+ */
+template <typename Char>
+class list_bigram_storage {
+    public:
+
+    using char_t = Char;                                /**< Character type         */
+    using bigram_t = std::tuple<char_t, char_t>;        /**< Bigram type            */
+    using bigram_cnt_t = std::tuple<bigram_t, size_t>;  /**< [Bigram, count] tuple  */
+    using key_traits = bigram_key<char_t>;              /**< Bigram key traits      */
+    using key_t = typename key_traits::key_t;           /**< Packed bigram key      */
+
+    /** Allocator type */
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+    private:
+
+    using impl_t = std::pmr::list<bigram_cnt_t>;
+
+    public:
+
+    using const_iterator = typename impl_t::const_iterator;  /**< Const. iterator type */
+
+    private:
+
+    impl_t m_impl;  /**< Sorted list of bigrams */
+
+    /**
+     *  \brief  [bigram, count] tuple packed key
+     *
+     *  Comparing packed keys is a single integer comparison (unlike lexicographic
+     *  comparison of the bigram tuples).
+     *
+     *  \param  bigram_cnt  [bigram, count] tuple
+     *
+     *  \return Packed bigram key
+     */
+    static key_t key(const bigram_cnt_t & bigram_cnt) {
+        return key_traits::pack(std::get<0>(bigram_cnt));
+    }
+
+    public:
+
+    /** Default constructor */
+    list_bigram_storage() = default;
+
+    /** Constructor (with allocator) */
+    explicit list_bigram_storage(const allocator_type & alloc): m_impl(alloc) {}
+
+    /** Copy constructor (allocator-extended) */
+    list_bigram_storage(const list_bigram_storage & orig, const allocator_type & alloc):
+        m_impl(orig.m_impl, alloc)
+    {}
+
+    /** Allocator getter */
+    allocator_type get_allocator() const { return m_impl.get_allocator(); }
+
+    /** Reserve space for bigrams (no-op for list) */
+    void reserve(size_t ) {}
+
+    /**
+     *  \brief  Append bigram
+     *
+     *  The bigram must be greater than the last stored one.
+     *
+     *  \param  bigram  Bigram
+     *  \param  cnt     Bigram count
+     */
+    void emplace_back(const bigram_t & bigram, size_t cnt) {
+        m_impl.emplace_back(bigram, cnt);
+    }
+
+    /** Number of distinct bigrams */
+    size_t length() const { return m_impl.size(); }
+
+    /** \brief  Begin const. iterator getter */
+    const_iterator cbegin() const { return m_impl.cbegin(); }
+
+    /** \brief  End const. iterator getter */
+    const_iterator cend() const { return m_impl.cend(); }
+
+    /**
+     *  \brief  Merge other bigrams into the storage (multiset union)
+     *
+     *  \param  other  Other bigrams
+     */
+    void merge(const list_bigram_storage & other) {
+        auto other_bigram = other.m_impl.cbegin();
+
+        for (auto my_bigram = m_impl.begin(); my_bigram != m_impl.end(); ) {
+            if (other_bigram == other.m_impl.cend())  // reached end of the other bigrams
+                return;  // we're done
+
+            const key_t my_key = key(*my_bigram);
+            const key_t other_key = key(*other_bigram);
+
+            if (my_key < other_key) {  // seek suitable position
+                ++my_bigram;
+                continue;
+            }
+
+            if (my_key == other_key) {  // bigram(s) already present, merge
+                std::get<1>(*my_bigram) += std::get<1>(*other_bigram);
+                ++my_bigram;
+            }
+
+            else  // position found, insert bigram
+                m_impl.insert(my_bigram, *other_bigram);
+
+            ++other_bigram;
+        }
+
+        // Append trailng bigrams if any
+        for (; other_bigram != other.m_impl.cend(); ++other_bigram)
+            m_impl.push_back(*other_bigram);
+    }
+
+    /**
+     *  \brief  Store union of 2 bigram multisets
+     *
+     *  \param  storage1  Bigrams storage
+     *  \param  storage2  Bigrams storage
+     */
+    void unite(
+        const list_bigram_storage & storage1,
+        const list_bigram_storage & storage2)
+    {
+        m_impl = storage1.m_impl;
+        merge(storage2);
+    }
+
+    /**
+     *  \brief  Intersection size
+     *
+     *  \param  storage1  Bigrams storage
+     *  \param  storage2  Bigrams storage
+     *
+     *  \return Size of the bigram multisets intersection
+     */
+    static size_t intersect_size(
+        const list_bigram_storage & storage1,
+        const list_bigram_storage & storage2)
+    {
+        size_t size = 0;
+
+        auto bg1 = storage1.m_impl.cbegin();
+        auto bg2 = storage2.m_impl.cbegin();
+        while (bg1 != storage1.m_impl.cend() && bg2 != storage2.m_impl.cend()) {
+            const key_t key1 = key(*bg1);
+            const key_t key2 = key(*bg2);
+
+            if (key1 < key2) ++bg1;  // no match, next in bigrams1
+
+            else if (key1 == key2) {  // match, update size
+                size += std::min(std::get<1>(*bg1), std::get<1>(*bg2));
+                ++bg1;
+                ++bg2;
+            }
+
+            else ++bg2;  // no match, next in bigrams2
+        }
+
+        return size;
+    }
+
+};  // end of template class list_bigram_storage
+
+
+/**
+ *  \brief  Bigram multiset storage: sorted flat arrays
+ *
+ *  The bigrams are stored in structure-of-arrays manner: sorted array of packed
+ *  bigram keys and a separate array of respective counts.
+ *  Unlike the list storage, that means one allocation per array (not per bigram)
+ *  and contiguous memory access in merge loops.
+ *  Moreover, small multisets (most of the short tokens) are stored inline,
+ *  with no allocation at all.
+ *
+ *  \tparam  Char            Character type
+ *  \tparam  InlineCapacity  Max. number of distinct bigrams stored inline
+ */
+template <typename Char, size_t InlineCapacity = 16>
+class flat_bigram_storage {
+    public:
+
+    using char_t = Char;                                /**< Character type         */
+    using bigram_t = std::tuple<char_t, char_t>;        /**< Bigram type            */
+    using bigram_cnt_t = std::tuple<bigram_t, size_t>;  /**< [Bigram, count] tuple  */
+    using key_traits = bigram_key<char_t>;              /**< Bigram key traits      */
+    using key_t = typename key_traits::key_t;           /**< Packed bigram key      */
+
+    static constexpr size_t inline_capacity = InlineCapacity;  /**< Inline capacity */
+
+    /** Allocator type */
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+    private:
+
+    using keys_t = small_vector<key_t, InlineCapacity>;     /**< Packed bigram keys */
+    using cnts_t = small_vector<size_t, InlineCapacity>;    /**< Bigram counts      */
+
+    keys_t m_keys;  /**< Sorted packed bigram keys  */
+    cnts_t m_cnts;  /**< Bigram counts              */
+
+    public:
+
+    /** Const. iterator (produces [bigram, count] tuples by value) */
+    class const_iterator {
+        friend class flat_bigram_storage;
+
+        public:
+
+        using iterator_category = std::forward_iterator_tag;    /**< Category   */
+        using value_type = bigram_cnt_t;                        /**< Value      */
+        using difference_type = std::ptrdiff_t;                 /**< Difference */
+        using pointer = void;                                   /**< Pointer    */
+        using reference = bigram_cnt_t;                         /**< Reference  */
+
+        private:
+
+        const key_t * m_key;    /**< Key pointer    */
+        const size_t * m_cnt;   /**< Count pointer  */
+
+        const_iterator(const key_t * key, const size_t * cnt): m_key(key), m_cnt(cnt) {}
+
+        public:
+
+        /** Default constructor (singular iterator) */
+        const_iterator(): m_key(nullptr), m_cnt(nullptr) {}
+
+        /** Dereference */
+        bigram_cnt_t operator * () const {
+            return bigram_cnt_t(key_traits::unpack(*m_key), *m_cnt);
+        }
+
+        /** Pre-increment */
+        const_iterator & operator ++ () {
+            ++m_key;
+            ++m_cnt;
+            return *this;
+        }
+
+        /** Post-increment */
+        const_iterator operator ++ (int) {
+            const_iterator orig(*this);
+            ++*this;
+            return orig;
+        }
+
+        /** Comparison (eq) */
+        bool operator == (const const_iterator & other) const {
+            return m_key == other.m_key;
+        }
+
+        /** Comparison (ne) */
+        bool operator != (const const_iterator & other) const { return !(*this == other); }
+
+    };  // end of class const_iterator
+
+    /** Default constructor */
+    flat_bigram_storage() = default;
+
+    /** Constructor (with allocator) */
+    explicit flat_bigram_storage(const allocator_type & alloc):
+        m_keys(alloc), m_cnts(alloc)
+    {}
+
+    /** Copy constructor (allocator-extended) */
+    flat_bigram_storage(const flat_bigram_storage & orig, const allocator_type & alloc):
+        m_keys(orig.m_keys, alloc), m_cnts(orig.m_cnts, alloc)
+    {}
+
+    /** Allocator getter */
+    allocator_type get_allocator() const { return m_keys.get_allocator(); }
+
+    /** Reserve space for bigrams */
+    void reserve(size_t len) {
+        m_keys.reserve(len);
+        m_cnts.reserve(len);
+    }
+
+    /**
+     *  \brief  Append bigram
+     *
+     *  The bigram must be greater than the last stored one.
+     *
+     *  \param  bigram  Bigram
+     *  \param  cnt     Bigram count
+     */
+    void emplace_back(const bigram_t & bigram, size_t cnt) {
+        m_keys.push_back(key_traits::pack(bigram));
+        m_cnts.push_back(cnt);
+    }
+
+    /** Number of distinct bigrams */
+    size_t length() const { return m_keys.size(); }
+
+    /** Packed keys */
+    const key_t * keys() const { return m_keys.data(); }
+
+    /** Counts */
+    const size_t * counts() const { return m_cnts.data(); }
+
+    /** \brief  Begin const. iterator getter */
+    const_iterator cbegin() const { return const_iterator(keys(), counts()); }
+
+    /** \brief  End const. iterator getter */
+    const_iterator cend() const {
+        return const_iterator(keys() + length(), counts() + length());
+    }
+
+    /**
+     *  \brief  Store union of 2 bigram multisets
+     *
+     *  \param  storage1  Bigrams storage (must not be this one)
+     *  \param  storage2  Bigrams storage (must not be this one)
+     */
+    void unite(
+        const flat_bigram_storage & storage1,
+        const flat_bigram_storage & storage2)
+    {
+        const size_t len1 = storage1.length();
+        const size_t len2 = storage2.length();
+        const key_t * keys1 = storage1.keys();
+        const key_t * keys2 = storage2.keys();
+        const size_t * cnts1 = storage1.counts();
+        const size_t * cnts2 = storage2.counts();
+
+        m_keys.resize(len1 + len2);
+        m_cnts.resize(len1 + len2);
+
+        // Branch-free merge step: the smaller key is taken (both if equal)
+        size_t i1 = 0, i2 = 0, len = 0;
+        while (i1 < len1 && i2 < len2) {
+            const key_t key1 = keys1[i1];
+            const key_t key2 = keys2[i2];
+            const bool take1 = key1 <= key2;
+            const bool take2 = key2 <= key1;
+
+            m_keys[len] = take1 ? key1 : key2;
+            m_cnts[len] =
+                (take1 ? cnts1[i1] : 0) +
+                (take2 ? cnts2[i2] : 0);
+
+            i1 += take1;
+            i2 += take2;
+            ++len;
+        }
+
+        // Copy the remainder
+        for (; i1 < len1; ++i1, ++len) {
+            m_keys[len] = keys1[i1];
+            m_cnts[len] = cnts1[i1];
+        }
+
+        for (; i2 < len2; ++i2, ++len) {
+            m_keys[len] = keys2[i2];
+            m_cnts[len] = cnts2[i2];
+        }
+
+        m_keys.resize(len);
+        m_cnts.resize(len);
+    }
+
+    /**
+     *  \brief  Merge other bigrams into the storage (multiset union)
+     *
+     *  The merge is done to a new pair of arrays (no insertions in the middle).
+     *
+     *  \param  other  Other bigrams
+     */
+    void merge(const flat_bigram_storage & other) {
+        flat_bigram_storage merged(get_allocator());
+        merged.unite(*this, other);
+        *this = std::move(merged);
+    }
+
+    /**
+     *  \brief  Intersection size
+     *
+     *  Uses the best (SIMD) kernel available on the CPU, see \c simd_intersect.hxx.
+     *
+     *  \param  storage1  Bigrams storage
+     *  \param  storage2  Bigrams storage
+     *
+     *  \return Size of the bigram multisets intersection
+     */
+    static size_t intersect_size(
+        const flat_bigram_storage & storage1,
+        const flat_bigram_storage & storage2)
+    {
+        return simd::intersect_size(
+            storage1.keys(), storage1.counts(), storage1.length(),
+            storage2.keys(), storage2.counts(), storage2.length());
+    }
+
+};  // end of template class flat_bigram_storage
+
+}  // end of namespace libsdcxx
+
+#endif  // end of #ifndef libsdcxx__bigram_storage_hxx
@@ -43,24 +43,42 @@
  *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include "bigram_storage.hxx"
+#include "bigram_sketch.hxx"
+#include "bigram_sort.hxx"
+#include "utf8.hxx"
+
 #include <cstddef>
 #include <cassert>
 #include <string>
+#include <string_view>
 #include <tuple>
-#include <list>
 #include <vector>
+#include <iterator>
+#include <type_traits>
 #include <algorithm>
 #include <iostream>
 
 
 namespace libsdcxx {
 
+/** Sorted [bigram, count] tuples input tag (see \c basic_bigrams constructor) */
+struct sorted_bigrams_t {};
+
+constexpr sorted_bigrams_t sorted_bigrams {};  /**< Sorted bigrams input tag */
+
+
 /**
  *  \brief  String Bigrams
  *
- *  \tparam  Char  Character type
+ *  The bigram multiset storage is a template parameter; see \c list_bigram_storage
+ *  (the default) and \c flat_bigram_storage in \c bigram_storage.hxx.
+ *  Any of them may keep a sketch of the multiset (see \c sketched_bigram_storage).
+ *
+ *  \tparam  Char     Character type
+ *  \tparam  Storage  Bigram multiset storage implementation
  */
-template <typename Char>
+template <typename Char, class Storage = list_bigram_storage<Char>>
 class basic_bigrams {
     public:
 
@@ -68,11 +86,17 @@ class basic_bigrams {
     using string_t = std::basic_string<char_t>;         /**< String type            */
     using bigram_t = std::tuple<char_t, char_t>;        /**< Bigram type            */
     using bigram_cnt_t = std::tuple<bigram_t, size_t>;  /**< [Bigram, count] tuple  */
+    using storage_t = Storage;                          /**< Storage type           */
+
+    /** Storage keeps bigrams sketch (see \c sketched_bigram_storage) */
+    static constexpr bool sketched = is_sketched_storage<storage_t>::value;
+
+    /** Allocator type (see \c arena.hxx) */
+    using allocator_type = typename storage_t::allocator_type;
 
     private:
 
-    using impl_t = std::list<bigram_cnt_t>;
-    using init_t = std::tuple<const impl_t, const size_t>;
+    using impl_t = storage_t;
 
     public:
 
@@ -80,26 +104,110 @@ class basic_bigrams {
 
     private:
 
-    impl_t  m_impl;     /**< Sorted list of bigrams     */
+    using key_traits = bigram_key<char_t>;
+    using key_t = typename key_traits::key_t;
+
+    impl_t  m_impl;     /**< Sorted bigrams storage     */
     size_t  m_size;     /**< Individual bigram count    */
 
     /**
-     *  \brief  [bigram, count] comparator
+     *  \brief  Pack string bigrams to keys
      *
-     *  \param  bc1  [bigram, count] tuple
-     *  \param  bc2  [bigram, count] tuple
+     *  \param  str   String
+     *  \param  keys  Keys array (of \c str.size() - 1 keys)
      *
-     *  \return Negative value if bc1 < bc2, 0 if equal, positive value otherwise
+     *  \return Number of keys
      */
-    static ssize_t cmp(const bigram_cnt_t & bc1, const bigram_cnt_t & bc2) {
-        const auto & b1 = std::get<0>(bc1);
-        const auto & b2 = std::get<0>(bc2);
+    static size_t pack_bigrams(std::basic_string_view<char_t> str, key_t * keys) {
+        for (size_t i = 1; i < str.size(); ++i)
+            keys[i-1] = key_traits::pack(str[i-1], str[i]);
+
+        return str.size() - 1;
+    }
+
+    /**
+     *  \brief  Pack UTF-8 string bigrams to keys (code points are decoded on the fly)
+     *
+     *  \param  str   UTF-8 string
+     *  \param  keys  Keys array (of \c str.size() - 1 keys at least)
+     *
+     *  \return Number of keys
+     */
+    static size_t pack_utf8_bigrams(std::string_view str, key_t * keys) {
+        const char * ptr = str.data();
+        const char * const end = ptr + str.size();
+
+        size_t cnt = 0;
+        char_t ch1 = static_cast<char_t>(utf8_decode(ptr, end));
+        while (ptr < end) {
+            const char_t ch2 = static_cast<char_t>(utf8_decode(ptr, end));
+            keys[cnt++] = key_traits::pack(ch1, ch2);
+            ch1 = ch2;
+        }
+
+        return cnt;
+    }
+
+    /**
+     *  \brief  Create bigrams from packed keys
+     *
+     *  \param  max_size  Max. number of bigrams (the packed keys count upper bound)
+     *  \param  pack      Keys packing, called as \c pack(key_t*), returns keys count
+     */
+    template <class Pack>
+    void emplace_packed(size_t max_size, Pack && pack) {
+        if (0 == max_size) return;  // no bigrams
+
+        if (max_size <= bigram_insertion_sort_max) {  // short token fast path
+            key_t keys[bigram_insertion_sort_max];
+            m_size = pack(keys);
+            if (0 == m_size) return;  // e.g. a single multi-byte UTF-8 character
+
+            insertion_sort_keys(keys, m_size);
+            emplace_sorted(keys);
+            return;
+        }
+
+        // Keys and sorting scratch space buffer is reused
+        thread_local std::vector<key_t> buffer;
+        buffer.resize(std::max(buffer.size(), 2 * max_size));
+
+        key_t * keys = buffer.data();
+        m_size = pack(keys);
+        if (0 == m_size) return;
+
+        if (m_size <= bigram_insertion_sort_max)
+            insertion_sort_keys(keys, m_size);
+        else
+            sort_keys(keys, m_size, keys + m_size);
+
+        emplace_sorted(keys);
+    }
+
+    /**
+     *  \brief  Store sorted keys (same keys are unified)
+     *
+     *  \param  keys  Sorted keys array (of \c m_size keys)
+     */
+    void emplace_sorted(const key_t * keys) {
+        assert(m_size > 0);  // there is at least one bigram
+
+        size_t len = 1;
+        for (size_t i = 1; i < m_size; ++i)
+            len += keys[i] != keys[i-1];
 
-        ssize_t diff = ssize_t(std::get<0>(b1)) - ssize_t(std::get<0>(b2));
-        if (0 == diff)  // lexicographic descend
-            diff = ssize_t(std::get<1>(b1)) - ssize_t(std::get<1>(b2));
+        m_impl.reserve(len);
 
-        return diff;
+        size_t cnt = 1;
+        for (size_t i = 1; i < m_size; ++i) {  // unify same bigrams
+            if (keys[i] == keys[i-1])
+                ++cnt;  // existing bigram, increase count
+            else {
+                m_impl.emplace_back(key_traits::unpack(keys[i-1]), cnt);
+                cnt = 1;
+            }
+        }
+        m_impl.emplace_back(key_traits::unpack(keys[m_size-1]), cnt);
     }
 
     public:
@@ -108,46 +216,132 @@ class basic_bigrams {
     basic_bigrams(): m_size(0) {}
 
     /**
-     *  \brief  Constructor (from a string)
+     *  \brief  Constructor (empty bigrams with allocator)
      *
-     *  \param  str  Bigrams source
+     *  \param  alloc  Allocator
      */
-    basic_bigrams(const string_t & str): m_size(0) {
-        if (str.size() < 2)  // there must be at least 2 characters to create bigrams
-            return;
+    explicit basic_bigrams(const allocator_type & alloc): m_impl(alloc), m_size(0) {}
 
-        std::vector<bigram_t> bigram_vec;
-        bigram_vec.reserve(std::min(0lu, str.size() - 1));  // abcd -> {ab, bc, cd}
+    /**
+     *  \brief  Constructor (from a string view)
+     *
+     *  \param  str    Bigrams source
+     *  \param  alloc  Allocator
+     */
+    explicit basic_bigrams(
+        std::basic_string_view<char_t> str,
+        const allocator_type & alloc = allocator_type())
+    :
+        m_impl(alloc), m_size(0)
+    {
+        // There must be at least 2 characters to create bigrams (abcd -> {ab, bc, cd})
+        emplace_packed(str.size() < 2 ? 0 : str.size() - 1,
+            [str](key_t * keys) { return pack_bigrams(str, keys); });
+    }
 
-        for (size_t i = 0; i < str.size() - 1; ++i)  // create bigrams
-            bigram_vec.emplace_back(str[i], str[i+1]);
+    /**
+     *  \brief  Constructor (from a string)
+     *
+     *  \param  str    Bigrams source
+     *  \param  alloc  Allocator
+     */
+    basic_bigrams(const string_t & str, const allocator_type & alloc = allocator_type()):
+        basic_bigrams(std::basic_string_view<char_t>(str), alloc)
+    {}
 
-        std::sort(bigram_vec.begin(), bigram_vec.end());
+    /**
+     *  \brief  Constructor (from a C string)
+     *
+     *  \param  str    Bigrams source (zero-terminated)
+     *  \param  alloc  Allocator
+     */
+    explicit basic_bigrams(const char_t * str, const allocator_type & alloc = allocator_type()):
+        basic_bigrams(std::basic_string_view<char_t>(str), alloc)
+    {}
 
-        m_size = bigram_vec.size();
-        assert(m_size > 0);  // there is at least one bigram
+    /**
+     *  \brief  Constructor (from a UTF-8 string)
+     *
+     *  Code points are decoded on the fly (no intermediate string is created);
+     *  malformed sequences produce U+FFFD (see \c utf8_decode).
+     *  Requires the character type to hold any code point (e.g. \c wchar_t on POSIX).
+     *
+     *  \param  str    Bigrams source (UTF-8 encoded)
+     *  \param  alloc  Allocator
+     */
+    basic_bigrams(utf8_t , std::string_view str, const allocator_type & alloc = allocator_type()):
+        m_impl(alloc), m_size(0)
+    {
+        static_assert(sizeof(char_t) >= sizeof(char32_t),
+            "UTF-8 input requires character type holding any code point");
+
+        // Number of code points is at most the number of bytes
+        emplace_packed(str.size() < 2 ? 0 : str.size() - 1,
+            [str](key_t * keys) { return pack_utf8_bigrams(str, keys); });
+    }
 
-        auto bigram = bigram_vec.cbegin();
-        m_impl.emplace_back(*bigram, 1);
-        for (++bigram; bigram != bigram_vec.cend(); ++bigram) {  // unify same bigrams
-            auto & last_bigram_cnt = m_impl.back();
+    /**
+     *  \brief  Constructor (union of 2 bigram multisets)
+     *
+     *  \param  bigrams1  Bigram multiset
+     *  \param  bigrams2  Bigram multiset
+     *  \param  alloc     Allocator
+     */
+    basic_bigrams(
+        const basic_bigrams & bigrams1,
+        const basic_bigrams & bigrams2,
+        const allocator_type & alloc = allocator_type())
+    :
+        m_impl(alloc), m_size(bigrams1.m_size + bigrams2.m_size)
+    {
+        m_impl.unite(bigrams1.m_impl, bigrams2.m_impl);
+    }
 
-            if (std::get<0>(last_bigram_cnt) == *bigram)
-                ++std::get<1>(last_bigram_cnt);  // existing bigram, increase count
-            else
-                m_impl.emplace_back(*bigram, 1);
+    /**
+     *  \brief  Constructor (from sorted [bigram, count] tuples)
+     *
+     *  The tuples must be sorted by bigram with no duplicates, as bigrams (and their
+     *  views) iterate them; this allows e.g. for materialising a bigrams view.
+     *
+     *  \param  begin  Tuples begin
+     *  \param  end    Tuples end
+     *  \param  alloc  Allocator
+     */
+    template <class Iter>
+    basic_bigrams(
+        sorted_bigrams_t , Iter begin, Iter end,
+        const allocator_type & alloc = allocator_type())
+    :
+        m_impl(alloc), m_size(0)
+    {
+        using category = typename std::iterator_traits<Iter>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>)
+            m_impl.reserve(std::distance(begin, end));
+
+        for (; begin != end; ++begin) {
+            const bigram_cnt_t bigram_cnt = *begin;
+            m_impl.emplace_back(std::get<0>(bigram_cnt), std::get<1>(bigram_cnt));
+            m_size += std::get<1>(bigram_cnt);
         }
     }
 
     /** Copy constructor */
     basic_bigrams(const basic_bigrams & ) = default;
 
+    /** Copy constructor (allocator-extended) */
+    basic_bigrams(const basic_bigrams & orig, const allocator_type & alloc):
+        m_impl(orig.m_impl, alloc), m_size(orig.m_size)
+    {}
+
     /** Move constructor */
     basic_bigrams(basic_bigrams && ) = default;
 
     /** Copy assignment */
     basic_bigrams & operator = (const basic_bigrams & ) = default;
 
+    /** Move assignment */
+    basic_bigrams & operator = (basic_bigrams && ) = default;
+
     /**
      *  \brief  Size getter
      *
@@ -155,6 +349,12 @@ class basic_bigrams {
      */
     size_t size() const { return m_size; }
 
+    /** Allocator getter */
+    allocator_type get_allocator() const { return m_impl.get_allocator(); }
+
+    /** \brief  Storage getter */
+    const storage_t & storage() const { return m_impl; }
+
     /** \brief  Begin const. iterator getter */
     const_iterator cbegin() const { return m_impl.cbegin(); }
 
@@ -162,10 +362,10 @@ class basic_bigrams {
     const_iterator cend() const { return m_impl.cend(); }
 
     /** \brief  Begin iterator getter */
-    const_iterator begin() const { return m_impl.begin(); }
+    const_iterator begin() const { return m_impl.cbegin(); }
 
     /** \brief  End iterator getter */
-    const_iterator end() const { return m_impl.end(); }
+    const_iterator end() const { return m_impl.cend(); }
 
     /**
      *  \brief  Update current bigram multiset by other bigrams
@@ -176,42 +376,20 @@ class basic_bigrams {
         if (size() == 0)  // optimisation for empty multiset
             return *this = other;
 
-        auto other_bigram = other.m_impl.cbegin();
-
-        for (auto my_bigram = m_impl.begin(); my_bigram != m_impl.end(); ) {
-            if (other_bigram == other.m_impl.cend())  // reached end of the other bigrams
-                return *this;  // we're done
-
-            const auto bg_cmp = cmp(*my_bigram, *other_bigram);
-
-            if (bg_cmp < 0) {  // seek suitable position
-                ++my_bigram;
-                continue;
-            }
-
-            if (0 == bg_cmp) {  // bigram(s) already present, merge
-                std::get<1>(*my_bigram) += std::get<1>(*other_bigram);
-                ++my_bigram;
-            }
-
-            else  // position found, insert bigram
-                m_impl.insert(my_bigram, *other_bigram);
-
-            m_size += std::get<1>(*other_bigram);
-            ++other_bigram;
-        }
-
-        // Append trailng bigrams if any
-        for (; other_bigram != other.m_impl.cend(); ++other_bigram) {
-            m_impl.push_back(*other_bigram);
-            m_size += std::get<1>(*other_bigram);
-        }
+        m_impl.merge(other.m_impl);
+        m_size += other.m_size;
 
         return *this;
     }
 
     private:
 
+    /** Range element access (bigrams) */
+    static const basic_bigrams & bigrams_of(const basic_bigrams & bgrms) { return bgrms; }
+
+    /** Range element access (pointer to bigrams) */
+    static const basic_bigrams & bigrams_of(const basic_bigrams * bgrms) { return *bgrms; }
+
     /** Union of bigrams (fixed point of template recursion) */
     static basic_bigrams unite(const basic_bigrams & arg) {
         return arg;  // make a copy
@@ -234,6 +412,107 @@ class basic_bigrams {
         return unite(args...) += arg1;
     }
 
+    /**
+     *  \brief  Union of a range of bigrams
+     *
+     *  Unlike the variadic \c unite (and folding by \c +=), the bigrams are united
+     *  by a single k-way merge in O(n log k) time (n being the total number of distinct
+     *  bigrams of the k multisets).
+     *  The result storage is reserved in advance (i.e. the flat storage is allocated
+     *  at most once).
+     *  Note that folding by \c += may still be faster if the multisets overlap so much
+     *  that their union is far smaller than the sum of their sizes (O(n + k u) time,
+     *  u being the union size).
+     *
+     *  \tparam  Iter  Input iterator of bigrams (or pointers to bigrams)
+     *
+     *  \param  begin  Range begin
+     *  \param  end    Range end
+     *  \param  alloc  Allocator of the union
+     *
+     *  \return Union of bigrams
+     */
+    template <class Iter,
+        class = std::enable_if_t<!std::is_convertible_v<Iter, const basic_bigrams &>>>
+    static basic_bigrams unite(
+        Iter begin, Iter end,
+        const allocator_type & alloc = allocator_type())
+    {
+        struct cursor {
+            key_t           key;    /**< Current bigram key     */
+            size_t          cnt;    /**< Current bigram count   */
+            const_iterator  iter;   /**< Current bigram         */
+            const_iterator  end;    /**< End of bigrams         */
+
+            /** Read current bigram */
+            void read() {
+                const bigram_cnt_t bigram_cnt = *iter;
+                key = key_traits::pack(std::get<0>(bigram_cnt));
+                cnt = std::get<1>(bigram_cnt);
+            }
+        };
+
+        basic_bigrams result(alloc);
+
+        std::vector<cursor> heap;
+        size_t length = 0;
+        for (; begin != end; ++begin) {
+            const basic_bigrams & bgrms = bigrams_of(*begin);
+            if (0 == bgrms.size()) continue;
+
+            heap.push_back(cursor{0, 0, bgrms.cbegin(), bgrms.cend()});
+            heap.back().read();
+            length += bgrms.m_impl.length();
+            result.m_size += bgrms.m_size;
+        }
+
+        if (heap.empty()) return result;
+
+        result.m_impl.reserve(length);  // upper bound
+
+        // Min-heap by the current keys
+        std::make_heap(heap.begin(), heap.end(),
+            [](const cursor & c1, const cursor & c2) { return c1.key > c2.key; });
+
+        // Sift the top cursor down (cheaper than pop & push of the same cursor)
+        const auto sift_down = [&heap]() {
+            const size_t heap_size = heap.size();
+            const cursor top = heap.front();
+            size_t i = 0;
+            for (size_t child = 1; child < heap_size; i = child, child = 2 * i + 1) {
+                if (child + 1 < heap_size && heap[child + 1].key < heap[child].key) ++child;
+                if (!(heap[child].key < top.key)) break;
+                heap[i] = heap[child];
+            }
+            heap[i] = top;
+        };
+
+        key_t key = heap.front().key;
+        size_t cnt = 0;
+        for (;;) {
+            auto & top = heap.front();
+
+            if (top.key != key) {  // all the previous bigrams were counted
+                result.m_impl.emplace_back(key_traits::unpack(key), cnt);
+                key = top.key;
+                cnt = 0;
+            }
+            cnt += top.cnt;
+
+            if (++top.iter != top.end)
+                top.read();
+            else {  // replace the exhausted cursor by the last one
+                top = heap.back();
+                heap.pop_back();
+                if (heap.empty()) break;
+            }
+            sift_down();
+        }
+        result.m_impl.emplace_back(key_traits::unpack(key), cnt);
+
+        return result;
+    }
+
     /**
      *  \brief  Union of 2 bigrams
      *
@@ -242,7 +521,7 @@ class basic_bigrams {
      *  \return Union of bigrams
      */
     basic_bigrams operator + (const basic_bigrams & other) const {
-        return unite(*this, other);
+        return basic_bigrams(*this, other);
     }
 
     /**
@@ -260,25 +539,28 @@ class basic_bigrams {
         const basic_bigrams & bigrams1,
         const basic_bigrams & bigrams2)
     {
-        size_t size = 0;
-
-        auto bg1 = bigrams1.m_impl.cbegin();
-        auto bg2 = bigrams2.m_impl.cbegin();
-        while (bg1 != bigrams1.m_impl.cend() && bg2 != bigrams2.m_impl.cend()) {
-            const auto bg_cmp = cmp(*bg1, *bg2);
-
-            if (bg_cmp < 0) ++bg1;  // no match, next in bigrams1
-
-            else if (bg_cmp == 0) {  // match, update size
-                size += std::min(std::get<1>(*bg1), std::get<1>(*bg2));
-                ++bg1;
-                ++bg2;
-            }
-
-            else ++bg2;  // no match, next in bigrams2
-        }
+        return impl_t::intersect_size(bigrams1.m_impl, bigrams2.m_impl);
+    }
 
-        return size;
+    /**
+     *  \brief  Bigram multisets intersection size upper bound
+     *
+     *  Computed from the sketches in constant time if the storage keeps them
+     *  (see \c sketched_bigram_storage); otherwise, it's the smaller size.
+     *
+     *  \param  bigrams1  Bigram multiset
+     *  \param  bigrams2  Bigram multiset
+     *
+     *  \return Upper bound of the bigram multisets intersection size
+     */
+    static size_t intersect_bound(
+        const basic_bigrams & bigrams1,
+        const basic_bigrams & bigrams2)
+    {
+        if constexpr (sketched)
+            return impl_t::intersect_bound(bigrams1.m_impl, bigrams2.m_impl);
+        else
+            return std::min(bigrams1.size(), bigrams2.size());
     }
 
     /**
@@ -310,7 +592,8 @@ class basic_bigrams {
 /**
  *  \brief  (Wide) bigrams serialisation
  *
- *  \tparam  Char  Character type
+ *  \tparam  Char     Character type
+ *  \tparam  Storage  Bigrams storage
  *
  *  \param  out    Output stream
  *  \param  bgrms  Bigrams
@@ -318,10 +601,10 @@ class basic_bigrams {
  *
  *  \return \c out
  */
-template <typename Char>
+template <typename Char, class Storage>
 std::basic_ostream<Char> & serialise_bigrams (
     std::basic_ostream<Char> & out,
-    const basic_bigrams<Char> & bgrms,
+    const basic_bigrams<Char, Storage> & bgrms,
     const char * name)
 {
     static const auto * left_curly_bracket = "{";
@@ -344,6 +627,20 @@ std::basic_ostream<Char> & serialise_bigrams (
 using bigrams = basic_bigrams<char>;        /**< ASCII/ANSI string bigrams  */
 using wbigrams = basic_bigrams<wchar_t>;    /**< UNICODE string bigrams     */
 
+/**< ASCII/ANSI string bigrams (flat storage) */
+using flat_bigrams = basic_bigrams<char, flat_bigram_storage<char>>;
+
+/**< UNICODE string bigrams (flat storage) */
+using wflat_bigrams = basic_bigrams<wchar_t, flat_bigram_storage<wchar_t>>;
+
+/**< ASCII/ANSI string bigrams (flat storage with sketch) */
+using sketched_bigrams =
+    basic_bigrams<char, sketched_bigram_storage<flat_bigram_storage<char>>>;
+
+/**< UNICODE string bigrams (flat storage with sketch) */
+using wsketched_bigrams =
+    basic_bigrams<wchar_t, sketched_bigram_storage<flat_bigram_storage<wchar_t>>>;
+
 
 /** Serialisation operator */
 inline std::ostream & operator << (std::ostream & out, const bigrams & bgrms) {
@@ -355,6 +652,26 @@ inline std::wostream & operator << (std::wostream & out, const wbigrams & bgrms)
     return serialise_bigrams(out, bgrms, "wbigrams");
 }
 
+/** Serialisation operator */
+inline std::ostream & operator << (std::ostream & out, const flat_bigrams & bgrms) {
+    return serialise_bigrams(out, bgrms, "flat_bigrams");
+}
+
+/** Serialisation operator */
+inline std::wostream & operator << (std::wostream & out, const wflat_bigrams & bgrms) {
+    return serialise_bigrams(out, bgrms, "wflat_bigrams");
+}
+
+/** Serialisation operator */
+inline std::ostream & operator << (std::ostream & out, const sketched_bigrams & bgrms) {
+    return serialise_bigrams(out, bgrms, "sketched_bigrams");
+}
+
+/** Serialisation operator */
+inline std::wostream & operator << (std::wostream & out, const wsketched_bigrams & bgrms) {
+    return serialise_bigrams(out, bgrms, "wsketched_bigrams");
+}
+
 }  // end of namespace libsdcxx
 
 #endif  // end of #ifndef libsdcxx__bigrams_hxx
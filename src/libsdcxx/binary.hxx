@@ -0,0 +1,259 @@
+#ifndef libsdcxx__binary_hxx
+#define libsdcxx__binary_hxx
+
+/**
+ *  \file
+ *  \brief  Compact binary serialisation
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bigrams.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <iterator>
+#include <stdexcept>
+
+
+namespace libsdcxx {
+
+/** Binary format error (malformed or incompatible input) */
+class binary_format_error: public std::runtime_error {
+    public:
+
+    using std::runtime_error::runtime_error;
+
+};  // end of class binary_format_error
+
+
+namespace binary {
+
+/**
+ *  \brief  Append varint (LEB128, 7 bits per byte, least significant first)
+ *
+ *  \param  out    Output buffer
+ *  \param  value  Value
+ */
+inline void put_varint(std::string & out, uint64_t value) {
+    for (; value >= 0x80; value >>= 7)
+        out += static_cast<char>(static_cast<unsigned char>(value) | 0x80);
+
+    out += static_cast<char>(value);
+}
+
+/**
+ *  \brief  Read varint
+ *
+ *  \param  ptr  Input position (shifted past the varint)
+ *  \param  end  Input end
+ *
+ *  \return Value
+ */
+inline uint64_t get_varint(const unsigned char * & ptr, const unsigned char * end) {
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        if (ptr == end) throw binary_format_error("truncated varint");
+
+        const unsigned char byte = *ptr++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (byte < 0x80) return value;
+    }
+
+    throw binary_format_error("varint too long");
+}
+
+constexpr char bigrams_magic[4] = { 'S', 'D', 'C', 'B' };  /**< Bigrams magic  */
+constexpr unsigned char bigrams_version = 2;                /**< Bigrams format */
+
+
+/**
+ *  \brief  Decoding iterator of [bigram, count] tuples (see \c deserialise_binary)
+ *
+ *  \tparam  Char  Character type
+ */
+template <typename Char>
+class bigrams_decoder {
+    private:
+
+    using key_traits = bigram_key<Char>;
+    using key_t = typename key_traits::key_t;
+    using bigram_t = std::tuple<Char, Char>;
+    using bigram_cnt_t = std::tuple<bigram_t, size_t>;
+
+    const unsigned char * m_ptr;    /**< Input position         */
+    const unsigned char * m_end;    /**< Input end              */
+    uint64_t m_left;                /**< Tuples left            */
+    bool m_first;                   /**< 1st tuple flag         */
+    key_t m_key;                    /**< Current key            */
+    bigram_cnt_t m_bigram_cnt;      /**< Current tuple          */
+
+    void decode() {
+        if (0 == m_left) return;
+
+        const uint64_t delta = binary::get_varint(m_ptr, m_end);
+        const uint64_t cnt = binary::get_varint(m_ptr, m_end);
+
+        // Keys must be strictly ascending, counts positive
+        if ((0 == delta && !m_first) || delta > static_cast<key_t>(~m_key) || 0 == cnt)
+            throw binary_format_error("malformed bigrams binary");
+
+        m_first = false;
+        m_key += static_cast<key_t>(delta);
+        m_bigram_cnt = bigram_cnt_t(key_traits::unpack(m_key), cnt);
+    }
+
+    public:
+
+    using iterator_category = std::input_iterator_tag;
+    using value_type = bigram_cnt_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const bigram_cnt_t *;
+    using reference = const bigram_cnt_t &;
+
+    bigrams_decoder(const unsigned char * ptr, const unsigned char * end, uint64_t left):
+        m_ptr(ptr), m_end(end), m_left(left), m_first(true), m_key(0)
+    {
+        decode();
+    }
+
+    reference operator * () const { return m_bigram_cnt; }
+    bigrams_decoder & operator ++ () { --m_left; decode(); return *this; }
+    bool operator != (const bigrams_decoder & rarg) const { return m_left != rarg.m_left; }
+
+};  // end of template class bigrams_decoder
+
+}  // end of namespace binary
+
+
+/**
+ *  \brief  Bigrams binary serialisation
+ *
+ *  Compact, versioned format: magic \c SDCB, format version, character size and
+ *  signedness bytes, then varints of the bigram count, the number of distinct bigrams
+ *  and [packed key delta, count] pairs (keys are sorted, so the deltas are small).
+ *  The packed keys of signed characters have the sign bit flipped (see \c bigram_key),
+ *  so the key order depends on the signedness and binaries of a different one
+ *  are rejected.
+ *
+ *  \tparam  Char     Character type
+ *  \tparam  Storage  Bigrams storage
+ *
+ *  \param  bgrms  Bigrams
+ *
+ *  \return Binary representation
+ */
+template <typename Char, class Storage>
+std::string serialise_binary(const basic_bigrams<Char, Storage> & bgrms) {
+    using key_traits = bigram_key<Char>;
+    using key_t = typename key_traits::key_t;
+
+    std::string out(binary::bigrams_magic, sizeof(binary::bigrams_magic));
+    out += static_cast<char>(binary::bigrams_version);
+    out += static_cast<char>(sizeof(Char));
+    out += static_cast<char>(std::is_signed_v<Char>);
+
+    binary::put_varint(out, bgrms.size());
+    binary::put_varint(out, std::distance(bgrms.begin(), bgrms.end()));
+
+    key_t prev = 0;
+    for (const auto & bigram_cnt: bgrms) {
+        const key_t key = key_traits::pack(std::get<0>(bigram_cnt));
+        binary::put_varint(out, key - prev);
+        binary::put_varint(out, std::get<1>(bigram_cnt));
+        prev = key;
+    }
+
+    return out;
+}
+
+
+/**
+ *  \brief  Bigrams binary deserialisation (see \c serialise_binary)
+ *
+ *  \tparam  Bigrams  Bigrams type
+ *
+ *  \param  data   Binary representation
+ *  \param  size   Binary representation size
+ *  \param  alloc  Allocator
+ *
+ *  \return Bigrams
+ */
+template <class Bigrams>
+Bigrams deserialise_binary(
+    const void * data, size_t size,
+    const typename Bigrams::allocator_type & alloc = typename Bigrams::allocator_type())
+{
+    using char_t = typename Bigrams::char_t;
+
+    const auto * ptr = static_cast<const unsigned char *>(data);
+    const auto * const end = ptr + size;
+
+    const size_t header_size = sizeof(binary::bigrams_magic) + 3;
+    if (size < header_size ||
+        0 != std::memcmp(ptr, binary::bigrams_magic, sizeof(binary::bigrams_magic)))
+        throw binary_format_error("not a bigrams binary");
+
+    ptr += sizeof(binary::bigrams_magic);
+    if (binary::bigrams_version != *ptr++)
+        throw binary_format_error("unsupported bigrams binary version");
+    if (sizeof(char_t) != *ptr++)
+        throw binary_format_error("bigrams binary character size mismatch");
+    if (std::is_signed_v<char_t> != static_cast<bool>(*ptr++))
+        throw binary_format_error("bigrams binary character signedness mismatch");
+
+    const uint64_t bgrms_size = binary::get_varint(ptr, end);
+    const uint64_t length = binary::get_varint(ptr, end);
+    if (length > static_cast<size_t>(end - ptr) / 2)  // each tuple takes 2 bytes at least
+        throw binary_format_error("truncated bigrams binary");
+
+    using decoder = binary::bigrams_decoder<char_t>;
+    auto bgrms = Bigrams(sorted_bigrams,
+        decoder(ptr, end, length), decoder(end, end, 0), alloc);
+
+    if (bgrms.size() != bgrms_size)
+        throw binary_format_error("bigrams binary size mismatch");
+
+    return bgrms;
+}
+
+}  // end of namespace libsdcxx
+
+#endif  // end of #ifndef libsdcxx__binary_hxx
@@ -0,0 +1,554 @@
+#ifndef libsdcxx__hashed_bigram_multiset_hxx
+#define libsdcxx__hashed_bigram_multiset_hxx
+
+/**
+ *  \file
+ *  \brief  String bigrams (counted open addressing hash map implementation)
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bigram_storage.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <iostream>
+
+#if defined(__SSE2__)
+#define LIBSDCXX_HASHED_SSE2 1
+#include <emmintrin.h>
+#endif
+
+
+namespace libsdcxx {
+
+/**
+ *  \brief  String Bigrams (implemented by counted open addressing hash map)
+ *
+ *  Distinct bigrams (packed to keys, see \c bigram_key) are stored in a flat hash
+ *  table together with their counts.
+ *  The table is split to groups of 16 slots, each slot having a control byte
+ *  (the slot is either empty or it holds 7 bits of the key hash).
+ *  A lookup compares the hash bits against the whole group control bytes at once
+ *  (using SSE2 if available) and only compares keys of the matching slots.
+ *  Groups are probed quadratically (triangular numbers, so that all the groups are
+ *  visited).
+ *  Bigrams are never removed, so no tombstones are necessary.
+ *
+ *  Unlike the sorted implementations, intersection size is computed by lookup
+ *  of the smaller multiset bigrams in the bigger one, i.e. in O(min(m, n)) time
+ *  (in terms of distinct bigrams).
+ *
+ *  \tparam  Char  Character type
+ */
+template <typename Char>
+class basic_hashed_bigram_multiset {
+    public:
+
+    using char_t = Char;                            /**< Character type     */
+    using string_t = std::basic_string<char_t>;     /**< String type        */
+    using bigram_t = std::tuple<char_t, char_t>;    /**< Bigram type        */
+    using key_traits = bigram_key<char_t>;          /**< Bigram key traits  */
+    using key_t = typename key_traits::key_t;       /**< Packed bigram key  */
+
+    static constexpr size_t group_size = 16;        /**< Slots per group */
+
+    private:
+
+    static constexpr std::uint8_t empty = 0x80;     /**< Empty slot control byte */
+    static constexpr size_t npos = SIZE_MAX;        /**< No slot */
+
+    std::vector<std::uint8_t>   m_ctrl;     /**< Slot control bytes     */
+    std::vector<key_t>          m_keys;     /**< Slot keys              */
+    std::vector<size_t>         m_cnts;     /**< Slot counts            */
+    size_t                      m_length;   /**< Distinct bigram count  */
+    size_t                      m_size;     /**< Individual bigram count */
+
+    /** Key hash (Fibonacci hashing, high bits are used) */
+    static std::uint64_t hash(key_t key) {
+        return static_cast<std::uint64_t>(key) * 0x9e3779b97f4a7c15ull;
+    }
+
+    /** Control byte of a hash (top 7 bits) */
+    static std::uint8_t tag(std::uint64_t h) { return static_cast<std::uint8_t>(h >> 57); }
+
+    /** Number of groups */
+    size_t groups() const { return m_ctrl.size() / group_size; }
+
+    /** 1st group to probe for hash */
+    size_t home_group(std::uint64_t h) const {
+        return static_cast<size_t>(h >> 25) & (groups() - 1);
+    }
+
+    /**
+     *  \brief  Group control bytes matching a byte
+     *
+     *  \param  group  Group control bytes
+     *  \param  byte   Control byte
+     *
+     *  \return Bit mask of the matching slots
+     */
+    static unsigned match(const std::uint8_t * group, std::uint8_t byte) {
+#if defined(LIBSDCXX_HASHED_SSE2)
+        const __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+        return static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_cmpeq_epi8(ctrl, _mm_set1_epi8(static_cast<char>(byte)))));
+#else
+        unsigned mask = 0;
+        for (size_t i = 0; i < group_size; ++i)
+            mask |= static_cast<unsigned>(group[i] == byte) << i;
+
+        return mask;
+#endif
+    }
+
+    /**
+     *  \brief  Find slot of key
+     *
+     *  \param  key  Packed bigram key
+     *
+     *  \return Slot index or \c npos if the key isn't stored
+     */
+    size_t find(key_t key) const {
+        if (0 == m_length) return npos;
+
+        const auto h = hash(key);
+        const auto key_tag = tag(h);
+        size_t group = home_group(h);
+        for (size_t step = 1; ; ++step) {
+            const size_t offset = group * group_size;
+            const std::uint8_t * ctrl = m_ctrl.data() + offset;
+
+            for (unsigned mask = match(ctrl, key_tag); mask; mask &= mask - 1) {
+                const size_t slot = offset + __builtin_ctz(mask);
+                if (m_keys[slot] == key) return slot;
+            }
+
+            if (match(ctrl, empty)) return npos;  // the key would be in this group
+
+            group = (group + step) & (groups() - 1);
+        }
+    }
+
+    /**
+     *  \brief  Add bigram(s) (no table growth)
+     *
+     *  There must be a free slot in the table.
+     *
+     *  \param  key  Packed bigram key
+     *  \param  cnt  Bigram count
+     */
+    void emplace(key_t key, size_t cnt) {
+        const auto h = hash(key);
+        const auto key_tag = tag(h);
+        size_t group = home_group(h);
+        for (size_t step = 1; ; ++step) {
+            const size_t offset = group * group_size;
+            std::uint8_t * ctrl = m_ctrl.data() + offset;
+
+            for (unsigned mask = match(ctrl, key_tag); mask; mask &= mask - 1) {
+                const size_t slot = offset + __builtin_ctz(mask);
+                if (m_keys[slot] == key) {  // bigram(s) already present
+                    m_cnts[slot] += cnt;
+                    return;
+                }
+            }
+
+            const unsigned free = match(ctrl, empty);
+            if (free) {  // new bigram
+                const size_t slot = offset + __builtin_ctz(free);
+                m_ctrl[slot] = key_tag;
+                m_keys[slot] = key;
+                m_cnts[slot] = cnt;
+                ++m_length;
+                return;
+            }
+
+            group = (group + step) & (groups() - 1);
+        }
+    }
+
+    /**
+     *  \brief  Rehash to a bigger table
+     *
+     *  \param  capacity  New capacity (power of 2, at least \c group_size)
+     */
+    void rehash(size_t capacity) {
+        basic_hashed_bigram_multiset table;
+        table.m_ctrl.assign(capacity, empty);
+        table.m_keys.resize(capacity);
+        table.m_cnts.resize(capacity);
+
+        for (size_t slot = 0; slot < m_ctrl.size(); ++slot)
+            if (empty != m_ctrl[slot])
+                table.emplace(m_keys[slot], m_cnts[slot]);
+
+        table.m_size = m_size;
+        *this = std::move(table);
+    }
+
+    /**
+     *  \brief  Make sure the table may hold enough distinct bigrams
+     *
+     *  Max. load factor is 7/8 (there's always a free slot).
+     *
+     *  \param  length  Number of distinct bigrams
+     */
+    void reserve(size_t length) {
+        if (length * 8 <= m_ctrl.size() * 7) return;
+
+        size_t capacity = std::max<size_t>(group_size, m_ctrl.size());
+        while (length * 8 > capacity * 7) capacity *= 2;
+        rehash(capacity);
+    }
+
+    /**
+     *  \brief  Add bigram(s)
+     *
+     *  \param  key  Packed bigram key
+     *  \param  cnt  Bigram count
+     */
+    void add(key_t key, size_t cnt) {
+        reserve(m_length + 1);
+        emplace(key, cnt);
+        m_size += cnt;
+    }
+
+    public:
+
+    /** Const. iterator (produces bigrams, each as many times as it's in the multiset) */
+    class const_iterator {
+        friend class basic_hashed_bigram_multiset;
+
+        public:
+
+        using iterator_category = std::forward_iterator_tag;    /**< Category   */
+        using value_type = bigram_t;                            /**< Value      */
+        using difference_type = std::ptrdiff_t;                 /**< Difference */
+        using pointer = void;                                   /**< Pointer    */
+        using reference = bigram_t;                             /**< Reference  */
+
+        private:
+
+        const basic_hashed_bigram_multiset * m_bgrms;   /**< Bigrams            */
+        size_t m_slot;                                  /**< Slot index         */
+        size_t m_rep;                                   /**< Bigram repetition  */
+
+        const_iterator(const basic_hashed_bigram_multiset * bgrms, size_t slot):
+            m_bgrms(bgrms), m_slot(slot), m_rep(0)
+        {
+            skip_empty();
+        }
+
+        /** Shift to next non-empty slot (unless at a non-empty one) */
+        void skip_empty() {
+            const auto & ctrl = m_bgrms->m_ctrl;
+            while (m_slot < ctrl.size() && empty == ctrl[m_slot]) ++m_slot;
+        }
+
+        public:
+
+        /** Default constructor (singular iterator) */
+        const_iterator(): m_bgrms(nullptr), m_slot(0), m_rep(0) {}
+
+        /** Dereference */
+        bigram_t operator * () const { return key_traits::unpack(m_bgrms->m_keys[m_slot]); }
+
+        /** Pre-increment */
+        const_iterator & operator ++ () {
+            if (++m_rep < m_bgrms->m_cnts[m_slot]) return *this;
+
+            m_rep = 0;
+            ++m_slot;
+            skip_empty();
+            return *this;
+        }
+
+        /** Post-increment */
+        const_iterator operator ++ (int) {
+            const_iterator orig(*this);
+            ++*this;
+            return orig;
+        }
+
+        /** Comparison (eq) */
+        bool operator == (const const_iterator & other) const {
+            return m_slot == other.m_slot && m_rep == other.m_rep;
+        }
+
+        /** Comparison (ne) */
+        bool operator != (const const_iterator & other) const { return !(*this == other); }
+
+    };  // end of class const_iterator
+
+    /** Empty bigram multiset constructor */
+    basic_hashed_bigram_multiset(): m_length(0), m_size(0) {}
+
+    /**
+     *  \brief  Constructor (from a string)
+     *
+     *  \param  str  Bigrams source
+     */
+    basic_hashed_bigram_multiset(const std::basic_string<char_t> & str):
+        m_length(0), m_size(0)
+    {
+        if (str.size() < 2) return;  // there must be at least 2 characters for bigrams
+
+        reserve(str.size() - 1);
+        for (size_t i = 1; i < str.size(); ++i)
+            emplace(key_traits::pack(str[i-1], str[i]), 1);
+
+        m_size = str.size() - 1;
+    }
+
+    /** Copy constructor */
+    basic_hashed_bigram_multiset(const basic_hashed_bigram_multiset & ) = default;
+
+    /** Move constructor */
+    basic_hashed_bigram_multiset(basic_hashed_bigram_multiset && ) = default;
+
+    /** Copy assignment */
+    basic_hashed_bigram_multiset & operator = (const basic_hashed_bigram_multiset & ) = default;
+
+    /** Move assignment */
+    basic_hashed_bigram_multiset & operator = (basic_hashed_bigram_multiset && ) = default;
+
+    /**
+     *  \brief  Size getter
+     *
+     *  \return Number of bigrams
+     */
+    size_t size() const { return m_size; }
+
+    /** Number of distinct bigrams */
+    size_t length() const { return m_length; }
+
+    /**
+     *  \brief  Bigram count
+     *
+     *  \param  bigram  Bigram
+     *
+     *  \return Number of the bigram occurrences
+     */
+    size_t count(const bigram_t & bigram) const {
+        const size_t slot = find(key_traits::pack(bigram));
+        return npos == slot ? 0 : m_cnts[slot];
+    }
+
+    /** \brief  Begin const. iterator getter */
+    const_iterator cbegin() const { return const_iterator(this, 0); }
+
+    /** \brief  End const. iterator getter */
+    const_iterator cend() const { return const_iterator(this, m_ctrl.size()); }
+
+    /** \brief  Begin iterator getter */
+    const_iterator begin() const { return cbegin(); }
+
+    /** \brief  End iterator getter */
+    const_iterator end() const { return cend(); }
+
+    /**
+     *  \brief  Update current bigram multiset by other bigrams
+     *
+     *  \param  other  Other bigrams
+     */
+    basic_hashed_bigram_multiset & operator += (const basic_hashed_bigram_multiset & other) {
+        if (size() == 0)  // optimisation for empty multiset
+            return *this = other;
+
+        reserve(m_length + other.m_length);  // upper bound, no rehashing in the loop
+        for (size_t slot = 0; slot < other.m_ctrl.size(); ++slot)
+            if (empty != other.m_ctrl[slot])
+                emplace(other.m_keys[slot], other.m_cnts[slot]);
+
+        m_size += other.m_size;
+
+        return *this;
+    }
+
+    private:
+
+    /** Union of bigram multisets (fixed point of template recursion) */
+    static basic_hashed_bigram_multiset unite(const basic_hashed_bigram_multiset & arg) {
+        return arg;  // make a copy
+    }
+
+    public:
+
+    /**
+     *  \brief  Union of bigram multisets
+     *
+     *  \param  arg1  Bigram multiset
+     *  \param  args  Bigram multisets
+     *
+     *  \return Union of bigrams
+     */
+    template <class ... Bigrams>
+    static basic_hashed_bigram_multiset unite(
+        const basic_hashed_bigram_multiset & arg1,
+        const Bigrams & ... args)
+    {
+        return unite(args...) += arg1;
+    }
+
+    /**
+     *  \brief  Union of 2 bigram multisets
+     *
+     *  The bigger multiset is copied and updated by the smaller one.
+     *
+     *  \param  other  Bigram multiset
+     *
+     *  \return Union of bigram multisets
+     */
+    basic_hashed_bigram_multiset operator + (const basic_hashed_bigram_multiset & other) const {
+        if (m_length < other.m_length)
+            return basic_hashed_bigram_multiset(other) += *this;
+
+        return basic_hashed_bigram_multiset(*this) += other;
+    }
+
+    /**
+     *  \brief  Bigram multisets intersection size
+     *
+     *  The smaller multiset bigrams are looked up in the bigger one.
+     *
+     *  \param  bigrams1  Bigram multiset
+     *  \param  bigrams2  Bigram multiset
+     *
+     *  \return Size of the bigram multisets intersection
+     */
+    static size_t intersect_size(
+        const basic_hashed_bigram_multiset & bigrams1,
+        const basic_hashed_bigram_multiset & bigrams2)
+    {
+        if (bigrams2.m_length < bigrams1.m_length)
+            return intersect_size(bigrams2, bigrams1);
+
+        size_t size = 0;
+        for (size_t slot = 0; slot < bigrams1.m_ctrl.size(); ++slot) {
+            if (empty == bigrams1.m_ctrl[slot]) continue;
+
+            const size_t slot2 = bigrams2.find(bigrams1.m_keys[slot]);
+            if (npos != slot2)
+                size += std::min(bigrams1.m_cnts[slot], bigrams2.m_cnts[slot2]);
+        }
+
+        return size;
+    }
+
+    /**
+     *  \brief  Bigram multisets Sørensen–Dice coefficient
+     *
+     *  Note that SDC of bigram multisets with empty intersection is 0
+     *  (see \c basic_bigrams::sorensen_dice_coef).
+     *
+     *  \param  bigrams1  Bigram multiset
+     *  \param  bigrams2  Bigram multiset
+     *
+     *  \return Sørensen–Dice coefficient
+     */
+    static double sorensen_dice_coef(
+        const basic_hashed_bigram_multiset & bigrams1,
+        const basic_hashed_bigram_multiset & bigrams2)
+    {
+        const auto isect_size = intersect_size(bigrams1, bigrams2);
+        return isect_size ? 2.0 * isect_size / (bigrams1.size() + bigrams2.size()) : 0.0;
+    }
+
+};  // end of template class basic_hashed_bigram_multiset
+
+
+/**
+ *  \brief  (Wide) hashed bigram multiset serialisation
+ *
+ *  \tparam  Char  Character type
+ *
+ *  \param  out    Output stream
+ *  \param  bgrms  Bigram multiset
+ *  \param  name   Bigram multiset class (display) name
+ *
+ *  \return \c out
+ */
+template <typename Char>
+std::basic_ostream<Char> & serialise_hashed_bigram_multiset (
+    std::basic_ostream<Char> & out,
+    const basic_hashed_bigram_multiset<Char> & bgrms,
+    const char * name)
+{
+    static const auto * left_curly_bracket = "{";
+
+    out << name << "(size: " << bgrms.size() << ", ";
+
+    const auto * separator = left_curly_bracket;
+    for (const auto & bigram: bgrms) {
+        out << separator << std::get<0>(bigram) << std::get<1>(bigram);
+        separator = ", ";
+    }
+    out << (separator == left_curly_bracket ? "{}" : "}") << ')';
+
+    return out;
+}
+
+
+/**< ASCII/ANSI string hashed bigram multisets */
+using hashed_bigram_multiset = basic_hashed_bigram_multiset<char>;
+
+/**< UNICODE string hashed bigram multisets */
+using hashed_wbigram_multiset = basic_hashed_bigram_multiset<wchar_t>;
+
+
+/** Hashed bigram multiset serialisation operator */
+inline std::ostream & operator << (
+    std::ostream & out, const hashed_bigram_multiset & bgrms)
+{
+    return serialise_hashed_bigram_multiset(out, bgrms, "hashed_bigram_multiset");
+}
+
+/** Hashed wide bigram multiset serialisation operator */
+inline std::wostream & operator << (
+    std::wostream & out, const hashed_wbigram_multiset & bgrms)
+{
+    return serialise_hashed_bigram_multiset(out, bgrms, "hashed_wbigram_multiset");
+}
+
+}  // end of namespace libsdcxx
+
+#endif  // end of #ifndef libsdcxx__hashed_bigram_multiset_hxx
@@ -0,0 +1,383 @@
+#ifndef libsdcxx__parallel_matcher_hxx
+#define libsdcxx__parallel_matcher_hxx
+
+/**
+ *  \file
+ *  \brief  Parallel (multi-threaded) sequence matching of a corpus
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sequence_matcher.hxx"
+#include "pattern_set.hxx"
+
+#include <cstddef>
+#include <cassert>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <exception>
+#include <system_error>
+#include <iterator>
+#include <type_traits>
+#include <algorithm>
+
+
+namespace libsdcxx {
+
+/**
+ *  \brief  Corpus match record (see \c basic_parallel_matcher::match_all)
+ */
+struct corpus_match {
+    size_t sequence;        /**< Sequence index in the corpus   */
+    sequence_match match;   /**< Match in the sequence          */
+};
+
+
+/**
+ *  \brief  Parallel corpus matcher
+ *
+ *  Matches a pattern set to a corpus of token sequences (sentences) using
+ *  a set of workers.
+ *  Each worker owns a sequence matcher (and therefore its arena), which is
+ *  re-used for all the sequences it processes (also across \c match_all calls).
+ *  The workers are run by threads started for each \c match_all call (the calling
+ *  thread runs one of them), so a call should have enough work to pay for that.
+ *
+ *  The corpus is split into chunks of adjacent sequences, dealt to the workers'
+ *  queues in contiguous blocks.
+ *  A worker takes chunks from the front of its own queue; once it's empty,
+ *  it steals from the back of the other workers' queues.
+ *  As no new work appears during the run, a worker finding all the queues empty
+ *  is done.
+ *
+ *  Each worker writes the matches to its own buffer, recording which chunk they
+ *  belong to; the buffers are merged by chunk at the end.
+ *  The result is therefore deterministic: the same as if the sequences were
+ *  matched one by one (in corpus order), regardless of the scheduling.
+ *
+ *  A single \c match_all call must not run concurrently with another one
+ *  on the same object.
+ *
+ *  \tparam  Matcher  Sequence matcher type
+ */
+template <class Matcher>
+class basic_parallel_matcher {
+    public:
+
+    using matcher_t = Matcher;                          /**< Sequence matcher   */
+    using bigrams_t = typename matcher_t::bigrams_t;    /**< Bigrams type       */
+
+    /** Pattern set type */
+    using pattern_set_t = basic_pattern_set<typename bigrams_t::char_t>;
+
+    private:
+
+    /** Worker matches of a chunk */
+    struct span {
+        size_t chunk;   /**< Chunk index                    */
+        size_t begin;   /**< Matches begin in the buffer    */
+        size_t end;     /**< Matches end in the buffer      */
+    };
+
+    /** Worker */
+    struct worker {
+        matcher_t matcher;                  /**< Sequence matcher (re-used)     */
+        std::mutex mutex;                   /**< Chunk queue mutex              */
+        std::deque<size_t> chunks;          /**< Chunk queue                    */
+        std::vector<corpus_match> matches;  /**< Matches buffer                 */
+        std::vector<span> spans;            /**< Chunk spans in the buffer      */
+        std::exception_ptr error;           /**< Exception thrown (if any)      */
+    };
+
+    std::vector<std::unique_ptr<worker>> m_workers;  /**< Workers */
+
+    /**
+     *  \brief  Take chunk (own queue front or someone else's back)
+     *
+     *  \param  w      Worker index
+     *  \param  chunk  Chunk index (set if taken)
+     *
+     *  \return \c true iff a chunk was taken
+     */
+    bool take(size_t w, size_t & chunk) {
+        const size_t wcnt = m_workers.size();
+        for (size_t v = 0; v < wcnt; ++v) {
+            auto & victim = *m_workers[(w + v) % wcnt];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+
+            if (victim.chunks.empty()) continue;
+
+            if (0 == v) {  // own queue
+                chunk = victim.chunks.front();
+                victim.chunks.pop_front();
+            }
+            else {  // steal
+                chunk = victim.chunks.back();
+                victim.chunks.pop_back();
+            }
+
+            return true;
+        }
+
+        return false;
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  threads  Number of worker threads (0 means hardware concurrency)
+     */
+    explicit basic_parallel_matcher(size_t threads = 0) {
+        if (0 == threads) threads = std::thread::hardware_concurrency();
+        if (0 == threads) threads = 1;  // unknown
+
+        m_workers.reserve(threads);
+        for (size_t w = 0; w < threads; ++w)
+            m_workers.push_back(std::make_unique<worker>());
+    }
+
+    /** Number of worker threads */
+    size_t threads() const { return m_workers.size(); }
+
+    /**
+     *  \brief  Set workers' cell cache budget (see \c basic_sequence_matcher::cache_budget)
+     *
+     *  \param  bytes  Max. number of bytes of cached unions per worker
+     */
+    void cache_budget(size_t bytes) {
+        for (auto & wrkr: m_workers) wrkr->matcher.cache_budget(bytes);
+    }
+
+    /**
+     *  \brief  Match multiple patterns to a corpus
+     *
+     *  The sequences may be any ranges of tokens accepted by
+     *  \c basic_sequence_matcher::assign.
+     *  If a worker throws, the exception is re-thrown (once all the workers
+     *  are finished).
+     *
+     *  \param  corpus     Range of token sequences (random access)
+     *  \param  patterns   Range of pattern bigram multisets or frozen pattern set
+     *  \param  threshold  Sørensen-Dice coefficient (match score) threshold (positive)
+     *  \param  grain      Number of sequences per chunk (0 means automatic)
+     *
+     *  \return Matches ordered by sequence index, then as \c match_all orders them
+     */
+    template <class Corpus, class Patterns>
+    std::vector<corpus_match> match_all(
+        const Corpus & corpus,
+        const Patterns & patterns,
+        double threshold,
+        size_t grain = 0)
+    {
+        const size_t seq_cnt = std::size(corpus);
+        const size_t wcnt = m_workers.size();
+
+        // Frozen pattern sets are matched directly
+        constexpr bool frozen = std::is_same_v<Patterns, pattern_set_t>;
+
+        // Other patterns are sorted by size once for all the sequences
+        std::vector<const bigrams_t *> pttrns;
+        std::vector<size_t> order, pttrn_sizes;
+        if constexpr (!frozen) {
+            for (const auto & pattern: patterns) pttrns.push_back(&pattern);
+            matcher_t::sort_by_size(pttrns.data(), pttrns.size(), order, pttrn_sizes);
+        }
+
+        // Cut the corpus to chunks (a few per worker, so that there's something to steal)
+        if (0 == grain) grain = std::max<size_t>(1, seq_cnt / (8 * wcnt));
+        const size_t chunk_cnt = (seq_cnt + grain - 1) / grain;
+
+        for (size_t w = 0; w < wcnt; ++w) {
+            auto & wrkr = *m_workers[w];
+            wrkr.chunks.clear();
+            wrkr.matches.clear();
+            wrkr.spans.clear();
+            wrkr.error = nullptr;
+
+            const size_t chunks_begin = chunk_cnt * w / wcnt;
+            const size_t chunks_end = chunk_cnt * (w + 1) / wcnt;
+            for (size_t chunk = chunks_begin; chunk < chunks_end; ++chunk)
+                wrkr.chunks.push_back(chunk);
+        }
+
+        // Run the workers
+        const auto run = [&](size_t w) {
+            auto & wrkr = *m_workers[w];
+            try {
+                size_t chunk;
+                while (take(w, chunk)) {
+                    const size_t begin = wrkr.matches.size();
+                    const size_t seq_end = std::min(seq_cnt, (chunk + 1) * grain);
+
+                    for (size_t seq = chunk * grain; seq < seq_end; ++seq) {
+                        const auto & sequence = std::begin(corpus)[seq];
+                        wrkr.matcher.assign(std::begin(sequence), std::end(sequence));
+                        const auto sink = [&wrkr, seq](const sequence_match & match) {
+                            wrkr.matches.push_back(corpus_match{seq, match});
+                        };
+
+                        if constexpr (frozen)
+                            wrkr.matcher.match_all(patterns, threshold, sink);
+                        else
+                            wrkr.matcher.match_all(pttrns.data(),
+                                order.data(), pttrn_sizes.data(), pttrns.size(),
+                                threshold, sink);
+                    }
+
+                    wrkr.spans.push_back(span{chunk, begin, wrkr.matches.size()});
+                }
+            }
+            catch (...) {
+                wrkr.error = std::current_exception();
+            }
+        };
+
+        // Should a thread fail to start, the others steal its chunks
+        std::vector<std::thread> threads;
+        threads.reserve(wcnt - 1);
+        try {
+            for (size_t w = 1; w < wcnt; ++w) threads.emplace_back(run, w);
+        }
+        catch (const std::system_error & ) {}
+
+        run(0);  // the calling thread is a worker, too
+        for (auto & thread: threads) thread.join();
+
+        for (const auto & wrkr: m_workers)
+            if (wrkr->error) std::rethrow_exception(wrkr->error);
+
+        // Merge the workers' buffers by chunk
+        std::vector<const corpus_match *> chunk_begin(chunk_cnt, nullptr);
+        std::vector<const corpus_match *> chunk_end(chunk_cnt, nullptr);
+        size_t match_cnt = 0;
+        for (const auto & wrkr: m_workers) {
+            for (const auto & sp: wrkr->spans) {
+                chunk_begin[sp.chunk] = wrkr->matches.data() + sp.begin;
+                chunk_end[sp.chunk] = wrkr->matches.data() + sp.end;
+            }
+            match_cnt += wrkr->matches.size();
+        }
+
+        std::vector<corpus_match> matches;
+        matches.reserve(match_cnt);
+        for (size_t chunk = 0; chunk < chunk_cnt; ++chunk)
+            matches.insert(matches.end(), chunk_begin[chunk], chunk_end[chunk]);
+
+        return matches;
+    }
+
+};  // end of template class basic_parallel_matcher
+
+
+/** ASCII/ANSI string parallel matcher */
+using parallel_matcher = basic_parallel_matcher<sequence_matcher>;
+
+/** UNICODE string parallel matcher */
+using wparallel_matcher = basic_parallel_matcher<wsequence_matcher>;
+
+/** ASCII/ANSI string parallel matcher (flat bigrams storage) */
+using flat_parallel_matcher = basic_parallel_matcher<flat_sequence_matcher>;
+
+/** UNICODE string parallel matcher (flat bigrams storage) */
+using wflat_parallel_matcher = basic_parallel_matcher<wflat_sequence_matcher>;
+
+
+/**
+ *  \brief  Parallel union of a range of bigrams
+ *
+ *  The range is split to contiguous blocks which are united (see the range
+ *  \c basic_bigrams::unite) by worker threads; the partial unions are then united
+ *  by the calling thread.
+ *  Only pays off for many multisets; if there are less than \c min_block multisets
+ *  per thread, fewer threads are used (down to a serial union).
+ *
+ *  \tparam  Bigrams  Bigrams type
+ *  \tparam  Iter     Random access iterator of bigrams (or pointers to bigrams)
+ *
+ *  \param  begin      Range begin
+ *  \param  end        Range end
+ *  \param  threads    Number of threads (0 means hardware concurrency)
+ *  \param  min_block  Minimal number of multisets per thread
+ *
+ *  \return Union of bigrams
+ */
+template <class Bigrams, class Iter>
+Bigrams parallel_unite(Iter begin, Iter end, size_t threads = 0, size_t min_block = 64) {
+    const size_t cnt = std::distance(begin, end);
+
+    if (0 == threads) threads = std::thread::hardware_concurrency();
+    threads = std::min(threads, cnt / std::max(min_block, size_t(1)));
+    if (threads <= 1) return Bigrams::unite(begin, end);
+
+    std::vector<Bigrams> partials(threads);
+    std::vector<std::exception_ptr> errors(threads);
+    const auto run = [&](size_t t) {
+        try {
+            partials[t] = Bigrams::unite(
+                begin + cnt * t / threads, begin + cnt * (t + 1) / threads);
+        }
+        catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+
+    // Should a thread fail to start, the calling thread unites its block
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    try {
+        for (size_t t = 1; t < threads; ++t) workers.emplace_back(run, t);
+    }
+    catch (const std::system_error & ) {}
+
+    for (size_t t = workers.size() + 1; t < threads; ++t) run(t);
+    run(0);
+    for (auto & worker: workers) worker.join();
+
+    for (const auto & error: errors)
+        if (error) std::rethrow_exception(error);
+
+    return Bigrams::unite(partials.cbegin(), partials.cend());
+}
+
+}  // end of namespace libsdcxx
+
+#endif  // end of #ifndef libsdcxx__parallel_matcher_hxx
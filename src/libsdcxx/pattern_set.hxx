@@ -0,0 +1,747 @@
+#ifndef libsdcxx__pattern_set_hxx
+#define libsdcxx__pattern_set_hxx
+
+/**
+ *  \file
+ *  \brief  Frozen (read-only, thread-safe) pattern set
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bigrams.hxx"
+#include "bigram_storage.hxx"
+#include "bigram_index.hxx"
+#include "simd_intersect.hxx"
+#include "binary.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <cassert>
+#include <new>
+#include <string>
+#include <fstream>
+#include <ostream>
+#include <system_error>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+namespace libsdcxx {
+
+/**
+ *  \brief  Bigram multiset view
+ *
+ *  Non-owning view of a bigram multiset stored as sorted packed keys and counts
+ *  (like \c flat_bigram_storage does); see \c basic_pattern_set.
+ *
+ *  \tparam  Char  Character type
+ */
+template <typename Char>
+class basic_bigrams_view {
+    public:
+
+    using char_t = Char;                                /**< Character type         */
+    using bigram_t = std::tuple<char_t, char_t>;        /**< Bigram type            */
+    using bigram_cnt_t = std::tuple<bigram_t, size_t>;  /**< [Bigram, count] tuple  */
+    using key_traits = bigram_key<char_t>;              /**< Bigram key traits      */
+    using key_t = typename key_traits::key_t;           /**< Packed bigram key      */
+
+    private:
+
+    const key_t * m_keys;   /**< Sorted packed keys         */
+    const size_t * m_cnts;  /**< Bigram counts              */
+    size_t m_length;        /**< Number of distinct bigrams */
+    size_t m_size;          /**< Individual bigram count    */
+
+    public:
+
+    /** Const. iterator (produces [bigram, count] tuples by value) */
+    class const_iterator {
+        friend class basic_bigrams_view;
+
+        public:
+
+        using iterator_category = std::forward_iterator_tag;    /**< Category   */
+        using value_type = bigram_cnt_t;                        /**< Value      */
+        using difference_type = std::ptrdiff_t;                 /**< Difference */
+        using pointer = void;                                   /**< Pointer    */
+        using reference = bigram_cnt_t;                         /**< Reference  */
+
+        private:
+
+        const key_t * m_key;    /**< Key pointer    */
+        const size_t * m_cnt;   /**< Count pointer  */
+
+        const_iterator(const key_t * key, const size_t * cnt): m_key(key), m_cnt(cnt) {}
+
+        public:
+
+        /** Dereference */
+        bigram_cnt_t operator * () const {
+            return bigram_cnt_t(key_traits::unpack(*m_key), *m_cnt);
+        }
+
+        /** Pre-increment */
+        const_iterator & operator ++ () {
+            ++m_key;
+            ++m_cnt;
+            return *this;
+        }
+
+        /** Post-increment */
+        const_iterator operator ++ (int) {
+            const_iterator orig(*this);
+            ++*this;
+            return orig;
+        }
+
+        /** Comparison (eq) */
+        bool operator == (const const_iterator & other) const {
+            return m_key == other.m_key;
+        }
+
+        /** Comparison (ne) */
+        bool operator != (const const_iterator & other) const { return !(*this == other); }
+
+    };  // end of class const_iterator
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  keys    Sorted packed keys
+     *  \param  cnts    Bigram counts
+     *  \param  length  Number of distinct bigrams
+     *  \param  size    Individual bigram count
+     */
+    basic_bigrams_view(const key_t * keys, const size_t * cnts, size_t length, size_t size):
+        m_keys(keys), m_cnts(cnts), m_length(length), m_size(size)
+    {}
+
+    /** Number of bigrams */
+    size_t size() const { return m_size; }
+
+    /** Number of distinct bigrams */
+    size_t length() const { return m_length; }
+
+    /** Packed keys */
+    const key_t * keys() const { return m_keys; }
+
+    /** Counts */
+    const size_t * counts() const { return m_cnts; }
+
+    /** \brief  Begin const. iterator getter */
+    const_iterator begin() const { return const_iterator(m_keys, m_cnts); }
+
+    /** \brief  End const. iterator getter */
+    const_iterator end() const { return const_iterator(m_keys + m_length, m_cnts + m_length); }
+
+    private:
+
+    /** Storage exposes flat keys & counts arrays */
+    template <class Storage, class = void>
+    struct is_flat: std::false_type {};
+
+    template <class Storage>
+    struct is_flat<Storage, std::void_t<decltype(std::declval<const Storage &>().keys())>>:
+        std::true_type {};
+
+    public:
+
+    /**
+     *  \brief  Intersection size with bigram multiset
+     *
+     *  Flat storages use the SIMD kernels (see \c simd_intersect.hxx),
+     *  other storages are merged bigram by bigram.
+     *
+     *  \param  bgrms  Bigram multiset
+     *  \param  view   Bigrams view
+     *
+     *  \return Size of the bigram multisets intersection
+     */
+    template <class Storage>
+    static size_t intersect_size(
+        const basic_bigrams<char_t, Storage> & bgrms,
+        const basic_bigrams_view & view)
+    {
+        if constexpr (is_flat<Storage>::value) {
+            const auto & storage = bgrms.storage();
+            return simd::intersect_size(
+                storage.keys(), storage.counts(), storage.length(),
+                view.keys(), view.counts(), view.length());
+        }
+        else {
+            size_t size = 0;
+            size_t i = 0;
+            for (const auto & bigram_cnt: bgrms) {
+                const key_t key = key_traits::pack(std::get<0>(bigram_cnt));
+                while (i < view.length() && view.keys()[i] < key) ++i;
+                if (i == view.length()) break;
+                if (view.keys()[i] == key)
+                    size += std::min(std::get<1>(bigram_cnt), view.counts()[i]);
+            }
+
+            return size;
+        }
+    }
+
+    /**
+     *  \brief  Sørensen–Dice coefficient with bigram multiset
+     *
+     *  Computed just like \c basic_bigrams::sorensen_dice_coef.
+     *
+     *  \param  bgrms  Bigram multiset
+     *  \param  view   Bigrams view
+     *
+     *  \return Sørensen–Dice coefficient
+     */
+    template <class Storage>
+    static double sorensen_dice_coef(
+        const basic_bigrams<char_t, Storage> & bgrms,
+        const basic_bigrams_view & view)
+    {
+        const auto isect_size = intersect_size(bgrms, view);
+        return isect_size ? 2.0 * isect_size / (bgrms.size() + view.size()) : 0.0;
+    }
+
+};  // end of template class basic_bigrams_view
+
+
+/**
+ *  \brief  Frozen pattern set
+ *
+ *  Pattern bigram multisets built once and frozen into a single compact read-only
+ *  blob (cache line aligned sections of sorted packed keys, counts, offsets,
+ *  sizes and the size order of patterns used for cardinality pruning).
+ *  Patterns are accessed via \c basic_bigrams_view (no copies).
+ *
+ *  Optionally, an inverted bigram index of the patterns is built, too
+ *  (see \c basic_bigram_index; entry IDs are the pattern indices).
+ *
+ *  The set is immutable: any number of threads may use it concurrently
+ *  with no locking (there's no reference counting either).
+ *  It's movable, but not copyable.
+ *
+ *  \tparam  Char  Character type
+ */
+template <typename Char>
+class basic_pattern_set {
+    public:
+
+    using char_t = Char;                                /**< Character type     */
+    using view_t = basic_bigrams_view<char_t>;          /**< Bigrams view       */
+    using key_t = typename view_t::key_t;               /**< Packed bigram key  */
+    using index_t = basic_bigram_index<char_t>;         /**< Inverted index     */
+
+    static constexpr size_t alignment = 64;             /**< Sections alignment */
+
+    static constexpr uint32_t file_version = 2;         /**< File format version */
+
+    /** Indexing (of patterns) */
+    enum indexing_t {
+        NO_INDEX = 0,   /**< Don't build inverted index  */
+        INDEX,          /**< Build inverted index        */
+    };
+
+    private:
+
+    /** Storage deleter (the storage is either allocated, file-mapped or borrowed) */
+    struct storage_deleter {
+        enum kind_t {
+            ALLOCATED = 0,  /**< Allocated (aligned)    */
+            MAPPED,         /**< File mapping           */
+            BORROWED,       /**< Not owned              */
+        };
+
+        kind_t kind = ALLOCATED;    /**< Storage kind                   */
+        size_t size = 0;            /**< Storage size (of mapping)      */
+
+        void operator () (std::byte * storage) const {
+            switch (kind) {
+                case ALLOCATED:
+                    ::operator delete(storage, std::align_val_t(alignment));
+                    break;
+
+                case MAPPED:
+                    unmap_file(storage, size);
+                    break;
+
+                case BORROWED:
+                    break;
+            }
+        }
+    };
+
+    using storage_t = std::unique_ptr<std::byte[], storage_deleter>;
+
+    /** Blob sections layout (offsets) */
+    struct layout_t {
+        size_t sizes;           /**< Pattern sizes section offset           */
+        size_t offsets;         /**< Pattern offsets section offset         */
+        size_t order;           /**< Size order section offset              */
+        size_t sorted_sizes;    /**< Sorted pattern sizes section offset    */
+        size_t keys;            /**< Keys section offset                    */
+        size_t cnts;            /**< Counts section offset                  */
+        size_t size;            /**< Blob size                              */
+
+        layout_t(size_t pattern_cnt, size_t key_cnt) {
+            sizes = 0;
+            offsets = sizes + section(pattern_cnt * sizeof(size_t));
+            order = offsets + section((pattern_cnt + 1) * sizeof(size_t));
+            sorted_sizes = order + section(pattern_cnt * sizeof(size_t));
+            keys = sorted_sizes + section(pattern_cnt * sizeof(size_t));
+            cnts = keys + section(key_cnt * sizeof(key_t));
+            size = cnts + section(key_cnt * sizeof(size_t));
+        }
+    };
+
+    /**
+     *  \brief  File header
+     *
+     *  The file is the header (padded to \c alignment bytes) followed by the blob.
+     *  The blob is stored as is (native byte order, integer sizes and character
+     *  signedness, which the packed keys depend on, are recorded in the header
+     *  and checked on load).
+     */
+    struct file_header {
+        char magic[8];          /**< File magic                             */
+        uint32_t version;       /**< File format version                    */
+        uint32_t byte_order;    /**< Byte order mark (native 0x01020304)    */
+        uint32_t char_size;     /**< Character size                         */
+        uint32_t key_size;      /**< Packed bigram key size                 */
+        uint32_t size_size;     /**< \c size_t size                         */
+        uint32_t char_signed;   /**< Character signedness (keys sign bias)  */
+        uint64_t pattern_cnt;   /**< Number of patterns                     */
+        uint64_t key_cnt;       /**< Number of keys                         */
+        uint64_t blob_size;     /**< Blob size                              */
+    };
+
+    static_assert(sizeof(file_header) <= alignment, "File header must fit alignment");
+
+    static constexpr char file_magic[8] = { 'S', 'D', 'C', 'X', 'X', 'P', 'S', '\0' };
+
+    storage_t m_storage;            /**< Blob storage (owned)                   */
+    const std::byte * m_blob;       /**< Blob                                   */
+    size_t m_blob_size;             /**< Blob size                              */
+    size_t m_size;                  /**< Number of patterns                     */
+    size_t m_key_cnt;               /**< Number of keys                         */
+    const size_t * m_sizes;         /**< Pattern sizes                          */
+    const size_t * m_offsets;       /**< Pattern offsets to keys & counts       */
+    const size_t * m_order;         /**< Patterns ordered by size               */
+    const size_t * m_sorted_sizes;  /**< Pattern sizes in size order            */
+    const key_t * m_keys;           /**< Packed keys (sorted per pattern)       */
+    const size_t * m_cnts;          /**< Bigram counts                          */
+    std::optional<index_t> m_index; /**< Inverted index (optional)              */
+
+    /** Section size (aligned) */
+    static size_t section(size_t bytes) {
+        return (bytes + alignment - 1) / alignment * alignment;
+    }
+
+    /** Set section pointers */
+    void set_sections(const std::byte * blob, const layout_t & layout) {
+        m_sizes = reinterpret_cast<const size_t *>(blob + layout.sizes);
+        m_offsets = reinterpret_cast<const size_t *>(blob + layout.offsets);
+        m_order = reinterpret_cast<const size_t *>(blob + layout.order);
+        m_sorted_sizes = reinterpret_cast<const size_t *>(blob + layout.sorted_sizes);
+        m_keys = reinterpret_cast<const key_t *>(blob + layout.keys);
+        m_cnts = reinterpret_cast<const size_t *>(blob + layout.cnts);
+    }
+
+    /** Build the inverted index */
+    void build_index() {
+        m_index.emplace();
+        m_index->reserve(m_size);
+        for (size_t p = 0; p < m_size; ++p) m_index->insert(pattern(p));
+    }
+
+    /** Unmap file mapping */
+    static void unmap_file(void * map, size_t map_size) {
+#if defined(__unix__) || defined(__APPLE__)
+        ::munmap(map, map_size);
+#else
+        (void)map; (void)map_size;
+#endif
+    }
+
+    /** Allocate aligned storage */
+    static storage_t allocate(size_t size) {
+        auto storage = static_cast<std::byte *>(
+            ::operator new(std::max(size, alignment), std::align_val_t(alignment)));
+
+        return storage_t(storage);
+    }
+
+    /**
+     *  \brief  Constructor (from saved set)
+     *
+     *  \param  storage   Saved set storage (ownership is taken)
+     *  \param  size      Saved set size
+     *  \param  indexing  Build inverted index
+     */
+    basic_pattern_set(storage_t && storage, size_t size, indexing_t indexing):
+        m_storage(std::move(storage))
+    {
+        const std::byte * const data = m_storage.get();
+
+        file_header header;
+        if (size < alignment) throw binary_format_error("truncated pattern set header");
+        std::memcpy(&header, data, sizeof(header));
+
+        if (0 != std::memcmp(header.magic, file_magic, sizeof(file_magic)))
+            throw binary_format_error("not a pattern set");
+        if (file_version != header.version)
+            throw binary_format_error("unsupported pattern set version");
+        if (0x01020304 != header.byte_order ||
+            sizeof(char_t) != header.char_size ||
+            sizeof(key_t) != header.key_size ||
+            sizeof(size_t) != header.size_size ||
+            std::is_signed_v<char_t> != static_cast<bool>(header.char_signed))
+            throw binary_format_error("incompatible pattern set (byte order or types)");
+        if (reinterpret_cast<std::uintptr_t>(data) % alignment)
+            throw binary_format_error("misaligned pattern set");
+
+        if (header.pattern_cnt > size || header.key_cnt > size)  // also avoids layout overflow
+            throw binary_format_error("truncated pattern set");
+
+        m_size = header.pattern_cnt;
+        m_key_cnt = header.key_cnt;
+        m_blob_size = header.blob_size;
+        m_blob = data + alignment;
+
+        const layout_t layout(m_size, m_key_cnt);
+        if (layout.size != m_blob_size || size - alignment < m_blob_size)
+            throw binary_format_error("truncated pattern set");
+
+        set_sections(m_blob, layout);
+
+        // Check structure (keys and counts are not touched)
+        if (0 != m_offsets[0] || m_key_cnt != m_offsets[m_size])
+            throw binary_format_error("malformed pattern set offsets");
+
+        for (size_t p = 0; p < m_size; ++p) {
+            if (m_offsets[p] > m_offsets[p + 1] || m_order[p] >= m_size ||
+                m_sorted_sizes[p] != m_sizes[m_order[p]] ||
+                (p && m_sorted_sizes[p - 1] > m_sorted_sizes[p]))
+                throw binary_format_error("malformed pattern set");
+        }
+
+        if (INDEX == indexing) build_index();
+    }
+
+    public:
+
+    /** Empty set */
+    basic_pattern_set(): basic_pattern_set(std::vector<basic_bigrams<char_t>>()) {}
+
+    /**
+     *  \brief  Constructor (freeze patterns)
+     *
+     *  \param  patterns  Range of pattern bigram multisets (of any storage)
+     *  \param  indexing  Build inverted index
+     */
+    template <class Patterns>
+    explicit basic_pattern_set(const Patterns & patterns, indexing_t indexing = NO_INDEX) {
+        size_t size = 0, key_cnt = 0;
+        for (const auto & pattern: patterns) {
+            for (auto bigram = pattern.begin(); bigram != pattern.end(); ++bigram)
+                ++key_cnt;
+            ++size;
+        }
+
+        // Lay the blob out
+        const layout_t layout(size, key_cnt);
+
+        m_blob_size = layout.size;
+        m_storage = allocate(m_blob_size);
+        m_blob = m_storage.get();
+
+        std::byte * const blob = m_storage.get();
+        std::memset(blob, 0, m_blob_size);  // no garbage in section padding
+
+        auto sizes = reinterpret_cast<size_t *>(blob + layout.sizes);
+        auto offsets = reinterpret_cast<size_t *>(blob + layout.offsets);
+        auto order = reinterpret_cast<size_t *>(blob + layout.order);
+        auto sorted_sizes = reinterpret_cast<size_t *>(blob + layout.sorted_sizes);
+        auto keys = reinterpret_cast<key_t *>(blob + layout.keys);
+        auto cnts = reinterpret_cast<size_t *>(blob + layout.cnts);
+
+        // Fill the blob in
+        size_t p = 0, k = 0;
+        offsets[0] = 0;
+        for (const auto & pattern: patterns) {
+            for (const auto & bigram_cnt: pattern) {
+                keys[k] = view_t::key_traits::pack(std::get<0>(bigram_cnt));
+                cnts[k] = std::get<1>(bigram_cnt);
+                ++k;
+            }
+
+            sizes[p] = pattern.size();
+            offsets[++p] = k;
+        }
+
+        for (p = 0; p < size; ++p) order[p] = p;
+        std::stable_sort(order, order + size, [sizes](size_t p1, size_t p2) {
+            return sizes[p1] < sizes[p2];
+        });
+
+        for (p = 0; p < size; ++p) sorted_sizes[p] = sizes[order[p]];
+
+        m_size = size;
+        m_key_cnt = key_cnt;
+        set_sections(blob, layout);
+
+        if (INDEX == indexing) build_index();
+    }
+
+    /** Copy constructor (copying is forbidden) */
+    basic_pattern_set(const basic_pattern_set & ) = delete;
+
+    /** Move constructor */
+    basic_pattern_set(basic_pattern_set && ) = default;
+
+    /** Copy assignment (copying is forbidden) */
+    basic_pattern_set & operator = (const basic_pattern_set & ) = delete;
+
+    /** Move assignment */
+    basic_pattern_set & operator = (basic_pattern_set && ) = default;
+
+    /** Number of patterns */
+    size_t size() const { return m_size; }
+
+    /** Blob size (in bytes) */
+    size_t blob_size() const { return m_blob_size; }
+
+    /**
+     *  \brief  Pattern getter
+     *
+     *  \param  p  Pattern index
+     *
+     *  \return Pattern bigrams view
+     */
+    view_t pattern(size_t p) const {
+        assert(p < m_size);
+        return view_t(
+            m_keys + m_offsets[p], m_cnts + m_offsets[p],
+            m_offsets[p + 1] - m_offsets[p], m_sizes[p]);
+    }
+
+    /** Pattern size (number of bigrams) */
+    size_t pattern_size(size_t p) const { return m_sizes[p]; }
+
+    /** Pattern indices ordered by pattern size (ascending) */
+    const size_t * order() const { return m_order; }
+
+    /** Pattern sizes in ascending order (of \c order) */
+    const size_t * sorted_sizes() const { return m_sorted_sizes; }
+
+    /** Inverted index available */
+    bool indexed() const { return m_index.has_value(); }
+
+    /**
+     *  \brief  Save the set (see \c map and \c load)
+     *
+     *  The inverted index is not saved (it may be re-built on load).
+     *
+     *  \param  out  Output stream (binary)
+     */
+    void save(std::ostream & out) const {
+        file_header header = {};
+        std::memcpy(header.magic, file_magic, sizeof(file_magic));
+        header.version = file_version;
+        header.byte_order = 0x01020304;
+        header.char_size = sizeof(char_t);
+        header.key_size = sizeof(key_t);
+        header.size_size = sizeof(size_t);
+        header.char_signed = std::is_signed_v<char_t>;
+        header.pattern_cnt = m_size;
+        header.key_cnt = m_key_cnt;
+        header.blob_size = m_blob_size;
+
+        char padded_header[alignment] = {};
+        std::memcpy(padded_header, &header, sizeof(header));
+
+        out.write(padded_header, alignment);
+        out.write(reinterpret_cast<const char *>(m_blob), m_blob_size);
+    }
+
+    /**
+     *  \brief  Save the set to file
+     *
+     *  \param  path  File path
+     */
+    void save(const std::string & path) const {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        save(out);
+        out.close();
+        if (!out) throw std::system_error(errno, std::generic_category(), path);
+    }
+
+    /**
+     *  \brief  Use saved set in place (no deserialisation, see \c save)
+     *
+     *  The set header and structure (offsets, size order) are checked;
+     *  the memory must stay valid (and unchanged) for the set lifetime.
+     *
+     *  \param  data      Saved set (aligned to \c alignment bytes)
+     *  \param  size      Saved set size
+     *  \param  indexing  Build inverted index
+     *
+     *  \return Pattern set
+     */
+    static basic_pattern_set map(const void * data, size_t size, indexing_t indexing = NO_INDEX) {
+        storage_deleter borrowed;
+        borrowed.kind = storage_deleter::BORROWED;
+
+        return basic_pattern_set(storage_t(
+            static_cast<std::byte *>(const_cast<void *>(data)), borrowed), size, indexing);
+    }
+
+    /**
+     *  \brief  Load saved set (see \c save)
+     *
+     *  The file is memory-mapped (read-only) and used in place, with no deserialisation
+     *  (on platforms without \c mmap, it's read into memory).
+     *
+     *  \param  path      File path
+     *  \param  indexing  Build inverted index
+     *
+     *  \return Pattern set
+     */
+    static basic_pattern_set load(const std::string & path, indexing_t indexing = NO_INDEX) {
+#if defined(__unix__) || defined(__APPLE__)
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), path);
+
+        struct stat st;
+        if (::fstat(fd, &st) < 0) {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), path);
+        }
+
+        const size_t size = static_cast<size_t>(st.st_size);
+        if (size < alignment) {
+            ::close(fd);
+            throw binary_format_error("truncated pattern set header");
+        }
+
+        void * map = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        const int error = errno;
+        ::close(fd);  // the mapping stays valid
+
+        if (MAP_FAILED == map) throw std::system_error(error, std::generic_category(), path);
+
+        storage_deleter mapped;
+        mapped.kind = storage_deleter::MAPPED;
+        mapped.size = size;
+
+        return basic_pattern_set(
+            storage_t(static_cast<std::byte *>(map), mapped), size, indexing);
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) throw std::system_error(errno, std::generic_category(), path);
+
+        const size_t size = static_cast<size_t>(in.tellg());
+        auto storage = allocate(size);
+        in.seekg(0);
+        in.read(reinterpret_cast<char *>(storage.get()), size);
+        if (!in) throw std::system_error(errno, std::generic_category(), path);
+
+        return basic_pattern_set(std::move(storage), size, indexing);
+#endif
+    }
+
+    /**
+     *  \brief  Threshold lookup (requires the inverted index)
+     *
+     *  \param  query      Query bigrams
+     *  \param  threshold  Matching score (SDC) threshold (positive)
+     *  \param  sink       Match sink (callable with \c bigram_index_match argument)
+     */
+    template <class Storage, class Sink>
+    void lookup(
+        const basic_bigrams<char_t, Storage> & query,
+        double threshold,
+        Sink && sink) const
+    {
+        assert(indexed());
+        m_index->lookup(query, threshold, std::forward<Sink>(sink));
+    }
+
+    /**
+     *  \brief  Threshold lookup (requires the inverted index)
+     *
+     *  \param  query      Query bigrams
+     *  \param  threshold  Matching score (SDC) threshold (positive)
+     *
+     *  \return Matches (in ascending pattern index order)
+     */
+    template <class Storage>
+    std::vector<bigram_index_match> lookup(
+        const basic_bigrams<char_t, Storage> & query,
+        double threshold) const
+    {
+        assert(indexed());
+        return m_index->lookup(query, threshold);
+    }
+
+};  // end of template class basic_pattern_set
+
+
+using bigrams_view = basic_bigrams_view<char>;      /**< ASCII/ANSI bigrams view    */
+using wbigrams_view = basic_bigrams_view<wchar_t>;  /**< UNICODE bigrams view       */
+
+using pattern_set = basic_pattern_set<char>;        /**< ASCII/ANSI pattern set     */
+using wpattern_set = basic_pattern_set<wchar_t>;    /**< UNICODE pattern set        */
+
+}  // end of namespace libsdcxx
+
+#endif  // end of #ifndef libsdcxx__pattern_set_hxx
@@ -45,17 +45,261 @@
 
 #include <cassert>
 #include <cstddef>
-#include <variant>
+#include <cstdint>
+#include <limits>
+#include <ratio>
 #include <vector>
-#include <unordered_set>
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <tuple>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
 #include <string>
+#include <string_view>
 #include <iostream>
 
 #include "bigrams.hxx"
+#include "pattern_set.hxx"
+#include "arena.hxx"
+#include "utf8.hxx"
 
 
 namespace libsdcxx {
 
+/**
+ *  \brief  Sequence match record (see \c basic_sequence_matcher::match_all)
+ *
+ *  Plain data (also used by the C API).
+ */
+struct sequence_match {
+    size_t pattern;     /**< Matching pattern index                     */
+    size_t begin;       /**< Index of the 1st string of the sub-sequence */
+    size_t end;         /**< Index just past the sub-sequence            */
+    double score;       /**< Match score (Sørensen-Dice coefficient)     */
+};
+
+
+/**
+ *  \brief  Matrix cell cache statistics (see \c basic_sequence_matcher::cache_budget)
+ *
+ *  Plain data (also used by the C API).
+ */
+struct cell_cache_stats {
+    size_t hits;        /**< Sub-sequence bigrams found in the cache    */
+    size_t misses;      /**< Sub-sequence bigrams computed              */
+    size_t evictions;   /**< Sub-sequence bigrams evicted from the cache */
+};
+
+
+/**
+ *  \brief  Matching statistics (see \c basic_sequence_matcher::stats)
+ *
+ *  Plain data (also used by the C API).
+ */
+struct match_stats {
+    size_t visited;             /**< Sub-sequences visited (matrix cells)           */
+    size_t strip_skips;         /**< Sub-sequences skipped for "strip" begin or end */
+    size_t card_pruned;         /**< Sub-sequences pruned by cardinality ratio      */
+    size_t sdc_computations;    /**< Sub-sequence vs pattern SDC computations       */
+    size_t threshold_rejects;   /**< SDC computations below the threshold           */
+    size_t sketch_rejects;      /**< SDC computations avoided by the sketch bound   */
+    size_t unions;              /**< Sub-sequence bigrams unions materialised       */
+    size_t bytes_allocated;     /**< Matrix arena bytes allocated for the unions    */
+};
+
+
+/**
+ *  \brief  Matching statistics policy: no statistics
+ *
+ *  The counting is a no-op (so it's optimised out completely).
+ */
+struct no_match_counters {
+    void visited() {}
+    void strip_skipped(size_t ) {}
+    void card_pruned(size_t ) {}
+    void sdc_computed() {}
+    void threshold_rejected() {}
+    void sketch_rejected() {}
+    void united() {}
+    void allocated(size_t ) {}
+
+    match_stats stats() const { return match_stats{0, 0, 0, 0, 0, 0, 0, 0}; }
+    void reset() {}
+};
+
+
+/**
+ *  \brief  Matching statistics policy: count
+ *
+ *  Note that the counters aren't synchronised (neither is the matcher).
+ */
+class match_counters {
+    private:
+
+    match_stats m_stats;    /**< Statistics */
+
+    public:
+
+    match_counters(): m_stats{0, 0, 0, 0, 0, 0, 0, 0} {}
+
+    void visited() { ++m_stats.visited; }
+    void strip_skipped(size_t cells) { m_stats.strip_skips += cells; }
+    void card_pruned(size_t cells) { m_stats.card_pruned += cells; }
+    void sdc_computed() { ++m_stats.sdc_computations; }
+    void threshold_rejected() { ++m_stats.threshold_rejects; }
+    void sketch_rejected() { ++m_stats.sketch_rejects; }
+    void united() { ++m_stats.unions; }
+    void allocated(size_t bytes) { m_stats.bytes_allocated += bytes; }
+
+    const match_stats & stats() const { return m_stats; }
+    void reset() { m_stats = match_stats{0, 0, 0, 0, 0, 0, 0, 0}; }
+};
+
+
+/** Cardinality ratio check result */
+enum card_check_t {
+    CARD_OK = 0,    /**< Cardinality ratio is acceptable            */
+    CARD_SHORT,     /**< Sub-sequence is too short (try a longer one) */
+    CARD_LONG,      /**< Sub-sequence is too long (stop extending)    */
+};
+
+/**
+ *  \brief  Check sub-sequence vs matched bigrams cardinality ratio
+ *
+ *  \param  subseq_size           Sub-sequence bigrams size
+ *  \param  bgrms_size            Matched bigrams size
+ *  \param  card_ratio_threshold  Cardinality ratio threshold (2/T - 1)
+ *
+ *  \return Check result
+ */
+inline card_check_t check_cardinality(
+    size_t subseq_size, size_t bgrms_size, double card_ratio_threshold)
+{
+    double card_ratio =
+        static_cast<double>(subseq_size) /
+        static_cast<double>(bgrms_size);
+
+    bool subseq_short = card_ratio < 1.0;  // sub-sequence is shorter
+
+    // Make sure we take bigger / smaller ratio
+    if (subseq_short) card_ratio = 1.0 / card_ratio;
+
+    if (card_ratio > card_ratio_threshold)  // SDC would be too small
+        return subseq_short ? CARD_SHORT : CARD_LONG;
+
+    return CARD_OK;
+}
+
+/**
+ *  \brief  Sørensen-Dice coefficient
+ *
+ *  Computed just like \c basic_bigrams::sorensen_dice_coef (from the sizes).
+ *
+ *  \param  isect_size  Intersection size
+ *  \param  size_sum    Sum of the multisets sizes
+ *
+ *  \return SDC
+ */
+inline double sorensen_dice_coef(size_t isect_size, size_t size_sum) {
+    return isect_size ? 2.0 * isect_size / size_sum : 0.0;
+}
+
+/**
+ *  \brief  Run-time matching threshold
+ *
+ *  Matching threshold policies (see also \c static_threshold) are shared by
+ *  the matchers; \c make_threshold chooses the policy for the threshold type.
+ */
+class dynamic_threshold {
+    private:
+
+    double m_sdc;           /**< Sørensen-Dice coef. threshold     */
+    double m_card_ratio;    /**< Bigrams cardinality ratio thresh. */
+
+    public:
+
+    /** Constructor */
+    explicit dynamic_threshold(double sdc): m_sdc(sdc), m_card_ratio(2.0 / sdc - 1.0) {}
+
+    /** SDC threshold */
+    double sdc() const { return m_sdc; }
+
+    /** Check sub-sequence vs matched bigrams cardinality ratio */
+    card_check_t check_cardinality(size_t subseq_size, size_t bgrms_size) const {
+        return libsdcxx::check_cardinality(
+            subseq_size, bgrms_size, m_card_ratio);
+    }
+
+    /** Check if intersection size makes a match */
+    bool accept(size_t isect_size, size_t size_sum) const {
+        return !(sorensen_dice_coef(isect_size, size_sum) < m_sdc);
+    }
+
+};  // end of class dynamic_threshold
+
+/**
+ *  \brief  Compile-time matching threshold
+ *
+ *  For threshold T = Num/Den, the cardinality ratio bound |B|/|A| <= 2/T - 1
+ *  (where |A| <= |B|) is checked as |B|·Num <= |A|·(2·Den - Num) and
+ *  the match condition 2|A \cap B| / (|A|+|B|) >= T as
+ *  2·Den·|A \cap B| >= Num·(|A|+|B|), i.e. in integer arithmetic only.
+ *
+ *  \tparam  Num  Threshold numerator
+ *  \tparam  Den  Threshold denominator
+ */
+template <intmax_t Num, intmax_t Den>
+class static_threshold {
+    private:
+
+    using ratio = std::ratio<Num, Den>;  /**< Normalised threshold */
+
+    static_assert(0 < ratio::num && ratio::num <= ratio::den,
+        "SDC threshold must be in (0, 1]");
+
+    static constexpr uintmax_t num = ratio::num;                /**< Numerator   */
+    static constexpr uintmax_t den = ratio::den;                /**< Denominator */
+    static constexpr uintmax_t card_num = 2 * ratio::den - ratio::num;  /**< 2·Den - Num */
+
+    public:
+
+    /** SDC threshold */
+    static constexpr double sdc() {
+        return static_cast<double>(num) / static_cast<double>(den);
+    }
+
+    /** Check sub-sequence vs matched bigrams cardinality ratio */
+    static card_check_t check_cardinality(size_t subseq_size, size_t bgrms_size) {
+        const bool subseq_short = subseq_size < bgrms_size;  // sub-sequence is shorter
+        const uintmax_t smaller = subseq_short ? subseq_size : bgrms_size;
+        const uintmax_t bigger = subseq_short ? bgrms_size : subseq_size;
+
+        if (bigger * num > smaller * card_num)  // SDC would be too small
+            return subseq_short ? CARD_SHORT : CARD_LONG;
+
+        return CARD_OK;
+    }
+
+    /** Check if intersection size makes a match */
+    static bool accept(size_t isect_size, size_t size_sum) {
+        return isect_size && 2 * den * isect_size >= num * size_sum;
+    }
+
+};  // end of template class static_threshold
+
+/** Run-time threshold */
+inline dynamic_threshold make_threshold(double sdc) { return dynamic_threshold(sdc); }
+
+/** Compile-time threshold */
+template <intmax_t Num, intmax_t Den>
+static_threshold<Num, Den> make_threshold(std::ratio<Num, Den> ) {
+    return static_threshold<Num, Den>();
+}
+
+
 /**
  *  \brief   String sequence matching using Sørensen-Dice bigram multiset similarity
  *
@@ -122,13 +366,18 @@ namespace libsdcxx {
  *  Hence, we conclude that the union of B_{k,j} and B_{i-k-1,j+k+1} indeed keeps
  *  union of bigrams of token sequence of length i+1 starting at index j, QED.
  *
+ *  Trivially, B_{i,j} = B_{i-1,j} + B_{0,j+i} as well; if B_{i-1,j} is already
+ *  computed (which is typical when extending a sub-sequence), that's used instead,
+ *  as it needs no recursion.
+ *
  *  Note that in order to calculate the size of the bigrams union, one doesn't
  *  necessarily have to construct it.
  *  As noted above, the number of token bigrams simply equals to the token size minus 1.
  *  Cardinality of union of bigram multisets is then a simple sum of sub-set
  *  cardinalities.
- *  Sizes of the bigrams in the matrix are therefore easily calculated using the very
- *  same recursive indexing descend as applies to computation of the unions above.
+ *  Sizes of the bigrams in the matrix are therefore differences of prefix sums
+ *  of the token bigrams cardinalities (kept up to date as the tokens are pushed),
+ *  i.e. computed in O(1) time without touching the matrix at all.
  *
  *  The above yields another optimisation of the match computation.
  *  Since successful match must reach certain SDC threshold, and thanks to properties
@@ -175,97 +424,280 @@ namespace libsdcxx {
  *  This effectively means that if we take B to represent the token sub-sequence and A
  *  the matched string(s), as soon as we get to the point of breaching of the upper bound
  *  condition, we may stop trying to extend the sub-sequence.
+ *  Even better, as the sub-sequence sizes grow monotonically with the row index,
+ *  the acceptable rows of each column are found by binary search over the prefix
+ *  sums (and the acceptable patterns by binary search over size-sorted patterns
+ *  when matching many of them); other cells are never touched.
  *
  *  Another optimisation is achieved by omitting from consideration sub-sequences that
  *  begin or end with unacceptable (aka "strip") tokens.
  *  These would typically be e.g. white spaces and punctuation marks.
+ *  Besides the "strip" flags bitmap, the matcher keeps index of the next non-strip
+ *  token for each token, so whole runs of strip tokens are skipped in one step.
+ *
+ *  When the sub-sequence bigrams aren't required (see \c match), the unions needn't be
+ *  computed at all: extending a sub-sequence by one token, its intersection size with
+ *  the pattern only grows by the intersection of the token bigrams with the pattern
+ *  bigrams not matched yet (residual counts), which costs O(|token|) (bar lookup).
+ *
+ *  The matrix is stored in a contiguous array with cells ordered by
+ *  the sub-sequence end; the cells only point to the bigrams (so a cell costs
+ *  one word until its union is computed).  The bigrams are allocated from
+ *  a monotonic arena owned by the matcher, so they're all released in one step.
+ *  \c clear keeps all that memory for the next sequence.
+ *
+ *  The computed unions are kept (memoised) for the whole sequence by default.
+ *  On long sequences with permissive thresholds, that's a lot of memory; a cache
+ *  budget (in bytes, see \c cache_budget) bounds it.
+ *  Over budget, the least recently computed cells are evicted (and their memory
+ *  recycled by a pool), except for the cells of power-of-two sub-sequence lengths:
+ *  the halving recursion builds all the unions out of those, so they're evicted
+ *  only as the last resort.
+ *
+ *  What the matching costs (visited sub-sequences, pruning, unions computed etc.)
+ *  may be counted by the matcher (see \c stats); the counting is selected at compile
+ *  time by the \c Stats policy (\c no_match_counters by default, i.e. no counting
+ *  and no overhead at all).
  *
  *  See https://en.wikipedia.org/wiki/S%C3%B8rensen%E2%80%93Dice_coefficient
  *
  *  \tparam  Bigrams  Bigram multiset implementation
+ *  \tparam  Stats    Matching statistics policy (\c no_match_counters
+ *                    or \c match_counters)
  */
-template <class Bigrams>
+template <class Bigrams, class Stats = no_match_counters>
 class basic_sequence_matcher {
     public:
 
     using bigrams_t = Bigrams;                      /**< Bigrams type   */
     using char_t = typename bigrams_t::char_t;      /**< Character type */
     using string_t = std::basic_string<char_t>;     /**< String type    */
+    using stats_t = Stats;                          /**< Stats policy   */
 
     private:
 
-    /** Bigram multiset matrix cell */
-    class mx_cell {
-        public:
+    /** Bigram multiset matrix cell (bigrams computed lazily, \c nullptr until then) */
+    using mx_cell = bigrams_t *;
+
+    using cells_t = std::vector<mx_cell>;       /**< Bigram multiset matrix cells       */
+    using sizes_t = std::vector<size_t>;        /**< Bigram multiset sizes              */
+    using flags_t = std::vector<bool>;          /**< Token flags                        */
+    using indices_t = std::vector<size_t>;      /**< Token indices                      */
+
+    /** Union cells pool (evicted cells memory is recycled) */
+    using pool_t = std::pmr::unsynchronized_pool_resource;
+
+    std::unique_ptr<arena> m_arena;  /**< Cells bigrams memory arena (stays put on move) */
+    std::unique_ptr<pool_t> m_pool;  /**< Union cells pool (on top of the arena)         */
+    std::unique_ptr<counting_resource> m_arena_cells;  /**< Union cells in the arena     */
+    std::unique_ptr<counting_resource> m_pool_cells;   /**< Union cells in the pool      */
+    cells_t m_cells;                 /**< Bigram multiset matrix                         */
+    sizes_t m_size_sums;             /**< Prefix sums of token bigram multiset sizes     */
+    flags_t m_strip;                 /**< "Strip" string flags of the sequence           */
+    indices_t m_next_valid;          /**< Next non-strip string indices (at or after)    */
+    size_t m_budget;                 /**< Cell cache budget (bytes)                      */
+    std::deque<size_t> m_evictable;  /**< Cached union cells (computation order)         */
+    std::deque<size_t> m_halving;    /**< Cached power-of-two length cells (ditto)       */
+    size_t m_depth;                  /**< Union computation recursion depth              */
+    size_t m_generation;             /**< Modifications count (see \c generation)        */
+    cell_cache_stats m_stats;        /**< Cell cache statistics                          */
+    mutable stats_t m_counters;      /**< Matching statistics                            */
 
-        /** Type of value currently stored in bigram multiset matrix cell */
-        enum val_type_t {
-            NONE = 0,   /**< No value set yet   */
-            SIZE,       /**< Size only          */
-            BIGRAMS,    /**< Bigrams and size   */
-        };
+    /**
+     *  \brief  Number of cells of triangular matrix
+     *
+     *  \param  len  Sequence length
+     *
+     *  \return Number of cells
+     */
+    static constexpr size_t cells(size_t len) { return len * (len + 1) / 2; }
 
-        private:
+    /**
+     *  \brief  Cell index
+     *
+     *  The cells are stored by their end column, i.e. cells of sub-sequences ending
+     *  with the same token are adjacent (ordered by the sub-sequence length).
+     *  Pushing another token to the sequence therefore simply appends its cells.
+     *
+     *  \param  i  Row index (sub-sequence length - 1)
+     *  \param  j  Column index (sub-sequence begin)
+     *
+     *  \return Index of cell [i,j]
+     */
+    static constexpr size_t ix(size_t i, size_t j) { return cells(i + j) + i; }
+
+    /** Check if string at index is a "strip" string */
+    bool is_strip(size_t ix) const { return m_strip[ix]; }
 
-        /** Value currently stored in bigram multiset matrix cell */
-        using val_t = std::variant<size_t, bigrams_t>;
+    /**
+     *  \brief  Skip "strip" strings
+     *
+     *  The skipped strings are counted as strip skips.
+     *
+     *  \param  ix     String index
+     *  \param  limit  Index limit (at most the sequence size)
+     *
+     *  \return Index of the 1st non-strip string at or after \c ix (or \c limit)
+     */
+    size_t skip_strip(size_t ix, size_t limit) const {
+        if (!(ix < limit)) return limit;
 
-        val_type_t m_type;  /**< Value type */
-        val_t m_value;      /**< Value      */
+        const size_t next = std::min(m_next_valid[ix], limit);
+        m_counters.strip_skipped(next - ix);
+        return next;
+    }
 
-        public:
+    /** Matrix memory allocator */
+    std::pmr::polymorphic_allocator<std::byte> alloc() const { return m_arena.get(); }
 
-        mx_cell(): m_type(NONE) {}
+    /** Union cells memory allocator (pooled if the cache is bounded) */
+    std::pmr::polymorphic_allocator<std::byte> cell_alloc() const {
+        if (unlimited_cache == m_budget) return m_arena_cells.get();
+        return m_pool_cells.get();
+    }
 
-        /** Bigrams matrix cell from existing bigrams */
-        mx_cell(const bigrams_t & bgrms): m_type(BIGRAMS), m_value(bgrms) {}
+    /**
+     *  \brief  Construct cell bigrams
+     *
+     *  The bigrams object is allocated by the memory resource of \c alloc,
+     *  which is also passed to the bigrams constructor (as the last argument).
+     *
+     *  \param  alloc  Allocator
+     *  \param  args   Bigrams constructor arguments (but the allocator)
+     *
+     *  \return Cell bigrams
+     */
+    template <class ... Args>
+    static bigrams_t * new_cell(
+        const std::pmr::polymorphic_allocator<std::byte> & alloc, Args && ... args)
+    {
+        auto * const resource = alloc.resource();
+        void * const mem = resource->allocate(sizeof(bigrams_t), alignof(bigrams_t));
+        try {
+            return new (mem) bigrams_t(std::forward<Args>(args)..., alloc);
+        }
+        catch (...) {
+            resource->deallocate(mem, sizeof(bigrams_t), alignof(bigrams_t));
+            throw;
+        }
+    }
 
-        /** Bigrams matrix cell from moved bigrams */
-        mx_cell(bigrams_t && bgrms): m_type(BIGRAMS), m_value(bgrms) {}
+    /**
+     *  \brief  Destroy union cell bigrams
+     *
+     *  The bigrams object memory is returned to the resource of the bigrams
+     *  allocator (it was allocated by it, see \c new_cell).
+     *
+     *  \param  cell  Union cell
+     */
+    static void delete_cell(mx_cell & cell) {
+        auto * const resource = cell->get_allocator().resource();
+        cell->~bigrams_t();
+        resource->deallocate(cell, sizeof(bigrams_t), alignof(bigrams_t));
+        cell = nullptr;
+    }
 
-        /** Move constructor */
-        mx_cell(mx_cell && ) = default;
+    /** Destroy all the cells bigrams (token cells are in the arena) */
+    void delete_cells() {
+        // Cells are stored by sub-sequence end (column), the token cell first
+        for (size_t end = 0; cells(end) < m_cells.size(); ++end) {
+            m_cells[ix(0, end)]->~bigrams_t();
 
-        /** Move assignment operator */
-        mx_cell & operator = (mx_cell && ) = default;
+            for (size_t i = 1; i <= end; ++i) {
+                auto & cell = m_cells[ix(i, end - i)];
+                if (cell) delete_cell(cell);
+            }
+        }
 
-        val_type_t content() const { return m_type; }
+        m_cells.clear();
+    }
 
-        public:
+    /**
+     *  \brief  Check whether the sketch bound of intersection size reaches threshold
+     *
+     *  If the bigrams keep sketches (see \c sketched_bigram_storage), the intersection
+     *  size upper bound is computed from them in constant time; candidates which can't
+     *  reach the threshold even so are rejected without the exact scoring.
+     *  Otherwise, the check is void (the bound is implied by the cardinality check).
+     *
+     *  \param  bgrms1     Bigram multiset
+     *  \param  bgrms2     Bigram multiset
+     *  \param  threshold  Matching threshold
+     *
+     *  \return \c false iff the bigrams can't match
+     */
+    template <class Threshold>
+    bool check_sketch(
+        const bigrams_t & bgrms1, const bigrams_t & bgrms2,
+        const Threshold & threshold) const
+    {
+        if constexpr (bigrams_t::sketched) {
+            const size_t bound = bigrams_t::intersect_bound(bgrms1, bgrms2);
+            if (threshold.accept(bound, bgrms1.size() + bgrms2.size())) return true;
 
-        void set_size(size_t size) {
-            assert(m_type == NONE);  // only done once
-            m_value = size;
-            m_type = SIZE;
+            m_counters.sketch_rejected();
+            return false;
         }
+        else
+            return true;
+    }
 
-        size_t size() const {
-            assert(m_type != NONE);  // size must be set
-            return m_type == SIZE
-                ? std::get<size_t>(m_value)
-                : std::get<bigrams_t>(m_value).size();
-        }
+    /**
+     *  \brief  Running intersection of extended sub-sequence with a pattern
+     *
+     *  Keeps the pattern bigram counts not matched by the sub-sequence yet (residuals);
+     *  adding another token to the sub-sequence only visits the token bigrams.
+     */
+    class running_intersection {
+        private:
+
+        using key_traits = bigram_key<char_t>;
+        using key_t = typename key_traits::key_t;
+
+        std::vector<key_t> m_keys;      /**< Pattern bigram keys (sorted)   */
+        std::vector<size_t> m_cnts;     /**< Pattern bigram counts          */
+        std::vector<size_t> m_residual; /**< Residual counts                */
+        size_t m_size;                  /**< Intersection size              */
+
+        public:
+
+        /** Constructor */
+        running_intersection(const bigrams_t & pattern): m_size(0) {
+            for (const auto & bigram_cnt: pattern) {
+                m_keys.push_back(key_traits::pack(std::get<0>(bigram_cnt)));
+                m_cnts.push_back(std::get<1>(bigram_cnt));
+            }
 
-        void set_bigrams(bigrams_t && bgrms) {
-            assert(m_type != BIGRAMS);  // only done once
-            m_value = bgrms;
-            m_type = BIGRAMS;
+            m_residual = m_cnts;
         }
 
-        const bigrams_t & bigrams() const {
-            assert(m_type == BIGRAMS);
-            return std::get<bigrams_t>(m_value);
+        /** Start new sub-sequence */
+        void reset() {
+            std::copy(m_cnts.cbegin(), m_cnts.cend(), m_residual.begin());
+            m_size = 0;
         }
 
-    };  // end of class mx_cell
+        /** Extend the sub-sequence by token bigrams */
+        void add(const bigrams_t & token) {
+            auto key = m_keys.cbegin();
+            for (const auto & bigram_cnt: token) {  // both are sorted
+                key = std::lower_bound(key, m_keys.cend(),
+                    key_traits::pack(std::get<0>(bigram_cnt)));
 
-    using row_t = std::vector<mx_cell>;     /**< Bigram multiset matrix row type    */
-    using matrix_t = std::vector<row_t>;    /**< Bigram multiset matrix type        */
+                if (key == m_keys.cend()) break;
+                if (*key != key_traits::pack(std::get<0>(bigram_cnt))) continue;
+
+                auto & residual = m_residual[key - m_keys.cbegin()];
+                const size_t cnt = std::min(residual, std::get<1>(bigram_cnt));
+                residual -= cnt;
+                m_size += cnt;
+            }
+        }
 
-    using ix_set_t = std::unordered_set<size_t>;    /**< Set of indices */
+        /** Intersection size */
+        size_t size() const { return m_size; }
 
-    matrix_t m_mx;          /**< Bigram multiset (or multiset size) matrix      */
-    ix_set_t m_strip_ixs;   /**< Set of "strip" strings indices in the sequence */
+    };  // end of class running_intersection
 
     public:
 
@@ -282,9 +714,9 @@ class basic_sequence_matcher {
 
         basic_sequence_matcher & m_matcher;  /**< Matcher                           */
         const bigrams_t & m_bigrams;         /**< Matched string(s) bigrams         */
-        double m_sdc_threshold;              /**< Sørensen-Dice coef. threshold     */
-        double m_card_ratio_threshold;       /**< Bigrams cardinality ratio thresh. */
+        dynamic_threshold m_threshold;       /**< Matching threshold                */
         size_t m_i, m_j;                     /**< Bigrams matrix row & col. indices */
+        size_t m_i_end;                      /**< End of acceptable rows in column  */
         double m_sdc;                        /**< Sørensen-Dice coef. at [i,j]      */
 
         private:
@@ -306,52 +738,56 @@ class basic_sequence_matcher {
         :
             m_matcher(matcher),
             m_bigrams(bgrms),
-            m_sdc_threshold(threshold),
-            m_card_ratio_threshold(2.0 / threshold - 1.0),
-            m_i(i), m_j(j), m_sdc(0.0)
+            m_threshold(threshold),
+            m_i(i), m_j(j), m_i_end(0), m_sdc(0.0)
         {
             next_match();  // find 1st match
         }
 
         iterator(basic_sequence_matcher & matcher, end_t ):
-            iterator(matcher, s_empty_bigrams, 0.0, 0, matcher.size())
+            iterator(matcher, s_empty_bigrams, 1.0, 0, matcher.size())
         {}
 
-        /** Shift to next matching sub-sequence */
+        /**
+         *  \brief  Shift to next matching sub-sequence
+         *
+         *  Rows with acceptable cardinality ratio are found by binary search
+         *  at the column begin (when \c m_i is 0); other cells are never touched.
+         */
         void next_match() {
-            for (; m_j < m_matcher.size(); ++m_j) {
-                // Skip sub-sequence beginning with "strip" string
-                if (m_matcher.m_strip_ixs.count(m_j)) continue;
-
-                for (; m_i < m_matcher.size() - m_j; ++m_i) {
-                    // Skip sub-sequence ending with "strip" string
-                    if (m_matcher.m_strip_ixs.count(m_j + m_i)) continue;
-
-                    // Check cardinality ratio
-                    double card_ratio =
-                        static_cast<double>(m_matcher.bigrams_size(m_i, m_j)) /
-                        static_cast<double>(m_bigrams.size());
-
-                    bool subseq_short = card_ratio < 1.0;  // sub-sequence is shorter
-
-                    // Make sure we take bigger / smaller ratio
-                    if (subseq_short) card_ratio = 1.0 / card_ratio;
+            auto & counters = m_matcher.m_counters;
+            const size_t size = m_matcher.size();
+
+            // Skip sub-sequences beginning or ending with "strip" string
+            for (m_j = m_matcher.skip_strip(m_j, size); m_j < size;
+                m_j = m_matcher.skip_strip(m_j + 1, size), m_i = 0)
+            {
+                if (0 == m_i) {
+                    std::tie(m_i, m_i_end) = m_matcher.card_rows(
+                        m_j, m_bigrams.size(), m_bigrams.size(), m_threshold);
+                    counters.card_pruned(size - m_j - (m_i_end - m_i));
+                }
 
-                    if (card_ratio > m_card_ratio_threshold) {  // SDC would be too small
-                        if (subseq_short) continue;  // try longer sub-sequence
+                for (m_i = m_matcher.skip_strip(m_j + m_i, m_j + m_i_end) - m_j;
+                    m_i < m_i_end;
+                    m_i = m_matcher.skip_strip(m_j + m_i + 1, m_j + m_i_end) - m_j)
+                {
+                    counters.visited();
 
-                        break;  // sub-sequence got too long; no point in extending it
-                    }
+                    const auto & subseq = m_matcher.bigrams(m_i, m_j);
+                    if (!m_matcher.check_sketch(subseq, m_bigrams, m_threshold))
+                        continue;  // can't reach the threshold
 
                     // Only now it's necessary to calculate SDC
-                    m_sdc = bigrams_t::sorensen_dice_coef(
-                        m_matcher.bigrams(m_i, m_j), m_bigrams);
-                    if (m_sdc < m_sdc_threshold) continue;  // still not up to scratch
+                    m_sdc = bigrams_t::sorensen_dice_coef(subseq, m_bigrams);
+                    counters.sdc_computed();
+                    if (m_sdc < m_threshold.sdc()) {  // still not up to scratch
+                        counters.threshold_rejected();
+                        continue;
+                    }
 
                     return;  // match found
                 }
-
-                m_i = 0;  // reset row index
             }
         }
 
@@ -416,15 +852,45 @@ class basic_sequence_matcher {
         /** Comparison (ge) */
         bool operator >= (const iterator & other) const { return !(*this < other); }
 
+        /** Match serialisation operator */
+        template <typename Char>
+        friend std::basic_ostream<Char> & operator << (
+            std::basic_ostream<Char> & out, const iterator & match)
+        {
+            out << "match(begin: " << match.begin()
+                << ", end: " << match.end()
+                << ", size: " << match.size()
+                << ", SDC: " << match.sorensen_dice_coef()
+                //<< ", " << *match
+                << ")";
+
+            return out;
+        }
+
     };  // end of class iterator
 
+    /** Unlimited cell cache budget */
+    static constexpr size_t unlimited_cache = SIZE_MAX;
+
     /** Default constructor */
-    basic_sequence_matcher() = default;
+    basic_sequence_matcher():
+        m_arena(std::make_unique<arena>()),
+        m_pool(std::make_unique<pool_t>(m_arena.get())),
+        m_arena_cells(std::make_unique<counting_resource>(m_arena.get())),
+        m_pool_cells(std::make_unique<counting_resource>(m_pool.get())),
+        m_size_sums(1, 0),
+        m_budget(unlimited_cache),
+        m_depth(0),
+        m_generation(0),
+        m_stats{0, 0, 0}
+    {}
 
     /** Reserve space for sequence */
     void reserve(size_t len) {
-        m_mx.reserve(len);
-        m_strip_ixs.reserve(len);
+        m_cells.reserve(cells(len));
+        m_size_sums.reserve(len + 1);
+        m_strip.reserve(len);
+        m_next_valid.reserve(len);
     }
 
     /** Copy constructor (copying is forbidden) */
@@ -436,23 +902,131 @@ class basic_sequence_matcher {
     /** Copy assignment (copying is forbidden) */
     basic_sequence_matcher & operator = (const basic_sequence_matcher & ) = delete;
 
+    /** Destructor */
+    ~basic_sequence_matcher() { delete_cells(); }
+
     /**
      *  \brief  Size getter
      *
      *  \return Sequence length
      */
-    size_t size() const { return m_mx.size(); }
+    size_t size() const { return m_strip.size(); }
 
-    private:
+    /**
+     *  \brief  Remove the sequence
+     *
+     *  All the memory is kept for re-use (the reserved capacity, the arena),
+     *  so a long-lived matcher may process a stream of sequences without
+     *  allocations in the steady state.
+     *  Note that all match iterators are invalidated.
+     */
+    void clear() {
+        ++m_generation;
+        delete_cells();
+        m_size_sums.resize(1);
+        m_strip.clear();
+        m_next_valid.clear();
+        m_evictable.clear();
+        m_halving.clear();
+        m_pool->release();
+        m_arena->reset();
+    }
+
+    /**
+     *  \brief  Set cell cache budget
+     *
+     *  The budget is the max. number of bytes held by the cached sub-sequence
+     *  unions (the bigrams objects and their storage, whether inline or not).
+     *  The token bigrams aren't counted (nor ever evicted), neither is the matrix
+     *  itself (a pointer per cell).
+     *  Note that with a bounded cache, the sub-sequence bigrams references
+     *  (\c subsequence, match iterator dereference) are only valid until another
+     *  sub-sequence bigrams are computed.
+     *
+     *  \param  bytes  Max. number of bytes of the cached unions (\c unlimited_cache
+     *                 by default)
+     */
+    void cache_budget(size_t bytes) {
+        m_budget = bytes;
+        evict(m_cells.size());  // nothing to keep
+    }
+
+    /** Cell cache budget */
+    size_t cache_budget() const { return m_budget; }
+
+    /** Number of bytes held by the cached sub-sequence unions */
+    size_t cache_size() const {
+        if (!m_arena_cells) return 0;  // moved-from
+        return m_arena_cells->used() + m_pool_cells->used();
+    }
+
+    /** Number of cached sub-sequence unions */
+    size_t cache_cells() const { return m_evictable.size() + m_halving.size(); }
+
+    /**
+     *  \brief  Generation
+     *
+     *  The generation changes whenever a sub-sequence bigrams reference may be
+     *  invalidated, i.e. when the sequence is modified and when a cached cell
+     *  is evicted.
+     *  References held elsewhere (e.g. by language bindings) may check it to
+     *  tell whether they're still valid.
+     *
+     *  \return Generation
+     */
+    size_t generation() const { return m_generation; }
+
+    /** Cell cache statistics (since construction or \c reset_cache_stats) */
+    const cell_cache_stats & cache_stats() const { return m_stats; }
+
+    /** Reset cell cache statistics */
+    void reset_cache_stats() { m_stats = cell_cache_stats{0, 0, 0}; }
+
+    /**
+     *  \brief  Matching statistics (since construction or \c reset_stats)
+     *
+     *  All the matching (including the match iterators) is counted.
+     *  Unless the \c Stats policy counts (see \c match_counters), the statistics
+     *  are all zero.
+     */
+    match_stats stats() const { return m_counters.stats(); }
+
+    /** Reset matching statistics */
+    void reset_stats() { m_counters.reset(); }
+
+    /**
+     *  \brief  Replace the sequence
+     *
+     *  The tokens may be strings or bigram multisets, optionally paired with
+     *  the "strip" flag (\c std::pair<token_t, bool>).
+     *  As with \c clear, the memory is re-used.
+     *
+     *  \param  begin  Tokens begin
+     *  \param  end    Tokens end
+     */
+    template <class Iter>
+    void assign(Iter begin, Iter end) {
+        using iter_category_t = typename std::iterator_traits<Iter>::iterator_category;
 
-    /** Extend bigram multiset matrix for another sequence member */
-    void add_row() {
-        size_t back = size();
-        m_mx.emplace_back();
-        if (m_mx.capacity() > back)  // matrix size was reserved
-            m_mx[back].reserve(m_mx.capacity() - back);
+        clear();
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, iter_category_t>)
+            reserve(std::distance(begin, end));
+
+        for (; begin != end; ++begin) append(*begin);
     }
 
+    private:
+
+    /** Append token (string) */
+    void append(const string_t & str, bool strip = false) { emplace_back(str, strip); }
+
+    /** Append token (bigrams) */
+    void append(const bigrams_t & bgrms, bool strip = false) { push_back(bgrms, strip); }
+
+    /** Append token with "strip" flag */
+    template <class Token>
+    void append(const std::pair<Token, bool> & token) { append(token.first, token.second); }
+
     public:
 
     /**
@@ -462,10 +1036,7 @@ class basic_sequence_matcher {
      *  \param  strip  This is a "strip" string (not a begin/end of valid sub-sequence)
      */
     void push_back(const bigrams_t & bgrms, bool strip = false) {
-        if (strip) m_strip_ixs.insert(size());
-        add_row();
-        m_mx[0].emplace_back(bgrms);
-        for (size_t i = 1; i < size(); ++i) m_mx[i].emplace_back();
+        push_back(bigrams_t(bgrms, alloc()), strip);  // copy to the arena
     }
 
     /**
@@ -475,10 +1046,23 @@ class basic_sequence_matcher {
      *  \param  strip  This is a "strip" string (not a begin/end of valid sub-sequence)
      */
     void push_back(bigrams_t && bgrms, bool strip = false) {
-        if (strip) m_strip_ixs.insert(size());
-        add_row();
-        m_mx[0].emplace_back(bgrms);
-        for (size_t i = 1; i < size(); ++i) m_mx[i].emplace_back();
+        ++m_generation;
+        const size_t back = size();
+        m_strip.push_back(strip);
+
+        // Non-strip string terminates the preceding run of strip strings
+        m_next_valid.push_back(strip ? SIZE_MAX : back);
+        if (!strip)
+            for (size_t ix = back; ix > 0 && is_strip(ix - 1); --ix)
+                m_next_valid[ix - 1] = back;
+
+        m_size_sums.push_back(m_size_sums.back() + bgrms.size());
+
+        // Append cells of sub-sequences ending with the string
+        // (the token bigrams memory is abandoned to the arena)
+        void * const mem = m_arena->allocate(sizeof(bigrams_t), alignof(bigrams_t));
+        m_cells.resize(cells(back + 1), nullptr);
+        m_cells[ix(0, back)] = new (mem) bigrams_t(std::move(bgrms));
     }
 
     /**
@@ -487,8 +1071,18 @@ class basic_sequence_matcher {
      *  \param  str    Another string in the sequence
      *  \param  strip  This is a "strip" string (not a begin/end of valid sub-sequence)
      */
-    void emplace_back(const string_t & str, bool strip = false) {
-        push_back(bigrams_t(str), strip);
+    void emplace_back(std::basic_string_view<char_t> str, bool strip = false) {
+        push_back(bigrams_t(str, alloc()), strip);
+    }
+
+    /**
+     *  \brief  Construct another UTF-8 string bigram multiset at end of sequence
+     *
+     *  \param  str    Another string in the sequence (UTF-8 encoded)
+     *  \param  strip  This is a "strip" string (not a begin/end of valid sub-sequence)
+     */
+    void emplace_back(utf8_t , std::string_view str, bool strip = false) {
+        push_back(bigrams_t(utf8, str, alloc()), strip);
     }
 
     /**
@@ -509,6 +1103,388 @@ class basic_sequence_matcher {
     /** End iterator (all possible matches iterated) */
     iterator end() { return iterator(*this, iterator::END); }
 
+    /**
+     *  \brief  Match without sub-sequence bigrams
+     *
+     *  Produces the same matches as the match iterator (see \c begin), but no bigrams
+     *  unions are computed (nor kept in the matrix); instead, each column's
+     *  sub-sequences are scored by running intersection size with the pattern
+     *  as they're extended token by token.
+     *  Use it unless the matching sub-sequences bigrams are required.
+     *
+     *  With compile-time threshold (e.g. \c std::ratio<4,5>() for 0.8), all the checks
+     *  are done in integer arithmetic; the score is only computed for matches.
+     *
+     *  \param  bgrms      Bigram multiset
+     *  \param  threshold  Sørensen-Dice coefficient (match score) threshold: positive
+     *                     \c double or \c std::ratio (compile-time threshold)
+     *  \param  sink       Match sink, called as \c sink(const sequence_match &)
+     *                     (\c pattern is 0)
+     */
+    template <class Threshold, class Sink>
+    void match(const bigrams_t & bgrms, Threshold threshold, Sink && sink) const {
+        const auto thrshld = make_threshold(threshold);
+        assert(thrshld.sdc() > 0.0);
+
+        auto isect = running_intersection(bgrms);
+
+        // Skip sub-sequences beginning with "strip" string
+        for (size_t j = skip_strip(0, size()); j < size(); j = skip_strip(j + 1, size())) {
+            size_t i_begin, i_end;
+            std::tie(i_begin, i_end) = card_rows(j, bgrms.size(), bgrms.size(), thrshld);
+            m_counters.card_pruned(size() - j - (i_end - i_begin));
+
+            isect.reset();
+            for (size_t i = 0; i < i_end; ++i) {
+                isect.add(*m_cells[ix(0, j + i)]);  // strip strings are added, too
+
+                if (i < i_begin) continue;  // sub-sequence too short
+
+                // Skip sub-sequence ending with "strip" string
+                if (is_strip(j + i)) {
+                    m_counters.strip_skipped(1);
+                    continue;
+                }
+
+                m_counters.visited();
+
+                const size_t size_sum = bigrams_size(i, j) + bgrms.size();
+                m_counters.sdc_computed();
+                if (!thrshld.accept(isect.size(), size_sum)) {  // not up to scratch
+                    m_counters.threshold_rejected();
+                    continue;
+                }
+
+                sink(sequence_match{0, j, j + i + 1,
+                    sorensen_dice_coef(isect.size(), size_sum)});
+            }
+        }
+    }
+
+    /**
+     *  \brief  Match without sub-sequence bigrams
+     *
+     *  \param  bgrms      Bigram multiset
+     *  \param  threshold  Sørensen-Dice coefficient (match score) threshold: positive
+     *                     \c double or \c std::ratio (compile-time threshold)
+     *
+     *  \return Matches (see the sink overload)
+     */
+    template <class Threshold>
+    std::vector<sequence_match> match(const bigrams_t & bgrms, Threshold threshold) const {
+        std::vector<sequence_match> matches;
+        match(bgrms, threshold, [&matches](const sequence_match & match) {
+            matches.push_back(match);
+        });
+
+        return matches;
+    }
+
+    /**
+     *  \brief  Sub-sequence bigrams
+     *
+     *  The bigrams are computed lazily and kept in the matrix (no copy is made).
+     *  The reference is valid until the sequence is modified (or, with a bounded
+     *  cache, until other sub-sequence bigrams are computed, see \c cache_budget).
+     *
+     *  \param  begin  Sub-sequence begin (index of the 1st string)
+     *  \param  end    Sub-sequence end (just past the last string)
+     *
+     *  \return Sub-sequence bigrams
+     */
+    const bigrams_t & subsequence(size_t begin, size_t end) {
+        assert(begin < end && end <= size());
+        return bigrams(end - begin - 1, begin);
+    }
+
+    /**
+     *  \brief  Match multiple patterns at once
+     *
+     *  Each candidate sub-sequence is visited once and scored against all
+     *  the patterns with acceptable cardinality ratio (its bigrams are computed
+     *  at most once for all of them).
+     *  The patterns are sorted by size, so that the acceptable ones are found
+     *  by binary search (as are the acceptable sub-sequences, see \c card_rows).
+     *  The matches are produced in ascending lexicographic order by their begin,
+     *  size and pattern index (i.e. the same as if the patterns were matched
+     *  one by one and the matches merged).
+     *
+     *  \param  pttrns     Pattern bigram multisets
+     *  \param  pttrn_cnt  Number of patterns
+     *  \param  threshold  Sørensen-Dice coefficient (match score) threshold: positive
+     *                     \c double or \c std::ratio (compile-time threshold)
+     *  \param  sink       Match sink, called as \c sink(const sequence_match &)
+     */
+    template <class Threshold, class Sink>
+    void match_all(
+        const bigrams_t * const * pttrns, size_t pttrn_cnt,
+        Threshold threshold, Sink && sink)
+    {
+        std::vector<size_t> order, pttrn_sizes;
+        sort_by_size(pttrns, pttrn_cnt, order, pttrn_sizes);
+
+        match_all(pttrns, order.data(), pttrn_sizes.data(), pttrn_cnt,
+            threshold, std::forward<Sink>(sink));
+    }
+
+    /**
+     *  \brief  Sort patterns by size (see the pre-sorted \c match_all)
+     *
+     *  \param  pttrns     Pattern bigram multisets
+     *  \param  pttrn_cnt  Number of patterns
+     *  \param  order      Pattern indices in ascending size order (stable, set)
+     *  \param  sizes      Pattern sizes in the same order (set)
+     */
+    static void sort_by_size(
+        const bigrams_t * const * pttrns, size_t pttrn_cnt,
+        std::vector<size_t> & order, std::vector<size_t> & sizes)
+    {
+        order.resize(pttrn_cnt);
+        for (size_t p = 0; p < pttrn_cnt; ++p) order[p] = p;
+        std::stable_sort(order.begin(), order.end(), [pttrns](size_t p1, size_t p2) {
+            return pttrns[p1]->size() < pttrns[p2]->size();
+        });
+
+        sizes.resize(pttrn_cnt);
+        for (size_t p = 0; p < pttrn_cnt; ++p) sizes[p] = pttrns[order[p]]->size();
+    }
+
+    /**
+     *  \brief  Match multiple patterns at once (pre-sorted by size)
+     *
+     *  Same as matching the patterns, but they're sorted in advance (see
+     *  \c sort_by_size), so that many sequences may be matched to the same
+     *  patterns without sorting them each time.
+     *
+     *  \param  pttrns     Pattern bigram multisets
+     *  \param  order      Pattern indices in ascending size order
+     *  \param  sizes      Pattern sizes (in the same order)
+     *  \param  pttrn_cnt  Number of patterns
+     *  \param  threshold  Sørensen-Dice coefficient (match score) threshold: positive
+     *                     \c double or \c std::ratio (compile-time threshold)
+     *  \param  sink       Match sink, called as \c sink(const sequence_match &)
+     */
+    template <class Threshold, class Sink>
+    void match_all(
+        const bigrams_t * const * pttrns,
+        const size_t * order, const size_t * sizes, size_t pttrn_cnt,
+        Threshold threshold, Sink && sink)
+    {
+        const auto thrshld = make_threshold(threshold);
+        match_sorted(order, sizes, pttrn_cnt, thrshld,
+            [this, pttrns, &thrshld](const bigrams_t & bgrms, size_t p) {
+                return check_sketch(bgrms, *pttrns[p], thrshld);
+            },
+            [pttrns](const bigrams_t & bgrms, size_t p) {
+                return bigrams_t::intersect_size(bgrms, *pttrns[p]);
+            },
+            std::forward<Sink>(sink));
+    }
+
+    /**
+     *  \brief  Match frozen pattern set
+     *
+     *  Same as matching the patterns as a range, but the patterns needn't be
+     *  sorted by size (the set keeps them so).
+     *  Any number of matchers may match the same set concurrently.
+     *
+     *  \param  pttrns     Pattern set
+     *  \param  threshold  Sørensen-Dice coefficient (match score) threshold: positive
+     *                     \c double or \c std::ratio (compile-time threshold)
+     *  \param  sink       Match sink, called as \c sink(const sequence_match &)
+     */
+    template <class Threshold, class Sink>
+    void match_all(
+        const basic_pattern_set<char_t> & pttrns,
+        Threshold threshold, Sink && sink)
+    {
+        using view_t = typename basic_pattern_set<char_t>::view_t;
+
+        match_sorted(pttrns.order(), pttrns.sorted_sizes(), pttrns.size(),
+            make_threshold(threshold),
+            [](const bigrams_t & , size_t ) { return true; },  // no pattern sketches
+            [&pttrns](const bigrams_t & bgrms, size_t p) {
+                return view_t::intersect_size(bgrms, pttrns.pattern(p));
+            },
+            std::forward<Sink>(sink));
+    }
+
+    /**
+     *  \brief  Match frozen pattern set
+     *
+     *  \param  pttrns     Pattern set
+     *  \param  threshold  Sørensen-Dice coefficient (match score) threshold: positive
+     *                     \c double or \c std::ratio (compile-time threshold)
+     *
+     *  \return Matches (see the sink overload)
+     */
+    template <class Threshold>
+    std::vector<sequence_match> match_all(
+        const basic_pattern_set<char_t> & pttrns, Threshold threshold)
+    {
+        std::vector<sequence_match> matches;
+        match_all(pttrns, threshold, [&matches](const sequence_match & match) {
+            matches.push_back(match);
+        });
+
+        return matches;
+    }
+
+    /**
+     *  \brief  Match multiple patterns at once
+     *
+     *  \param  patterns   Range of pattern bigram multisets
+     *  \param  threshold  Sørensen-Dice coefficient (match score) threshold: positive
+     *                     \c double or \c std::ratio (compile-time threshold)
+     *  \param  sink       Match sink, called as \c sink(const sequence_match &)
+     */
+    template <class Patterns, class Threshold, class Sink>
+    void match_all(const Patterns & patterns, Threshold threshold, Sink && sink) {
+        std::vector<const bigrams_t *> pttrns;
+        for (const auto & pattern: patterns) pttrns.push_back(&pattern);
+
+        match_all(pttrns.data(), pttrns.size(), threshold, std::forward<Sink>(sink));
+    }
+
+    /**
+     *  \brief  Match multiple patterns at once
+     *
+     *  \param  patterns   Range of pattern bigram multisets
+     *  \param  threshold  Sørensen-Dice coefficient (match score) threshold: positive
+     *                     \c double or \c std::ratio (compile-time threshold)
+     *
+     *  \return Matches (see the sink overload)
+     */
+    template <class Patterns, class Threshold>
+    std::vector<sequence_match> match_all(const Patterns & patterns, Threshold threshold) {
+        std::vector<sequence_match> matches;
+        match_all(patterns, threshold, [&matches](const sequence_match & match) {
+            matches.push_back(match);
+        });
+
+        return matches;
+    }
+
+    /** Overlapping matches policy (see \c best_matches) */
+    enum overlap_t {
+        ALLOW_OVERLAP = 0,  /**< Matches may overlap                        */
+        NO_OVERLAP,         /**< Overlapping matches are dropped (greedily) */
+    };
+
+    /**
+     *  \brief  Best matches
+     *
+     *  Finds up to \c k matches with the highest score (ties are resolved in favour
+     *  of the 1st match in the usual match order, i.e. by begin and size).
+     *  The best matches found so far are kept in a bounded heap; once it's full,
+     *  the worst score in it becomes the effective threshold, so the cardinality
+     *  ratio pruning gets stronger as better matches are found.
+     *
+     *  With \c NO_OVERLAP, the matches are selected greedily by score, dropping
+     *  those overlapping an already selected one.
+     *  Note that the threshold can't be raised in that case (unless \c k is 1):
+     *  a single better match may knock out several matches of the heap.
+     *
+     *  \param  bgrms      Bigram multiset
+     *  \param  k          Max. number of matches
+     *  \param  threshold  Sørensen-Dice coefficient (match score) threshold (positive)
+     *  \param  overlap    Overlapping matches policy
+     *
+     *  \return Matches in descending order by score (\c pattern is 0)
+     */
+    std::vector<sequence_match> best_matches(
+        const bigrams_t & bgrms,
+        size_t k,
+        double threshold = std::numeric_limits<double>::min(),
+        overlap_t overlap = ALLOW_OVERLAP)
+    {
+        assert(threshold > 0.0);
+
+        // Better match first (score, then begin and size)
+        const auto better = [](const sequence_match & m1, const sequence_match & m2) {
+            if (m1.score != m2.score) return m1.score > m2.score;
+            if (m1.begin != m2.begin) return m1.begin < m2.begin;
+            return m1.end < m2.end;
+        };
+
+        std::vector<sequence_match> best;  // heap with the worst match on top
+        if (0 == k) return best;
+
+        const bool bounded = ALLOW_OVERLAP == overlap || 1 == k;
+        auto thrshld = dynamic_threshold(threshold);
+
+        // Skip sub-sequences beginning or ending with "strip" string
+        for (size_t j = skip_strip(0, size()); j < size(); j = skip_strip(j + 1, size())) {
+            size_t i, i_end;
+            std::tie(i, i_end) = card_rows(j, bgrms.size(), bgrms.size(), thrshld);
+            m_counters.card_pruned(size() - j - (i_end - i));
+
+            for (i = skip_strip(j + i, j + i_end) - j; i < i_end;
+                i = skip_strip(j + i + 1, j + i_end) - j)
+            {
+                m_counters.visited();
+
+                // The threshold may have been raised meanwhile
+                const auto card_check = thrshld.check_cardinality(
+                    bigrams_size(i, j), bgrms.size());
+
+                if (CARD_SHORT == card_check) {  // try longer sub-sequence
+                    m_counters.card_pruned(1);
+                    continue;
+                }
+                if (CARD_LONG == card_check) {  // no point in extending it
+                    m_counters.card_pruned(i_end - i);
+                    break;
+                }
+
+                const auto & subseq = bigrams(i, j);
+                if (!check_sketch(subseq, bgrms, thrshld)) continue;
+
+                const double sdc = bigrams_t::sorensen_dice_coef(subseq, bgrms);
+                m_counters.sdc_computed();
+                if (sdc < threshold) {  // not up to scratch
+                    m_counters.threshold_rejected();
+                    continue;
+                }
+
+                if (bounded && best.size() == k) {
+                    if (!(sdc > best.front().score)) continue;  // not better
+
+                    std::pop_heap(best.begin(), best.end(), better);
+                    best.pop_back();
+                }
+
+                best.push_back(sequence_match{0, j, j + i + 1, sdc});
+                std::push_heap(best.begin(), best.end(), better);
+
+                // Raise the threshold
+                if (bounded && best.size() == k && best.front().score > threshold) {
+                    threshold = best.front().score;
+                    thrshld = dynamic_threshold(threshold);
+                }
+            }
+        }
+
+        std::sort_heap(best.begin(), best.end(), better);
+        if (bounded) return best;
+
+        // Greedy selection of non-overlapping matches
+        std::vector<sequence_match> selected;
+        for (const auto & match: best) {
+            const bool overlaps = std::any_of(selected.cbegin(), selected.cend(),
+                [&match](const sequence_match & sel) {
+                    return match.begin < sel.end && sel.begin < match.end;
+                });
+
+            if (overlaps) continue;
+
+            selected.push_back(match);
+            if (selected.size() == k) break;
+        }
+
+        return selected;
+    }
+
     private:
 
     /**
@@ -534,6 +1510,124 @@ class basic_sequence_matcher {
         i2 = i - i2;
     }
 
+    /**
+     *  \brief  Match multiple patterns sorted by size (see \c match_all)
+     *
+     *  \param  order      Pattern indices in ascending size order
+     *  \param  sizes      Pattern sizes (in the same order)
+     *  \param  pttrn_cnt  Number of patterns
+     *  \param  threshold  Matching threshold (positive, see \c make_threshold)
+     *  \param  check      Pre-check (see \c check_sketch), called as
+     *                     \c check(const bigrams_t &, pattern_index)
+     *  \param  isect      Intersection size, called as
+     *                     \c isect(const bigrams_t &, pattern_index)
+     *  \param  sink       Match sink, called as \c sink(const sequence_match &)
+     */
+    template <class Threshold, class Check, class Isect, class Sink>
+    void match_sorted(
+        const size_t * order, const size_t * sizes, size_t pttrn_cnt,
+        const Threshold & threshold, Check && check, Isect && isect, Sink && sink)
+    {
+        assert(threshold.sdc() > 0.0);
+
+        if (0 == pttrn_cnt) return;
+
+        const size_t * const sizes_end = sizes + pttrn_cnt;
+
+        std::vector<sequence_match> matches;  // sub-sequence matches (to be ordered)
+
+        // Skip sub-sequences beginning or ending with "strip" string
+        for (size_t j = skip_strip(0, size()); j < size(); j = skip_strip(j + 1, size())) {
+            size_t i, i_end;
+            std::tie(i, i_end) = card_rows(j, sizes[0], sizes[pttrn_cnt - 1], threshold);
+            m_counters.card_pruned(size() - j - (i_end - i));
+
+            for (i = skip_strip(j + i, j + i_end) - j; i < i_end;
+                i = skip_strip(j + i + 1, j + i_end) - j)
+            {
+                m_counters.visited();
+
+                const size_t subseq_size = bigrams_size(i, j);
+
+                // Patterns which are not too small nor too big
+                const auto pttrns_begin = std::partition_point(
+                    sizes, sizes_end, [&](size_t pttrn_size) {
+                        return CARD_LONG == threshold.check_cardinality(
+                            subseq_size, pttrn_size);
+                    });
+                const auto pttrns_end = std::partition_point(
+                    pttrns_begin, sizes_end, [&](size_t pttrn_size) {
+                        return CARD_SHORT != threshold.check_cardinality(
+                            subseq_size, pttrn_size);
+                    });
+
+                // Obtained lazily (once per sub-sequence) so that cache stats aren't skewed
+                const bigrams_t * subseq = nullptr;
+
+                for (auto pttrn = pttrns_begin; pttrn != pttrns_end; ++pttrn) {
+                    const size_t p = order[pttrn - sizes];
+                    if (!subseq) subseq = &bigrams(i, j);
+                    if (!check(*subseq, p)) continue;  // can't reach the threshold
+
+                    const size_t isect_size = isect(*subseq, p);
+                    const size_t size_sum = subseq_size + *pttrn;
+                    m_counters.sdc_computed();
+
+                    if (!threshold.accept(isect_size, size_sum)) {  // not up to scratch
+                        m_counters.threshold_rejected();
+                        continue;
+                    }
+
+                    matches.push_back(sequence_match{p, j, j + i + 1,
+                        sorensen_dice_coef(isect_size, size_sum)});
+                }
+
+                // Report in pattern index order
+                std::sort(matches.begin(), matches.end(),
+                    [](const sequence_match & m1, const sequence_match & m2) {
+                        return m1.pattern < m2.pattern;
+                    });
+
+                for (const auto & match: matches) sink(match);
+                matches.clear();
+            }
+        }
+    }
+
+    /**
+     *  \brief  Rows of column with acceptable cardinality ratio
+     *
+     *  Sub-sequence bigram sizes grow with the row index, so the sub-sequences
+     *  which are neither too short for the smallest pattern nor too long for
+     *  the biggest one form a contiguous range of rows.
+     *  It's found by binary search over the bigram size prefix sums.
+     *
+     *  \param  j          Column index
+     *  \param  min_size   Smallest pattern size
+     *  \param  max_size   Biggest pattern size
+     *  \param  threshold  Matching threshold (see \c make_threshold)
+     *
+     *  \return Row range [begin, end)
+     */
+    template <class Threshold>
+    std::tuple<size_t, size_t> card_rows(
+        size_t j, size_t min_size, size_t max_size, const Threshold & threshold) const
+    {
+        const size_t base = m_size_sums[j];
+        const auto rows = m_size_sums.cbegin() + j + 1;
+
+        const auto rows_begin = std::partition_point(rows, m_size_sums.cend(),
+            [&](size_t size_sum) {
+                return CARD_SHORT == threshold.check_cardinality(size_sum - base, min_size);
+            });
+        const auto rows_end = std::partition_point(rows_begin, m_size_sums.cend(),
+            [&](size_t size_sum) {
+                return CARD_LONG != threshold.check_cardinality(size_sum - base, max_size);
+            });
+
+        return std::make_tuple(rows_begin - rows, rows_end - rows);
+    }
+
     /**
      *  \brief  Bigrams size
      *
@@ -542,20 +1636,9 @@ class basic_sequence_matcher {
      *
      *  \return Size of bigrams at [i,j]
      */
-    size_t bigrams_size(size_t i, size_t j) {
-        assert(i < size());
-        auto & row = m_mx[i];
-
-        assert(j < row.size());
-        auto & cell = row[j];
-
-        if (cell.content() != mx_cell::NONE) return cell.size();  // size already known
-
-        size_t i1, j1, i2, j2; sub_ix(i, j, i1, j1, i2, j2);
-        size_t result = bigrams_size(i1, j1) + bigrams_size(i2, j2);
-
-        cell.set_size(result);  // cache for the next time
-        return result;
+    size_t bigrams_size(size_t i, size_t j) const {
+        assert(i + j < size());
+        return m_size_sums[j + i + 1] - m_size_sums[j];
     }
 
     /**
@@ -567,24 +1650,67 @@ class basic_sequence_matcher {
      *  \return Bigrams at [i,j]
      */
     const bigrams_t & bigrams(size_t i, size_t j) {
-        assert(i < size());
-        auto & row = m_mx[i];
+        assert(i + j < size());
+        const size_t c = ix(i, j);
+        auto & cell = m_cells[c];
+
+        if (0 == i) return *cell;  // token bigrams
 
-        assert(j < row.size());
-        auto & cell = row[j];
+        if (cell) {
+            ++m_stats.hits;
+            return *cell;
+        }
 
-        if (cell.content() != mx_cell::BIGRAMS) {  // bigrams not computed yet
+        // Bigrams not computed yet (nothing is evicted until the union is done)
+        ++m_stats.misses;
+        const size_t allocated = m_arena->allocated();
+        ++m_depth;
+        const auto & shorter = m_cells[ix(i - 1, j)];
+        if (shorter) {  // extend the sub-sequence by one token
+            cell = new_cell(cell_alloc(), *shorter, *m_cells[ix(0, j + i)]);
+        }
+        else {
             size_t i1, j1, i2, j2; sub_ix(i, j, i1, j1, i2, j2);
-            cell.set_bigrams(bigrams(i1, j1) + bigrams(i2, j2));
+            cell = new_cell(cell_alloc(), bigrams(i1, j1), bigrams(i2, j2));
         }
+        --m_depth;
+
+        m_counters.united();
+        if (0 == m_depth) m_counters.allocated(m_arena->allocated() - allocated);
+
+        (0 == ((i + 1) & i) ? m_halving : m_evictable).push_back(c);
+        if (0 == m_depth) evict(c);
+
+        return *cell;
+    }
+
+    /**
+     *  \brief  Evict cached cells over the budget
+     *
+     *  Cells of other than power-of-two lengths are evicted first, the oldest first.
+     *
+     *  \param  keep  Cell index to keep (the one just computed)
+     */
+    void evict(size_t keep) {
+        while (cache_size() > m_budget) {
+            auto & queue = !m_evictable.empty() && m_evictable.front() != keep
+                ? m_evictable : m_halving;
+
+            if (queue.empty() || queue.front() == keep) break;
+
+            auto & cell = m_cells[queue.front()];
+            queue.pop_front();
 
-        return cell.bigrams();
+            delete_cell(cell);
+            ++m_stats.evictions;
+            ++m_generation;
+        }
     }
 
 };  // end of template class basic_sequence_matcher
 
-template <class Bigrams>
-const Bigrams basic_sequence_matcher<Bigrams>::iterator::s_empty_bigrams;
+template <class Bigrams, class Stats>
+const Bigrams basic_sequence_matcher<Bigrams, Stats>::iterator::s_empty_bigrams;
 
 
 /**
@@ -592,49 +1718,38 @@ const Bigrams basic_sequence_matcher<Bigrams>::iterator::s_empty_bigrams;
  *
  *  \tparam  Char     Character type
  *  \tparam  Bigrams  Bigrams type (not really used)
+ *  \tparam  Stats    Matching statistics policy (ditto)
  *
  *  \param  out    Output stream
  *  \param  match  Match iterator
  */
-template <typename Char, class Bigrams>
+template <typename Char, class Bigrams, class Stats = no_match_counters>
 void serialise_match (
     std::basic_ostream<Char> & out,
-    const typename basic_sequence_matcher<Bigrams>::iterator & match)
+    const typename basic_sequence_matcher<Bigrams, Stats>::iterator & match)
 {
-    out << "match(begin: " << match.begin()
-        << ", end: " << match.end()
-        << ", size: " << match.size()
-        << ", SDC: " << match.sorensen_dice_coef()
-        //<< ", " << *match
-        << ")";
+    out << match;
 }
 
 
 /**< ASCII/ANSI string sequence matcher */
 using sequence_matcher = basic_sequence_matcher<bigrams>;
 
-/** Match serialisation operator */
-template <typename Char>
-std::basic_ostream<Char> & operator << (
-    std::basic_ostream<Char> & out,
-    const sequence_matcher::iterator & match)
-{
-    serialise_match<Char, sequence_matcher::bigrams_t>(out, match);
-    return out;
-}
-
 /**< UNICODE string sequence matcher */
 using wsequence_matcher = basic_sequence_matcher<wbigrams>;
 
-/** Match serialisation operator */
-template <typename Char>
-std::basic_ostream<Char> & operator << (
-    std::basic_ostream<Char> & out,
-    const wsequence_matcher::iterator & match)
-{
-    serialise_match<Char, wsequence_matcher::bigrams_t>(out, match);
-    return out;
-}
+
+/**< ASCII/ANSI string sequence matcher (flat bigrams storage) */
+using flat_sequence_matcher = basic_sequence_matcher<flat_bigrams>;
+
+/**< UNICODE string sequence matcher (flat bigrams storage) */
+using wflat_sequence_matcher = basic_sequence_matcher<wflat_bigrams>;
+
+/** ASCII/ANSI string sequence matcher (flat bigrams with sketches) */
+using sketched_sequence_matcher = basic_sequence_matcher<sketched_bigrams>;
+
+/** UNICODE string sequence matcher (flat bigrams with sketches) */
+using wsketched_sequence_matcher = basic_sequence_matcher<wsketched_bigrams>;
 
 }  // end of namespace libsdcxx
 
@@ -0,0 +1,832 @@
+#ifndef libsdcxx__sharded_pattern_set_hxx
+#define libsdcxx__sharded_pattern_set_hxx
+
+/**
+ *  \file
+ *  \brief  Sharded pattern set (pattern dictionary partitioned for distributed matching)
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sequence_matcher.hxx"
+#include "pattern_set.hxx"
+#include "parallel_matcher.hxx"
+#include "bigram_index.hxx"
+#include "bigram_storage.hxx"
+#include "binary.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <cassert>
+#include <string>
+#include <fstream>
+#include <ostream>
+#include <system_error>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+
+namespace libsdcxx {
+
+/**
+ *  \brief  Match order (as produced by \c basic_sequence_matcher)
+ *
+ *  Ascending lexicographic order by begin, end (i.e. size) and pattern index.
+ *  Note that the score is a function of the other members, so it's not needed
+ *  for the order to be total.
+ */
+inline bool match_precedes(const sequence_match & m1, const sequence_match & m2) {
+    if (m1.begin != m2.begin) return m1.begin < m2.begin;
+    if (m1.end != m2.end) return m1.end < m2.end;
+    return m1.pattern < m2.pattern;
+}
+
+/** Corpus match order (by sequence index, then as \c sequence_match) */
+inline bool match_precedes(const corpus_match & m1, const corpus_match & m2) {
+    if (m1.sequence != m2.sequence) return m1.sequence < m2.sequence;
+    return match_precedes(m1.match, m2.match);
+}
+
+/** Index lookup match order (by entry ID) */
+inline bool match_precedes(const bigram_index_match & m1, const bigram_index_match & m2) {
+    return m1.entry < m2.entry;
+}
+
+
+/**
+ *  \brief  Merge match streams
+ *
+ *  Deterministic k-way merge of match streams, each in match order (see
+ *  \c match_precedes), e.g. answers of pattern shards.
+ *  Provided that the streams' pattern indices are disjoint, the result doesn't
+ *  depend on the streams order and is exactly the same as if all the patterns
+ *  were matched at once.
+ *
+ *  \tparam  Match  Match record (\c sequence_match, \c corpus_match
+ *                  or \c bigram_index_match)
+ *
+ *  \param  streams  Match streams
+ *  \param  sink     Match sink, called as \c sink(const Match &)
+ */
+template <class Match, class Sink>
+void merge_matches(const std::vector<std::vector<Match>> & streams, Sink && sink) {
+    using cursor = std::pair<const Match *, const Match *>;  // [current, end)
+
+    std::vector<cursor> heap;
+    for (const auto & stream: streams)
+        if (!stream.empty())
+            heap.emplace_back(stream.data(), stream.data() + stream.size());
+
+    const auto follows = [](const cursor & c1, const cursor & c2) {
+        return match_precedes(*c2.first, *c1.first);
+    };
+    std::make_heap(heap.begin(), heap.end(), follows);
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), follows);
+        auto & top = heap.back();
+
+        assert(top.first + 1 == top.second || !match_precedes(top.first[1], top.first[0]));
+        sink(*top.first);
+
+        if (++top.first == top.second)
+            heap.pop_back();
+        else
+            std::push_heap(heap.begin(), heap.end(), follows);
+    }
+}
+
+/**
+ *  \brief  Merge match streams
+ *
+ *  \param  streams  Match streams (see the sink overload)
+ *
+ *  \return Merged matches
+ */
+template <class Match>
+std::vector<Match> merge_matches(const std::vector<std::vector<Match>> & streams) {
+    size_t match_cnt = 0;
+    for (const auto & stream: streams) match_cnt += stream.size();
+
+    std::vector<Match> matches;
+    matches.reserve(match_cnt);
+    merge_matches(streams, [&matches](const Match & match) { matches.push_back(match); });
+
+    return matches;
+}
+
+
+namespace binary {
+
+constexpr char matches_magic[4] = { 'S', 'D', 'C', 'M' };   /**< Matches magic  */
+constexpr unsigned char matches_version = 1;                /**< Matches format */
+
+}  // end of namespace binary
+
+
+/**
+ *  \brief  Corpus matches binary serialisation
+ *
+ *  Compact, versioned match stream (e.g. a shard answer sent to another host):
+ *  magic \c SDCM, format version byte, varint of the match count, then per match
+ *  varints of the sequence index delta, begin (delta if the sequence is the same),
+ *  size and pattern index, followed by the score (IEEE 754 double, little endian).
+ *  The integers are independent of the host \c size_t, byte order etc.
+ *
+ *  \param  matches  Matches in match order (see \c match_precedes)
+ *
+ *  \return Binary representation
+ */
+inline std::string serialise_matches(const std::vector<corpus_match> & matches) {
+    std::string out(binary::matches_magic, sizeof(binary::matches_magic));
+    out += static_cast<char>(binary::matches_version);
+
+    binary::put_varint(out, matches.size());
+
+    size_t sequence = 0, begin = 0;
+    for (const auto & cmatch: matches) {
+        assert(sequence <= cmatch.sequence);
+        if (sequence != cmatch.sequence) begin = 0;
+        assert(begin <= cmatch.match.begin && cmatch.match.begin < cmatch.match.end);
+
+        binary::put_varint(out, cmatch.sequence - sequence);
+        binary::put_varint(out, cmatch.match.begin - begin);
+        binary::put_varint(out, cmatch.match.end - cmatch.match.begin);
+        binary::put_varint(out, cmatch.match.pattern);
+
+        uint64_t score;
+        std::memcpy(&score, &cmatch.match.score, sizeof(score));
+        for (size_t i = 0; i < sizeof(score); ++i, score >>= 8)
+            out += static_cast<char>(score & 0xff);
+
+        sequence = cmatch.sequence;
+        begin = cmatch.match.begin;
+    }
+
+    return out;
+}
+
+
+/**
+ *  \brief  Corpus matches binary deserialisation (see \c serialise_matches)
+ *
+ *  \param  data  Binary representation
+ *  \param  size  Binary representation size
+ *
+ *  \return Matches
+ */
+inline std::vector<corpus_match> deserialise_matches(const void * data, size_t size) {
+    const auto * ptr = static_cast<const unsigned char *>(data);
+    const auto * const end = ptr + size;
+
+    const size_t header_size = sizeof(binary::matches_magic) + 1;
+    if (size < header_size ||
+        0 != std::memcmp(ptr, binary::matches_magic, sizeof(binary::matches_magic)))
+        throw binary_format_error("not a matches binary");
+
+    ptr += sizeof(binary::matches_magic);
+    if (binary::matches_version != *ptr++)
+        throw binary_format_error("unsupported matches binary version");
+
+    const uint64_t match_cnt = binary::get_varint(ptr, end);
+    if (match_cnt > static_cast<size_t>(end - ptr) / 12)  // 4 varints & score at least
+        throw binary_format_error("truncated matches binary");
+
+    std::vector<corpus_match> matches;
+    matches.reserve(match_cnt);
+
+    size_t sequence = 0, begin = 0;
+    for (uint64_t m = 0; m < match_cnt; ++m) {
+        const uint64_t sequence_delta = binary::get_varint(ptr, end);
+        if (sequence_delta) begin = 0;
+        sequence += sequence_delta;
+        begin += binary::get_varint(ptr, end);
+        const uint64_t match_size = binary::get_varint(ptr, end);
+        const uint64_t pattern = binary::get_varint(ptr, end);
+        if (0 == match_size) throw binary_format_error("empty match");
+
+        if (static_cast<size_t>(end - ptr) < sizeof(uint64_t))
+            throw binary_format_error("truncated matches binary");
+
+        uint64_t score = 0;
+        for (size_t i = 0; i < sizeof(score); ++i)
+            score |= static_cast<uint64_t>(*ptr++) << (8 * i);
+
+        corpus_match cmatch = { sequence, { pattern, begin, begin + match_size, 0.0 } };
+        std::memcpy(&cmatch.match.score, &score, sizeof(score));
+        matches.push_back(cmatch);
+    }
+
+    return matches;
+}
+
+
+/**
+ *  \brief  Pattern shard
+ *
+ *  Part of a pattern dictionary: frozen pattern set (see \c basic_pattern_set)
+ *  of the shard patterns and their (global) pattern IDs in ascending order.
+ *  Shard matches are reported with the global IDs, in match order, so that
+ *  answers of all the shards may be merged by \c merge_matches (on any host).
+ *
+ *  The shard file is the pattern set file followed by the IDs section (magic,
+ *  ID count and the IDs, all 64 bit in the set byte order); it may be loaded
+ *  (or mapped) as a pattern set, too.
+ *
+ *  \tparam  Char  Character type
+ */
+template <typename Char>
+class basic_pattern_shard {
+    public:
+
+    using char_t = Char;                                    /**< Character type */
+    using pattern_set_t = basic_pattern_set<char_t>;        /**< Pattern set    */
+    using indexing_t = typename pattern_set_t::indexing_t;  /**< Indexing       */
+
+    private:
+
+    static constexpr char ids_magic[8] = { 'S', 'D', 'C', 'X', 'X', 'S', 'I', '\0' };
+
+    pattern_set_t m_patterns;   /**< Shard patterns                     */
+    std::vector<size_t> m_ids;  /**< Pattern IDs (ascending)            */
+
+    /** Check pattern IDs */
+    void check_ids() const {
+        if (m_ids.size() != m_patterns.size())
+            throw binary_format_error("pattern shard ID count mismatch");
+
+        for (size_t p = 1; p < m_ids.size(); ++p)
+            if (!(m_ids[p - 1] < m_ids[p]))
+                throw binary_format_error("pattern shard IDs aren't ascending");
+    }
+
+    /** Read pattern IDs section */
+    void read_ids(const std::byte * data, size_t size) {
+        uint64_t id_cnt;
+        if (size < sizeof(ids_magic) + sizeof(id_cnt) ||
+            0 != std::memcmp(data, ids_magic, sizeof(ids_magic)))
+            throw binary_format_error("not a pattern shard");
+
+        std::memcpy(&id_cnt, data + sizeof(ids_magic), sizeof(id_cnt));
+        data += sizeof(ids_magic) + sizeof(id_cnt);
+        size -= sizeof(ids_magic) + sizeof(id_cnt);
+        if (id_cnt > size / sizeof(uint64_t))
+            throw binary_format_error("truncated pattern shard IDs");
+
+        m_ids.resize(id_cnt);
+        for (auto & id: m_ids) {
+            uint64_t id64;
+            std::memcpy(&id64, data, sizeof(id64));
+            data += sizeof(id64);
+            id = id64;
+        }
+
+        check_ids();
+    }
+
+    /** Constructor (from loaded pattern set, IDs are read later) */
+    explicit basic_pattern_shard(pattern_set_t && patterns):
+        m_patterns(std::move(patterns))
+    {}
+
+    public:
+
+    /** Empty shard */
+    basic_pattern_shard() = default;
+
+    /**
+     *  \brief  Constructor (freeze shard patterns)
+     *
+     *  \param  patterns  Range of the shard pattern bigram multisets
+     *  \param  ids       Pattern IDs (for each pattern, in ascending order)
+     *  \param  indexing  Build inverted index
+     */
+    template <class Patterns>
+    basic_pattern_shard(
+        const Patterns & patterns, std::vector<size_t> ids,
+        indexing_t indexing = pattern_set_t::NO_INDEX)
+    :
+        m_patterns(patterns, indexing),
+        m_ids(std::move(ids))
+    {
+        assert(m_ids.size() == m_patterns.size());
+        assert(std::is_sorted(m_ids.begin(), m_ids.end()));
+    }
+
+    /** Number of patterns */
+    size_t size() const { return m_patterns.size(); }
+
+    /** Shard pattern set (local pattern indices) */
+    const pattern_set_t & patterns() const { return m_patterns; }
+
+    /** Pattern IDs (by local pattern index) */
+    const std::vector<size_t> & ids() const { return m_ids; }
+
+    /**
+     *  \brief  Save the shard (see \c map and \c load)
+     *
+     *  \param  out  Output stream (binary)
+     */
+    void save(std::ostream & out) const {
+        m_patterns.save(out);
+
+        const uint64_t id_cnt = m_ids.size();
+        out.write(ids_magic, sizeof(ids_magic));
+        out.write(reinterpret_cast<const char *>(&id_cnt), sizeof(id_cnt));
+        for (const auto id: m_ids) {
+            const uint64_t id64 = id;
+            out.write(reinterpret_cast<const char *>(&id64), sizeof(id64));
+        }
+    }
+
+    /**
+     *  \brief  Save the shard to file
+     *
+     *  \param  path  File path
+     */
+    void save(const std::string & path) const {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        save(out);
+        out.close();
+        if (!out) throw std::system_error(errno, std::generic_category(), path);
+    }
+
+    /**
+     *  \brief  Use saved shard in place (see \c basic_pattern_set::map)
+     *
+     *  \param  data      Saved shard (aligned to \c pattern_set_t::alignment bytes)
+     *  \param  size      Saved shard size
+     *  \param  indexing  Build inverted index
+     *
+     *  \return Pattern shard
+     */
+    static basic_pattern_shard map(
+        const void * data, size_t size,
+        indexing_t indexing = pattern_set_t::NO_INDEX)
+    {
+        basic_pattern_shard shard(pattern_set_t::map(data, size, indexing));
+
+        const size_t ids_offset = pattern_set_t::alignment + shard.m_patterns.blob_size();
+        shard.read_ids(static_cast<const std::byte *>(data) + ids_offset, size - ids_offset);
+
+        return shard;
+    }
+
+    /**
+     *  \brief  Load saved shard (see \c basic_pattern_set::load)
+     *
+     *  \param  path      File path
+     *  \param  indexing  Build inverted index
+     *
+     *  \return Pattern shard
+     */
+    static basic_pattern_shard load(
+        const std::string & path,
+        indexing_t indexing = pattern_set_t::NO_INDEX)
+    {
+        basic_pattern_shard shard(pattern_set_t::load(path, indexing));
+
+        std::ifstream in(path, std::ios::binary);
+        in.seekg(pattern_set_t::alignment + shard.m_patterns.blob_size());
+        const std::string ids(
+            std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>{});
+        if (in.bad()) throw std::system_error(errno, std::generic_category(), path);
+
+        shard.read_ids(reinterpret_cast<const std::byte *>(ids.data()), ids.size());
+
+        return shard;
+    }
+
+    /**
+     *  \brief  Match the shard patterns (see \c basic_sequence_matcher::match_all)
+     *
+     *  \param  matcher    Sequence matcher (with the sequence assigned)
+     *  \param  threshold  Sørensen-Dice coefficient (match score) threshold: positive
+     *                     \c double or \c std::ratio (compile-time threshold)
+     *  \param  sink       Match sink, called as \c sink(const sequence_match &)
+     *                     (pattern IDs are global)
+     */
+    template <class Matcher, class Threshold, class Sink>
+    void match_all(Matcher & matcher, Threshold threshold, Sink && sink) const {
+        matcher.match_all(m_patterns, threshold, [this, &sink](const sequence_match & match) {
+            sink(sequence_match{m_ids[match.pattern], match.begin, match.end, match.score});
+        });
+    }
+
+    /**
+     *  \brief  Match the shard patterns
+     *
+     *  \param  matcher    Sequence matcher (with the sequence assigned)
+     *  \param  threshold  Sørensen-Dice coefficient (match score) threshold: positive
+     *                     \c double or \c std::ratio (compile-time threshold)
+     *
+     *  \return Matches in match order (see the sink overload)
+     */
+    template <class Matcher, class Threshold>
+    std::vector<sequence_match> match_all(Matcher & matcher, Threshold threshold) const {
+        std::vector<sequence_match> matches;
+        match_all(matcher, threshold, [&matches](const sequence_match & match) {
+            matches.push_back(match);
+        });
+
+        return matches;
+    }
+
+    /**
+     *  \brief  Answer batch query
+     *
+     *  Sequences of the batch are assigned to the matcher one by one and matched
+     *  to the shard patterns.
+     *
+     *  \param  matcher    Sequence matcher (re-used for all the sequences)
+     *  \param  batch      Range of token sequences (as taken by \c matcher.assign)
+     *  \param  threshold  Sørensen-Dice coefficient (match score) threshold: positive
+     *                     \c double or \c std::ratio (compile-time threshold)
+     *  \param  sink       Match sink, called as \c sink(const corpus_match &)
+     *                     (pattern IDs are global)
+     */
+    template <class Matcher, class Batch, class Threshold, class Sink>
+    void match_batch(
+        Matcher & matcher, const Batch & batch,
+        Threshold threshold, Sink && sink) const
+    {
+        size_t seq = 0;
+        for (const auto & sequence: batch) {
+            matcher.assign(std::begin(sequence), std::end(sequence));
+            match_all(matcher, threshold, [seq, &sink](const sequence_match & match) {
+                sink(corpus_match{seq, match});
+            });
+            ++seq;
+        }
+    }
+
+    /**
+     *  \brief  Answer batch query
+     *
+     *  \param  matcher    Sequence matcher (re-used for all the sequences)
+     *  \param  batch      Range of token sequences (as taken by \c matcher.assign)
+     *  \param  threshold  Sørensen-Dice coefficient (match score) threshold: positive
+     *                     \c double or \c std::ratio (compile-time threshold)
+     *
+     *  \return Matches in match order (may be serialised by \c serialise_matches)
+     */
+    template <class Matcher, class Batch, class Threshold>
+    std::vector<corpus_match> match_batch(
+        Matcher & matcher, const Batch & batch, Threshold threshold) const
+    {
+        std::vector<corpus_match> matches;
+        match_batch(matcher, batch, threshold, [&matches](const corpus_match & cmatch) {
+            matches.push_back(cmatch);
+        });
+
+        return matches;
+    }
+
+    /**
+     *  \brief  Threshold lookup (requires the inverted index)
+     *
+     *  \param  query      Query bigrams
+     *  \param  threshold  Matching score (SDC) threshold (positive)
+     *
+     *  \return Matches (in ascending pattern ID order)
+     */
+    template <class Storage>
+    std::vector<bigram_index_match> lookup(
+        const basic_bigrams<char_t, Storage> & query,
+        double threshold) const
+    {
+        auto matches = m_patterns.lookup(query, threshold);
+        for (auto & match: matches) match.entry = m_ids[match.entry];
+
+        return matches;
+    }
+
+};  // end of template class basic_pattern_shard
+
+
+/**
+ *  \brief  Sharded pattern set
+ *
+ *  Pattern dictionary partitioned to shards (see \c basic_pattern_shard), which
+ *  may be saved and matched independently (by other threads, processes or hosts).
+ *  Pattern IDs are the pattern indices in the dictionary.
+ *
+ *  Patterns may be sharded by their content hash (i.e. each pattern's shard
+ *  only depends on the pattern itself and the number of shards, see \c shard_of)
+ *  or by cardinality ranges (each shard has patterns of similar sizes, so
+ *  sub-sequences with unacceptable cardinality ratio are pruned by the shard
+ *  matching as a whole).
+ *
+ *  Matching the set (in process) matches all the shards and merges their matches;
+ *  the result is exactly the same as matching the patterns at once.
+ *
+ *  \tparam  Char  Character type
+ */
+template <typename Char>
+class basic_sharded_pattern_set {
+    public:
+
+    using char_t = Char;                                    /**< Character type */
+    using shard_t = basic_pattern_shard<char_t>;            /**< Pattern shard  */
+    using pattern_set_t = typename shard_t::pattern_set_t;  /**< Pattern set    */
+    using indexing_t = typename shard_t::indexing_t;        /**< Indexing       */
+
+    /** Sharding (of patterns) */
+    enum sharding_t {
+        HASH_SHARDING = 0,  /**< By pattern content hash    */
+        SIZE_SHARDING,      /**< By cardinality ranges      */
+    };
+
+    private:
+
+    /** Range of patterns given by pointers (shard patterns) */
+    template <class Pattern>
+    class indirect_range {
+        private:
+
+        const Pattern * const * m_begin;    /**< Begin  */
+        const Pattern * const * m_end;      /**< End    */
+
+        public:
+
+        /** Range iterator */
+        class iterator {
+            private:
+
+            const Pattern * const * m_ptr;  /**< Pattern pointer */
+
+            public:
+
+            explicit iterator(const Pattern * const * ptr): m_ptr(ptr) {}
+
+            const Pattern & operator * () const { return **m_ptr; }
+
+            iterator & operator ++ () { ++m_ptr; return *this; }
+
+            bool operator != (const iterator & other) const { return m_ptr != other.m_ptr; }
+
+        };  // end of class iterator
+
+        indirect_range(const Pattern * const * begin, const Pattern * const * end):
+            m_begin(begin), m_end(end)
+        {}
+
+        iterator begin() const { return iterator(m_begin); }
+        iterator end() const { return iterator(m_end); }
+
+    };  // end of template class indirect_range
+
+    std::vector<shard_t> m_shards;  /**< Shards             */
+    size_t m_size = 0;              /**< Number of patterns */
+
+    public:
+
+    /**
+     *  \brief  Pattern content hash shard
+     *
+     *  Hash of the pattern's [packed key, count] pairs (FNV-1a, finalised).
+     *
+     *  \param  pattern    Pattern bigram multiset (of any storage)
+     *  \param  shard_cnt  Number of shards
+     *
+     *  \return Pattern shard index
+     */
+    template <class Pattern>
+    static size_t shard_of(const Pattern & pattern, size_t shard_cnt) {
+        using key_traits = bigram_key<char_t>;
+
+        uint64_t hash = 0xcbf29ce484222325;
+        for (const auto & bigram_cnt: pattern) {
+            hash = (hash ^ key_traits::pack(std::get<0>(bigram_cnt))) * 0x100000001b3;
+            hash = (hash ^ std::get<1>(bigram_cnt)) * 0x100000001b3;
+        }
+
+        hash ^= hash >> 33;  // low bits depend on all the bits
+        hash *= 0xff51afd7ed558ccd;
+        hash ^= hash >> 33;
+
+        return hash % shard_cnt;
+    }
+
+    /** Empty set */
+    basic_sharded_pattern_set() = default;
+
+    /**
+     *  \brief  Constructor (shard patterns)
+     *
+     *  \param  patterns   Range of pattern bigram multisets (of any storage)
+     *  \param  shard_cnt  Number of shards (positive)
+     *  \param  sharding   Sharding method
+     *  \param  indexing   Build inverted indices (of the shards)
+     */
+    template <class Patterns>
+    basic_sharded_pattern_set(
+        const Patterns & patterns, size_t shard_cnt,
+        sharding_t sharding = HASH_SHARDING,
+        indexing_t indexing = pattern_set_t::NO_INDEX)
+    {
+        using pattern_t = std::decay_t<decltype(*std::begin(patterns))>;
+
+        assert(shard_cnt > 0);
+
+        std::vector<const pattern_t *> pttrns;
+        for (const auto & pattern: patterns) pttrns.push_back(&pattern);
+        m_size = pttrns.size();
+
+        // Pattern IDs of the shards
+        std::vector<std::vector<size_t>> shard_ids(shard_cnt);
+        switch (sharding) {
+            case HASH_SHARDING:
+                for (size_t p = 0; p < m_size; ++p)
+                    shard_ids[shard_of(*pttrns[p], shard_cnt)].push_back(p);
+                break;
+
+            case SIZE_SHARDING: {
+                std::vector<size_t> order(m_size);
+                for (size_t p = 0; p < m_size; ++p) order[p] = p;
+                std::stable_sort(order.begin(), order.end(), [&pttrns](size_t p1, size_t p2) {
+                    return pttrns[p1]->size() < pttrns[p2]->size();
+                });
+
+                for (size_t s = 0; s < shard_cnt; ++s) {
+                    auto & ids = shard_ids[s];
+                    ids.assign(
+                        order.begin() + m_size * s / shard_cnt,
+                        order.begin() + m_size * (s + 1) / shard_cnt);
+                    std::sort(ids.begin(), ids.end());
+                }
+                break;
+            }
+        }
+
+        m_shards.reserve(shard_cnt);
+        std::vector<const pattern_t *> shard_pttrns;
+        for (auto & ids: shard_ids) {
+            shard_pttrns.clear();
+            for (const auto p: ids) shard_pttrns.push_back(pttrns[p]);
+
+            m_shards.emplace_back(
+                indirect_range<pattern_t>(
+                    shard_pttrns.data(), shard_pttrns.data() + shard_pttrns.size()),
+                std::move(ids), indexing);
+        }
+    }
+
+    /**
+     *  \brief  Constructor (from shards, e.g. loaded ones)
+     *
+     *  \param  shards  Shards (with disjoint pattern IDs)
+     */
+    explicit basic_sharded_pattern_set(std::vector<shard_t> && shards):
+        m_shards(std::move(shards))
+    {
+        for (const auto & shard: m_shards) m_size += shard.size();
+    }
+
+    /** Number of patterns */
+    size_t size() const { return m_size; }
+
+    /** Number of shards */
+    size_t shard_cnt() const { return m_shards.size(); }
+
+    /** Shard getter */
+    const shard_t & shard(size_t s) const {
+        assert(s < m_shards.size());
+        return m_shards[s];
+    }
+
+    /**
+     *  \brief  Match all the shards (see \c basic_pattern_shard::match_all)
+     *
+     *  \param  matcher    Sequence matcher (with the sequence assigned)
+     *  \param  threshold  Sørensen-Dice coefficient (match score) threshold: positive
+     *                     \c double or \c std::ratio (compile-time threshold)
+     *
+     *  \return Matches (the same as if the patterns were matched at once)
+     */
+    template <class Matcher, class Threshold>
+    std::vector<sequence_match> match_all(Matcher & matcher, Threshold threshold) const {
+        std::vector<std::vector<sequence_match>> streams;
+        streams.reserve(m_shards.size());
+        for (const auto & shard: m_shards)
+            streams.push_back(shard.match_all(matcher, threshold));
+
+        return merge_matches(streams);
+    }
+
+    /**
+     *  \brief  Answer batch query by all the shards
+     *
+     *  Each sequence of the batch is assigned to the matcher once and matched
+     *  to all the shards (so its cells computed for a shard are re-used by others);
+     *  the shard matches are merged per sequence.
+     *
+     *  \param  matcher    Sequence matcher (re-used for all the sequences)
+     *  \param  batch      Range of token sequences (as taken by \c matcher.assign)
+     *  \param  threshold  Sørensen-Dice coefficient (match score) threshold: positive
+     *                     \c double or \c std::ratio (compile-time threshold)
+     *
+     *  \return Matches in match order
+     */
+    template <class Matcher, class Batch, class Threshold>
+    std::vector<corpus_match> match_batch(
+        Matcher & matcher, const Batch & batch, Threshold threshold) const
+    {
+        std::vector<corpus_match> matches;
+        std::vector<std::vector<sequence_match>> streams(m_shards.size());
+
+        size_t seq = 0;
+        for (const auto & sequence: batch) {
+            matcher.assign(std::begin(sequence), std::end(sequence));
+
+            for (size_t s = 0; s < m_shards.size(); ++s) {
+                streams[s].clear();
+                m_shards[s].match_all(matcher, threshold,
+                    [&stream = streams[s]](const sequence_match & match) {
+                        stream.push_back(match);
+                    });
+            }
+
+            merge_matches(streams, [seq, &matches](const sequence_match & match) {
+                matches.push_back(corpus_match{seq, match});
+            });
+
+            ++seq;
+        }
+
+        return matches;
+    }
+
+    /**
+     *  \brief  Threshold lookup in all the shards (requires the inverted indices)
+     *
+     *  \param  query      Query bigrams
+     *  \param  threshold  Matching score (SDC) threshold (positive)
+     *
+     *  \return Matches (in ascending pattern ID order)
+     */
+    template <class Storage>
+    std::vector<bigram_index_match> lookup(
+        const basic_bigrams<char_t, Storage> & query,
+        double threshold) const
+    {
+        std::vector<std::vector<bigram_index_match>> streams;
+        streams.reserve(m_shards.size());
+        for (const auto & shard: m_shards) streams.push_back(shard.lookup(query, threshold));
+
+        return merge_matches(streams);
+    }
+
+};  // end of template class basic_sharded_pattern_set
+
+
+using pattern_shard = basic_pattern_shard<char>;        /**< ASCII/ANSI pattern shard   */
+using wpattern_shard = basic_pattern_shard<wchar_t>;    /**< UNICODE pattern shard      */
+
+/** ASCII/ANSI sharded pattern set */
+using sharded_pattern_set = basic_sharded_pattern_set<char>;
+
+/** UNICODE sharded pattern set */
+using wsharded_pattern_set = basic_sharded_pattern_set<wchar_t>;
+
+}  // end of namespace libsdcxx
+
+#endif  // end of #ifndef libsdcxx__sharded_pattern_set_hxx
@@ -0,0 +1,440 @@
+#ifndef libsdcxx__simd_intersect_hxx
+#define libsdcxx__simd_intersect_hxx
+
+/**
+ *  \file
+ *  \brief  Sorted packed bigram keys intersection size kernels (SIMD)
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LIBSDCXX_SIMD_X86 1
+#include <immintrin.h>
+#elif defined(__GNUC__) && defined(__aarch64__) && defined(__ARM_NEON)
+#define LIBSDCXX_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+
+namespace libsdcxx {
+
+/**
+ *  \brief  Intersection size kernels
+ *
+ *  The kernels compute size of intersection of 2 bigram multisets stored as sorted
+ *  arrays of (unique) packed bigram keys with separate arrays of counts, i.e.
+ *  sum of \c min(count1,count2) over the common keys.
+ *
+ *  Vectorised kernels compare blocks of keys all-to-all: each key of the 1st block
+ *  is broadcast and compared with the whole 2nd block.
+ *  As the keys are unique, there's at most 1 matching lane, the index of which
+ *  selects the count to take minimum with.
+ *  Then, the block with smaller last key is shifted (both if the last keys are equal).
+ *  Note that the kernels are branch-free (except for the loop itself); the match
+ *  patterns are random, so branching on them would cost more than it'd save.
+ *  The remainder (less than a block) is left for narrower kernels (and finally for
+ *  the scalar one).
+ *
+ *  The best kernel available is chosen at runtime (on the 1st call), see
+ *  \c simd::intersect_size.
+ */
+namespace simd {
+
+/**
+ *  \brief  Scalar intersection size kernel (branch-free merge)
+ *
+ *  \param  keys1  1st sorted keys array
+ *  \param  cnts1  1st counts array
+ *  \param  len1   1st array length
+ *  \param  keys2  2nd sorted keys array
+ *  \param  cnts2  2nd counts array
+ *  \param  len2   2nd array length
+ *
+ *  \return Intersection size
+ */
+template <typename Key, typename Count>
+size_t intersect_size_scalar(
+    const Key * keys1, const Count * cnts1, size_t len1,
+    const Key * keys2, const Count * cnts2, size_t len2)
+{
+    size_t size = 0;
+
+    // Branch-free merge step: the smaller key is skipped (both if equal)
+    size_t i1 = 0, i2 = 0;
+    while (i1 < len1 && i2 < len2) {
+        const Key key1 = keys1[i1];
+        const Key key2 = keys2[i2];
+        const size_t cnt = std::min(cnts1[i1], cnts2[i2]);
+
+        size += key1 == key2 ? cnt : 0;
+
+        i1 += key1 <= key2;
+        i2 += key2 <= key1;
+    }
+
+    return size;
+}
+
+
+/**
+ *  \brief  Minimal count of a matching key (branch-free)
+ *
+ *  \param  match  Mask of the 2nd block lanes matching the key
+ *  \param  guard  Mask bit of the last 2nd block lane
+ *  \param  shift  2nd block mask bits per lane (log2)
+ *  \param  cnt1   The key count
+ *  \param  cnts2  2nd block counts
+ *
+ *  \return Minimal count of the matching keys or 0 if the key doesn't match
+ */
+template <typename Count>
+inline size_t matching_count(
+    uint64_t match, uint64_t guard, unsigned shift,
+    Count cnt1, const Count * cnts2)
+{
+    const Count cnt = std::min(cnt1, cnts2[__builtin_ctzll(match | guard) >> shift]);
+    return match ? cnt : 0;
+}
+
+
+/** Kernel function type */
+template <typename Key, typename Count>
+using intersect_size_fn = size_t (*)(
+    const Key * , const Count * , size_t,
+    const Key * , const Count * , size_t);
+
+
+#ifdef LIBSDCXX_SIMD_X86
+
+/** AVX2 support check */
+inline bool cpu_has_avx2() {
+    return __builtin_cpu_supports("avx2");
+}
+
+/** AVX-512 (foundation and byte/word instructions) support check */
+inline bool cpu_has_avx512() {
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+}
+
+/** AVX2 intersection size kernel for 16-bit keys (blocks of 16 keys) */
+template <typename Count>
+__attribute__((target("avx2")))
+size_t intersect_size_avx2(
+    const uint16_t * keys1, const Count * cnts1, size_t len1,
+    const uint16_t * keys2, const Count * cnts2, size_t len2)
+{
+    constexpr size_t lanes = 16;
+    size_t size = 0;
+
+    size_t i1 = 0, i2 = 0;
+    while (i1 + lanes <= len1 && i2 + lanes <= len2) {
+        const uint16_t last1 = keys1[i1 + lanes - 1];
+        const uint16_t last2 = keys2[i2 + lanes - 1];
+
+        const __m256i block2 = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(keys2 + i2));
+
+        for (size_t l = 0; l < lanes; ++l) {
+            const __m256i eq = _mm256_cmpeq_epi16(
+                _mm256_set1_epi16(static_cast<short>(keys1[i1 + l])), block2);
+
+            // 2 mask bits per 16-bit lane
+            const uint64_t match = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+
+            size += matching_count(match, 1ull << 31, 1, cnts1[i1 + l], cnts2 + i2);
+        }
+
+        i1 += last1 <= last2 ? lanes : 0;
+        i2 += last2 <= last1 ? lanes : 0;
+    }
+
+    return size + intersect_size_scalar(
+        keys1 + i1, cnts1 + i1, len1 - i1,
+        keys2 + i2, cnts2 + i2, len2 - i2);
+}
+
+/** AVX2 intersection size kernel for 64-bit keys (blocks of 4 keys) */
+template <typename Count>
+__attribute__((target("avx2")))
+size_t intersect_size_avx2(
+    const uint64_t * keys1, const Count * cnts1, size_t len1,
+    const uint64_t * keys2, const Count * cnts2, size_t len2)
+{
+    constexpr size_t lanes = 4;
+    size_t size = 0;
+
+    size_t i1 = 0, i2 = 0;
+    while (i1 + lanes <= len1 && i2 + lanes <= len2) {
+        const uint64_t last1 = keys1[i1 + lanes - 1];
+        const uint64_t last2 = keys2[i2 + lanes - 1];
+
+        const __m256i block2 = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(keys2 + i2));
+
+        for (size_t l = 0; l < lanes; ++l) {
+            const __m256i eq = _mm256_cmpeq_epi64(
+                _mm256_set1_epi64x(static_cast<long long>(keys1[i1 + l])), block2);
+
+            const uint64_t match = static_cast<unsigned>(
+                _mm256_movemask_pd(_mm256_castsi256_pd(eq)));
+
+            size += matching_count(match, 1ull << 3, 0, cnts1[i1 + l], cnts2 + i2);
+        }
+
+        i1 += last1 <= last2 ? lanes : 0;
+        i2 += last2 <= last1 ? lanes : 0;
+    }
+
+    return size + intersect_size_scalar(
+        keys1 + i1, cnts1 + i1, len1 - i1,
+        keys2 + i2, cnts2 + i2, len2 - i2);
+}
+
+/** AVX-512 intersection size kernel for 16-bit keys (blocks of 32 keys) */
+template <typename Count>
+__attribute__((target("avx512f,avx512bw,avx2")))
+size_t intersect_size_avx512(
+    const uint16_t * keys1, const Count * cnts1, size_t len1,
+    const uint16_t * keys2, const Count * cnts2, size_t len2)
+{
+    constexpr size_t lanes = 32;
+    size_t size = 0;
+
+    size_t i1 = 0, i2 = 0;
+    while (i1 + lanes <= len1 && i2 + lanes <= len2) {
+        const uint16_t last1 = keys1[i1 + lanes - 1];
+        const uint16_t last2 = keys2[i2 + lanes - 1];
+
+        const __m512i block2 = _mm512_loadu_si512(keys2 + i2);
+
+        for (size_t l = 0; l < lanes; ++l) {
+            const __mmask32 eq = _mm512_cmpeq_epi16_mask(
+                _mm512_set1_epi16(static_cast<short>(keys1[i1 + l])), block2);
+
+            size += matching_count<Count>(eq, 1ull << 31, 0, cnts1[i1 + l], cnts2 + i2);
+        }
+
+        i1 += last1 <= last2 ? lanes : 0;
+        i2 += last2 <= last1 ? lanes : 0;
+    }
+
+    return size + intersect_size_avx2(  // finish using narrower blocks
+        keys1 + i1, cnts1 + i1, len1 - i1,
+        keys2 + i2, cnts2 + i2, len2 - i2);
+}
+
+/** AVX-512 intersection size kernel for 64-bit keys (blocks of 8 keys) */
+template <typename Count>
+__attribute__((target("avx512f,avx2")))
+size_t intersect_size_avx512(
+    const uint64_t * keys1, const Count * cnts1, size_t len1,
+    const uint64_t * keys2, const Count * cnts2, size_t len2)
+{
+    constexpr size_t lanes = 8;
+    size_t size = 0;
+
+    size_t i1 = 0, i2 = 0;
+    while (i1 + lanes <= len1 && i2 + lanes <= len2) {
+        const uint64_t last1 = keys1[i1 + lanes - 1];
+        const uint64_t last2 = keys2[i2 + lanes - 1];
+
+        const __m512i block2 = _mm512_loadu_si512(keys2 + i2);
+
+        for (size_t l = 0; l < lanes; ++l) {
+            const __mmask8 eq = _mm512_cmpeq_epi64_mask(
+                _mm512_set1_epi64(static_cast<long long>(keys1[i1 + l])), block2);
+
+            size += matching_count<Count>(eq, 1ull << 7, 0, cnts1[i1 + l], cnts2 + i2);
+        }
+
+        i1 += last1 <= last2 ? lanes : 0;
+        i2 += last2 <= last1 ? lanes : 0;
+    }
+
+    return size + intersect_size_avx2(  // finish using narrower blocks
+        keys1 + i1, cnts1 + i1, len1 - i1,
+        keys2 + i2, cnts2 + i2, len2 - i2);
+}
+
+#endif  // end of #ifdef LIBSDCXX_SIMD_X86
+
+
+#ifdef LIBSDCXX_SIMD_NEON
+
+/** NEON intersection size kernel for 16-bit keys (blocks of 8 keys) */
+template <typename Count>
+size_t intersect_size_neon(
+    const uint16_t * keys1, const Count * cnts1, size_t len1,
+    const uint16_t * keys2, const Count * cnts2, size_t len2)
+{
+    constexpr size_t lanes = 8;
+    static const uint16_t lane_bits[lanes] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+    const uint16x8_t bits = vld1q_u16(lane_bits);
+
+    size_t size = 0;
+
+    size_t i1 = 0, i2 = 0;
+    while (i1 + lanes <= len1 && i2 + lanes <= len2) {
+        const uint16_t last1 = keys1[i1 + lanes - 1];
+        const uint16_t last2 = keys2[i2 + lanes - 1];
+
+        const uint16x8_t block2 = vld1q_u16(keys2 + i2);
+
+        for (size_t l = 0; l < lanes; ++l) {
+            const uint16x8_t eq = vceqq_u16(vdupq_n_u16(keys1[i1 + l]), block2);
+            const uint64_t match = vaddvq_u16(vandq_u16(eq, bits));
+
+            size += matching_count(match, 1ull << 7, 0, cnts1[i1 + l], cnts2 + i2);
+        }
+
+        i1 += last1 <= last2 ? lanes : 0;
+        i2 += last2 <= last1 ? lanes : 0;
+    }
+
+    return size + intersect_size_scalar(
+        keys1 + i1, cnts1 + i1, len1 - i1,
+        keys2 + i2, cnts2 + i2, len2 - i2);
+}
+
+/** NEON intersection size kernel for 64-bit keys (blocks of 2 keys) */
+template <typename Count>
+size_t intersect_size_neon(
+    const uint64_t * keys1, const Count * cnts1, size_t len1,
+    const uint64_t * keys2, const Count * cnts2, size_t len2)
+{
+    constexpr size_t lanes = 2;
+    size_t size = 0;
+
+    size_t i1 = 0, i2 = 0;
+    while (i1 + lanes <= len1 && i2 + lanes <= len2) {
+        const uint64_t last1 = keys1[i1 + lanes - 1];
+        const uint64_t last2 = keys2[i2 + lanes - 1];
+
+        const uint64x2_t block2 = vld1q_u64(keys2 + i2);
+
+        for (size_t l = 0; l < lanes; ++l) {
+            const uint64x2_t eq = vceqq_u64(vdupq_n_u64(keys1[i1 + l]), block2);
+            const uint64_t match =
+                (vgetq_lane_u64(eq, 0) & 1) | (vgetq_lane_u64(eq, 1) & 2);
+
+            size += matching_count(match, 1ull << 1, 0, cnts1[i1 + l], cnts2 + i2);
+        }
+
+        i1 += last1 <= last2 ? lanes : 0;
+        i2 += last2 <= last1 ? lanes : 0;
+    }
+
+    return size + intersect_size_scalar(
+        keys1 + i1, cnts1 + i1, len1 - i1,
+        keys2 + i2, cnts2 + i2, len2 - i2);
+}
+
+#endif  // end of #ifdef LIBSDCXX_SIMD_NEON
+
+
+/**
+ *  \brief  Intersection size kernel selection
+ *
+ *  Generic keys only use the scalar kernel.
+ *
+ *  \tparam  Key    Key type
+ *  \tparam  Count  Count type
+ */
+template <typename Key, typename Count>
+struct intersect_size_kernel {
+    /** Best available kernel */
+    static intersect_size_fn<Key, Count> select() {
+        return &intersect_size_scalar<Key, Count>;
+    }
+};
+
+/** Kernel selection for SIMD-enabled keys */
+template <typename Key, typename Count>
+struct simd_intersect_size_kernel {
+    /** Best available kernel (CPU dispatch) */
+    static intersect_size_fn<Key, Count> select() {
+#if defined(LIBSDCXX_SIMD_X86)
+        if (cpu_has_avx512()) return &intersect_size_avx512<Count>;
+        if (cpu_has_avx2()) return &intersect_size_avx2<Count>;
+#elif defined(LIBSDCXX_SIMD_NEON)
+        return &intersect_size_neon<Count>;
+#endif
+        return &intersect_size_scalar<Key, Count>;
+    }
+};
+
+template <typename Count>
+struct intersect_size_kernel<uint16_t, Count>:
+    simd_intersect_size_kernel<uint16_t, Count> {};
+
+template <typename Count>
+struct intersect_size_kernel<uint64_t, Count>:
+    simd_intersect_size_kernel<uint64_t, Count> {};
+
+
+/**
+ *  \brief  Intersection size
+ *
+ *  Uses the best kernel available on the CPU (selected on the 1st call).
+ *
+ *  \param  keys1  1st sorted keys array
+ *  \param  cnts1  1st counts array
+ *  \param  len1   1st array length
+ *  \param  keys2  2nd sorted keys array
+ *  \param  cnts2  2nd counts array
+ *  \param  len2   2nd array length
+ *
+ *  \return Intersection size
+ */
+template <typename Key, typename Count>
+size_t intersect_size(
+    const Key * keys1, const Count * cnts1, size_t len1,
+    const Key * keys2, const Count * cnts2, size_t len2)
+{
+    static const auto kernel = intersect_size_kernel<Key, Count>::select();
+    return kernel(keys1, cnts1, len1, keys2, cnts2, len2);
+}
+
+}  // end of namespace simd
+
+}  // end of namespace libsdcxx
+
+#endif  // end of #ifndef libsdcxx__simd_intersect_hxx
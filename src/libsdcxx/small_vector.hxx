@@ -0,0 +1,268 @@
+#ifndef libsdcxx__small_vector_hxx
+#define libsdcxx__small_vector_hxx
+
+/**
+ *  \file
+ *  \brief  Vector with inline storage for small sizes (small-buffer optimisation)
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <memory_resource>
+#include <algorithm>
+#include <utility>
+
+
+namespace libsdcxx {
+
+/**
+ *  \brief  Vector with inline storage
+ *
+ *  Up to \c InlineCapacity items are stored inline (in the object itself);
+ *  the storage only spills to the heap past that.
+ *  Only trivially copyable items are supported (they're copied by \c memcpy
+ *  and left uninitialised on resize).
+ *  The heap storage is obtained from a polymorphic allocator (i.e. from a memory
+ *  resource, see e.g. \c arena); as with \c std::pmr containers, the allocator
+ *  isn't propagated on assignment.
+ *
+ *  \tparam  T               Item type
+ *  \tparam  InlineCapacity  Inline storage capacity
+ */
+template <typename T, size_t InlineCapacity>
+class small_vector {
+    static_assert(std::is_trivially_copyable_v<T>,
+        "small_vector only supports trivially copyable items");
+    static_assert(InlineCapacity > 0, "small_vector inline capacity must be positive");
+
+    public:
+
+    using value_type = T;                                   /**< Item type          */
+    using iterator = T *;                                   /**< Iterator           */
+    using const_iterator = const T *;                       /**< Const. iterator    */
+    using allocator_type = std::pmr::polymorphic_allocator<T>;  /**< Allocator      */
+
+    static constexpr size_t inline_capacity = InlineCapacity;  /**< Inline capacity */
+
+    private:
+
+    allocator_type  m_alloc;                    /**< Heap storage allocator     */
+    T *             m_data;                     /**< Items (inline or on heap)  */
+    size_t          m_size;                     /**< Number of items            */
+    size_t          m_capacity;                 /**< Capacity                   */
+    T               m_inline[InlineCapacity];   /**< Inline storage             */
+
+    /** Check if the items are stored inline */
+    bool is_inline() const { return m_data == m_inline; }
+
+    /** Release heap storage (if used) */
+    void release() {
+        if (!is_inline()) m_alloc.deallocate(m_data, m_capacity);
+        m_data = m_inline;
+        m_capacity = InlineCapacity;
+    }
+
+    /** Copy other vector's items */
+    void copy(const small_vector & other) {
+        m_size = 0;
+        reserve(other.m_size);
+        std::memcpy(m_data, other.m_data, other.m_size * sizeof(T));
+        m_size = other.m_size;
+    }
+
+    /** Take over other vector's items (the heap storage if allocators match) */
+    void take(small_vector & other) {
+        if (other.is_inline() || m_alloc != other.m_alloc)
+            copy(other);  // can't steal the storage
+
+        else {  // steal the heap storage
+            release();
+            m_data = other.m_data;
+            m_size = other.m_size;
+            m_capacity = other.m_capacity;
+            other.m_data = other.m_inline;
+            other.m_capacity = InlineCapacity;
+        }
+
+        other.m_size = 0;
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  alloc  Allocator
+     */
+    explicit small_vector(const allocator_type & alloc = allocator_type()):
+        m_alloc(alloc), m_data(m_inline), m_size(0), m_capacity(InlineCapacity)
+    {}
+
+    /**
+     *  \brief  Constructor of vector of given size (items are uninitialised)
+     *
+     *  \param  size   Vector size
+     *  \param  alloc  Allocator
+     */
+    explicit small_vector(size_t size, const allocator_type & alloc = allocator_type()):
+        small_vector(alloc)
+    {
+        resize(size);
+    }
+
+    /** Copy constructor (default allocator is used) */
+    small_vector(const small_vector & orig): small_vector() { copy(orig); }
+
+    /** Copy constructor (allocator-extended) */
+    small_vector(const small_vector & orig, const allocator_type & alloc):
+        small_vector(alloc)
+    {
+        copy(orig);
+    }
+
+    /** Move constructor */
+    small_vector(small_vector && orig) noexcept: small_vector(orig.m_alloc) { take(orig); }
+
+    /** Copy assignment */
+    small_vector & operator = (const small_vector & orig) {
+        if (this != &orig) copy(orig);
+        return *this;
+    }
+
+    /** Move assignment */
+    small_vector & operator = (small_vector && orig) {
+        if (this != &orig) take(orig);
+        return *this;
+    }
+
+    /** Destructor */
+    ~small_vector() { release(); }
+
+    /** Allocator getter */
+    allocator_type get_allocator() const { return m_alloc; }
+
+    /** Number of items */
+    size_t size() const { return m_size; }
+
+    /** Check if empty */
+    bool empty() const { return 0 == m_size; }
+
+    /** Capacity */
+    size_t capacity() const { return m_capacity; }
+
+    /** Items */
+    T * data() { return m_data; }
+
+    /** Items (const.) */
+    const T * data() const { return m_data; }
+
+    /** Item access */
+    T & operator [] (size_t i) { return m_data[i]; }
+
+    /** Item access (const.) */
+    const T & operator [] (size_t i) const { return m_data[i]; }
+
+    /** \brief  Begin iterator getter */
+    iterator begin() { return m_data; }
+
+    /** \brief  End iterator getter */
+    iterator end() { return m_data + m_size; }
+
+    /** \brief  Begin const. iterator getter */
+    const_iterator begin() const { return m_data; }
+
+    /** \brief  End const. iterator getter */
+    const_iterator end() const { return m_data + m_size; }
+
+    /**
+     *  \brief  Reserve space for items
+     *
+     *  \param  capacity  Required capacity
+     */
+    void reserve(size_t capacity) {
+        if (capacity <= m_capacity) return;
+
+        T * data = m_alloc.allocate(capacity);
+        std::memcpy(data, m_data, m_size * sizeof(T));
+
+        release();
+        m_data = data;
+        m_capacity = capacity;
+    }
+
+    /**
+     *  \brief  Resize (new items are uninitialised)
+     *
+     *  \param  size  New size
+     */
+    void resize(size_t size) {
+        reserve(size);
+        m_size = size;
+    }
+
+    /** Remove all items (capacity is kept) */
+    void clear() { m_size = 0; }
+
+    /**
+     *  \brief  Append item
+     *
+     *  \param  item  Item
+     */
+    void push_back(const T & item) {
+        if (m_size == m_capacity) {
+            const T copy = item;  // the item may be ours
+            reserve(2 * m_capacity);
+            m_data[m_size++] = copy;
+        }
+        else
+            m_data[m_size++] = item;
+    }
+
+    /** Swap contents with other vector */
+    void swap(small_vector & other) {
+        small_vector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+};  // end of template class small_vector
+
+}  // end of namespace libsdcxx
+
+#endif  // end of #ifndef libsdcxx__small_vector_hxx
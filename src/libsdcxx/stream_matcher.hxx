@@ -0,0 +1,414 @@
+#ifndef libsdcxx__stream_matcher_hxx
+#define libsdcxx__stream_matcher_hxx
+
+/**
+ *  \file
+ *  \brief  Sliding window sequence matcher (for unbounded token streams)
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+#include <optional>
+#include <ratio>
+#include <utility>
+#include <algorithm>
+#include <string_view>
+
+#include "bigrams.hxx"
+#include "sequence_matcher.hxx"
+#include "utf8.hxx"
+
+
+namespace libsdcxx {
+
+/**
+ *  \brief  Sliding window sequence matcher
+ *
+ *  Matches patterns (registered up front) to an unbounded stream of tokens.
+ *  Unlike \c basic_sequence_matcher, which keeps the whole triangular matrix
+ *  of the sequence sub-sequences bigrams, the stream matcher only considers
+ *  sub-sequences of at most \c window tokens.
+ *  It keeps a ring buffer of the last \c window matrix columns (cells of sub-sequences
+ *  ending with the same token); pushing a token evicts the oldest column.
+ *  The memory is therefore O(w^2) cells for window of w tokens (regardless of
+ *  the stream length) and so is the work per token.
+ *
+ *  The matrix recurrence is the same as that of \c basic_sequence_matcher
+ *  (with the cells indexed by the sub-sequence end); the sub-sequences of any cell
+ *  end within the cell's sub-sequence, so they're always in the window.
+ *  The bigrams are computed lazily, and so only for the sub-sequences
+ *  with acceptable cardinality ratio.
+ *
+ *  The matches are emitted as soon as their last token is pushed, i.e. in ascending
+ *  order by end, then by begin and pattern index.
+ *  The match begin and end are stream positions (token indices since construction
+ *  or \c reset).
+ *  The matches are the same as \c basic_sequence_matcher::match_all of the whole stream
+ *  would produce, except those longer than the window.
+ *  Note that the patterns themselves limit the sub-sequence bigram cardinality
+ *  (see \c max_size); a window long enough to cover that makes no difference at all.
+ *
+ *  The matching threshold policy is the same as that of \c basic_sequence_matcher;
+ *  \c static_threshold (constructed from \c std::ratio threshold) does the checks
+ *  in integer arithmetic.
+ *
+ *  \tparam  Bigrams    Bigram multiset implementation
+ *  \tparam  Threshold  Matching threshold policy (see \c make_threshold)
+ */
+template <class Bigrams, class Threshold = dynamic_threshold>
+class basic_stream_matcher {
+    public:
+
+    using bigrams_t = Bigrams;                      /**< Bigrams type       */
+    using char_t = typename bigrams_t::char_t;      /**< Character type     */
+    using threshold_t = Threshold;                  /**< Threshold policy   */
+
+    private:
+
+    /** Bigram multiset matrix cell (bigrams computed lazily) */
+    using mx_cell = std::optional<bigrams_t>;
+
+    std::vector<bigrams_t> m_pttrns;    /**< Patterns (sorted by size)                  */
+    std::vector<size_t> m_order;        /**< Pattern indices (in size order)            */
+    std::vector<size_t> m_pttrn_sizes;  /**< Pattern sizes (ascending)                  */
+    threshold_t m_threshold;            /**< Matching threshold                         */
+    size_t m_window;                    /**< Max. sub-sequence length (tokens)          */
+    size_t m_pos;                       /**< Stream position (number of tokens pushed)  */
+    std::vector<mx_cell> m_cells;       /**< Window columns (ring buffer)               */
+    std::vector<size_t> m_size_sums;    /**< Bigram size prefix sums (ring buffer)      */
+    std::vector<bool> m_strip;          /**< "Strip" token flags (ring buffer)          */
+    std::vector<sequence_match> m_matches;  /**< Matches of a sub-sequence              */
+
+    /** Size prefix sum of tokens before stream position */
+    size_t size_sum(size_t pos) const { return m_size_sums[pos % (m_window + 1)]; }
+
+    /** Check if token at stream position is a "strip" token */
+    bool is_strip(size_t pos) const { return m_strip[pos % m_window]; }
+
+    /**
+     *  \brief  Cell
+     *
+     *  \param  i  Row index (sub-sequence length - 1)
+     *  \param  j  Sub-sequence begin (stream position)
+     *
+     *  \return Cell of the sub-sequence
+     */
+    mx_cell & cell(size_t i, size_t j) {
+        assert(i < m_window && j + i < m_pos && m_pos - (j + i) <= m_window);
+        return m_cells[(j + i) % m_window * m_window + i];
+    }
+
+    /**
+     *  \brief  Bigrams getter (see \c basic_sequence_matcher::bigrams)
+     *
+     *  \param  i  Row index (sub-sequence length - 1)
+     *  \param  j  Sub-sequence begin (stream position)
+     *
+     *  \return Bigrams of the sub-sequence
+     */
+    const bigrams_t & bigrams(size_t i, size_t j) {
+        auto & c = cell(i, j);
+
+        if (!c) {  // bigrams not computed yet
+            const size_t i1 = i / 2;
+            const size_t i2 = i - i1 - 1;
+            c.emplace(bigrams(i1, j), bigrams(i2, j + i1 + 1));
+        }
+
+        return *c;
+    }
+
+    /** Pattern pointers */
+    template <class Patterns>
+    static std::vector<const bigrams_t *> pointers(const Patterns & patterns) {
+        std::vector<const bigrams_t *> pttrns;
+        for (const auto & pattern: patterns) pttrns.push_back(&pattern);
+
+        return pttrns;
+    }
+
+    /** Constructor (see the public ones) */
+    template <class Thr>
+    basic_stream_matcher(
+        const std::vector<const bigrams_t *> & pttrns,
+        Thr threshold, size_t window)
+    :
+        basic_stream_matcher(pttrns.data(), pttrns.size(), threshold, window)
+    {}
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  pttrns     Pattern bigram multisets (copied)
+     *  \param  pttrn_cnt  Number of patterns
+     *  \param  threshold  Sørensen-Dice coefficient (match score) threshold: positive
+     *                     \c double or \c std::ratio (as \c threshold_t takes it)
+     *  \param  window     Max. match length (number of tokens, positive)
+     */
+    template <class Thr>
+    basic_stream_matcher(
+        const bigrams_t * const * pttrns, size_t pttrn_cnt,
+        Thr threshold, size_t window)
+    :
+        m_threshold(make_threshold(threshold)),
+        m_window(window),
+        m_pos(0),
+        m_cells(window * window),
+        m_size_sums(window + 1, 0),
+        m_strip(window, false)
+    {
+        assert(m_threshold.sdc() > 0.0);
+        assert(window > 0);
+
+        m_order.resize(pttrn_cnt);
+        for (size_t p = 0; p < pttrn_cnt; ++p) m_order[p] = p;
+        std::stable_sort(m_order.begin(), m_order.end(), [pttrns](size_t p1, size_t p2) {
+            return pttrns[p1]->size() < pttrns[p2]->size();
+        });
+
+        m_pttrns.reserve(pttrn_cnt);
+        m_pttrn_sizes.reserve(pttrn_cnt);
+        for (const size_t p: m_order) {
+            m_pttrns.push_back(*pttrns[p]);
+            m_pttrn_sizes.push_back(pttrns[p]->size());
+        }
+    }
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  patterns   Range of pattern bigram multisets (copied)
+     *  \param  threshold  Sørensen-Dice coefficient (match score) threshold: positive
+     *                     \c double or \c std::ratio (as \c threshold_t takes it)
+     *  \param  window     Max. match length (number of tokens, positive)
+     */
+    template <class Patterns, class Thr>
+    basic_stream_matcher(const Patterns & patterns, Thr threshold, size_t window):
+        basic_stream_matcher(pointers(patterns), threshold, window)
+    {}
+
+    /** Number of patterns */
+    size_t patterns() const { return m_pttrns.size(); }
+
+    /** Max. match length (number of tokens) */
+    size_t window() const { return m_window; }
+
+    /** Stream position (number of tokens pushed) */
+    size_t position() const { return m_pos; }
+
+    /**
+     *  \brief  Max. bigram cardinality of matching sub-sequence
+     *
+     *  Sub-sequences with more bigrams can't reach the threshold with any pattern.
+     *
+     *  \return Max. sub-sequence bigrams size
+     */
+    size_t max_size() const {
+        if (m_pttrn_sizes.empty()) return 0;
+
+        const size_t pttrn_size = m_pttrn_sizes.back();
+        size_t max_size = static_cast<size_t>(pttrn_size * (2.0 / m_threshold.sdc() - 1.0));
+        while (CARD_LONG == m_threshold.check_cardinality(max_size, pttrn_size)) --max_size;
+        while (CARD_LONG != m_threshold.check_cardinality(max_size + 1, pttrn_size))
+            ++max_size;
+
+        return max_size;
+    }
+
+    /**
+     *  \brief  Start new stream
+     *
+     *  The window memory is kept for re-use.
+     */
+    void reset() {
+        for (auto & c: m_cells) c.reset();
+        std::fill(m_size_sums.begin(), m_size_sums.end(), 0);
+        m_pos = 0;
+    }
+
+    /**
+     *  \brief  Push another token bigram multiset to the stream
+     *
+     *  Matches of all the sub-sequences ending with the token are reported
+     *  (in ascending order by begin and pattern index).
+     *
+     *  \param  bgrms  Token bigram multiset
+     *  \param  strip  This is a "strip" token (not a begin/end of valid sub-sequence)
+     *  \param  sink   Match sink, called as \c sink(const sequence_match &)
+     */
+    template <class Sink>
+    void push_back(bigrams_t && bgrms, bool strip, Sink && sink) {
+        const size_t end = m_pos++;
+        const size_t column = end % m_window;
+
+        // Evict the oldest column
+        for (size_t i = 0; i < m_window; ++i) m_cells[column * m_window + i].reset();
+
+        m_strip[column] = strip;
+        m_size_sums[m_pos % (m_window + 1)] = size_sum(end) + bgrms.size();
+        cell(0, end).emplace(std::move(bgrms));
+
+        // Skip sub-sequences ending with "strip" token
+        if (strip || m_pttrns.empty()) return;
+
+        const auto sizes_begin = m_pttrn_sizes.cbegin();
+        const auto sizes_end = m_pttrn_sizes.cend();
+
+        // Sub-sequences from the longest one (sizes decrease with begin)
+        const size_t first = m_pos > m_window ? m_pos - m_window : 0;
+        for (size_t j = first; j <= end; ++j) {
+            // Skip sub-sequence beginning with "strip" token
+            if (is_strip(j)) continue;
+
+            const size_t subseq_size = size_sum(m_pos) - size_sum(j);
+            if (CARD_LONG == m_threshold.check_cardinality(subseq_size, m_pttrn_sizes.back()))
+                continue;  // too long for the biggest pattern, try shorter one
+            if (CARD_SHORT == m_threshold.check_cardinality(subseq_size, m_pttrn_sizes.front()))
+                break;  // too short even for the smallest pattern
+
+            // Drop leftovers (should the sink have thrown) before collecting matches
+            m_matches.clear();
+
+            // Patterns which are not too small nor too big
+            const auto pttrns_begin = std::partition_point(sizes_begin, sizes_end,
+                [&](size_t pttrn_size) {
+                    return CARD_LONG == m_threshold.check_cardinality(subseq_size, pttrn_size);
+                });
+            const auto pttrns_end = std::partition_point(pttrns_begin, sizes_end,
+                [&](size_t pttrn_size) {
+                    return CARD_SHORT != m_threshold.check_cardinality(subseq_size, pttrn_size);
+                });
+
+            for (auto pttrn = pttrns_begin; pttrn != pttrns_end; ++pttrn) {
+                const size_t p = pttrn - sizes_begin;
+                const size_t isect_size = bigrams_t::intersect_size(
+                    bigrams(end - j, j), m_pttrns[p]);
+                const size_t size_sum = subseq_size + *pttrn;
+
+                if (!m_threshold.accept(isect_size, size_sum)) continue;  // not up to scratch
+
+                m_matches.push_back(sequence_match{m_order[p], j, m_pos,
+                    sorensen_dice_coef(isect_size, size_sum)});
+            }
+
+            // Report in pattern index order
+            std::sort(m_matches.begin(), m_matches.end(),
+                [](const sequence_match & m1, const sequence_match & m2) {
+                    return m1.pattern < m2.pattern;
+                });
+
+            for (const auto & match: m_matches) sink(match);
+        }
+    }
+
+    /**
+     *  \brief  Push another token bigram multiset to the stream
+     *
+     *  \param  bgrms  Token bigram multiset
+     *  \param  strip  This is a "strip" token (not a begin/end of valid sub-sequence)
+     *  \param  sink   Match sink, called as \c sink(const sequence_match &)
+     */
+    template <class Sink>
+    void push_back(const bigrams_t & bgrms, bool strip, Sink && sink) {
+        push_back(bigrams_t(bgrms), strip, std::forward<Sink>(sink));
+    }
+
+    /**
+     *  \brief  Push another token to the stream
+     *
+     *  \param  str    Token
+     *  \param  strip  This is a "strip" token (not a begin/end of valid sub-sequence)
+     *  \param  sink   Match sink, called as \c sink(const sequence_match &)
+     */
+    template <class Sink>
+    void emplace_back(std::basic_string_view<char_t> str, bool strip, Sink && sink) {
+        push_back(bigrams_t(str), strip, std::forward<Sink>(sink));
+    }
+
+    /**
+     *  \brief  Push another UTF-8 token to the stream
+     *
+     *  \param  str    Token (UTF-8 encoded)
+     *  \param  strip  This is a "strip" token (not a begin/end of valid sub-sequence)
+     *  \param  sink   Match sink, called as \c sink(const sequence_match &)
+     */
+    template <class Sink>
+    void emplace_back(utf8_t , std::string_view str, bool strip, Sink && sink) {
+        push_back(bigrams_t(utf8, str), strip, std::forward<Sink>(sink));
+    }
+
+    /**
+     *  \brief  Push another token to the stream
+     *
+     *  \param  str    Token
+     *  \param  strip  This is a "strip" token (not a begin/end of valid sub-sequence)
+     *
+     *  \return Matches ending with the token
+     */
+    std::vector<sequence_match> emplace_back(
+        std::basic_string_view<char_t> str, bool strip = false)
+    {
+        std::vector<sequence_match> matches;
+        emplace_back(str, strip, [&matches](const sequence_match & match) {
+            matches.push_back(match);
+        });
+
+        return matches;
+    }
+
+};  // end of template class basic_stream_matcher
+
+
+/**< ASCII/ANSI string stream matcher */
+using stream_matcher = basic_stream_matcher<bigrams>;
+
+/**< UNICODE string stream matcher */
+using wstream_matcher = basic_stream_matcher<wbigrams>;
+
+/**< ASCII/ANSI string stream matcher (flat bigrams storage) */
+using flat_stream_matcher = basic_stream_matcher<flat_bigrams>;
+
+/**< UNICODE string stream matcher (flat bigrams storage) */
+using wflat_stream_matcher = basic_stream_matcher<wflat_bigrams>;
+
+}  // end of namespace libsdcxx
+
+#endif  // end of #ifndef libsdcxx__stream_matcher_hxx
@@ -0,0 +1,101 @@
+#ifndef libsdcxx__utf8_hxx
+#define libsdcxx__utf8_hxx
+
+/**
+ *  \file
+ *  \brief  UTF-8 decoding
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string_view>
+#include <cstddef>
+
+
+namespace libsdcxx {
+
+/** UTF-8 input tag (see \c basic_bigrams UTF-8 constructor) */
+struct utf8_t {};
+
+constexpr utf8_t utf8 {};  /**< UTF-8 input tag */
+
+
+/** Replacement character (produced for malformed UTF-8 sequences) */
+constexpr char32_t utf8_replacement = 0xFFFD;
+
+
+/**
+ *  \brief  Decode UTF-8 code point
+ *
+ *  Malformed sequences (bad lead or continuation bytes, overlong encodings,
+ *  surrogates and code points beyond U+10FFFF) are decoded as U+FFFD, consuming
+ *  a single byte (the following bytes are decoded anew).
+ *
+ *  \param  ptr  Position in the input (shifted past the decoded sequence)
+ *  \param  end  Input end
+ *
+ *  \return Code point
+ */
+inline char32_t utf8_decode(const char * & ptr, const char * end) {
+    const auto byte = [](const char * p) { return static_cast<unsigned char>(*p); };
+    const auto cont = [&](const char * p) { return p < end && 0x80 == (byte(p) & 0xC0); };
+
+    const unsigned char lead = byte(ptr);
+    if (lead < 0x80) { ++ptr; return lead; }  // ASCII fast path
+
+    size_t len;
+    char32_t cp, min;
+    if      (0xC0 == (lead & 0xE0)) { len = 2; cp = lead & 0x1F; min = 0x80;    }
+    else if (0xE0 == (lead & 0xF0)) { len = 3; cp = lead & 0x0F; min = 0x800;   }
+    else if (0xF0 == (lead & 0xF8)) { len = 4; cp = lead & 0x07; min = 0x10000; }
+    else { ++ptr; return utf8_replacement; }  // continuation or invalid lead byte
+
+    for (size_t i = 1; i < len; ++i) {
+        if (!cont(ptr + i)) { ++ptr; return utf8_replacement; }  // truncated
+        cp = (cp << 6) | (byte(ptr + i) & 0x3F);
+    }
+
+    if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+        ++ptr; return utf8_replacement;  // overlong, out of range or surrogate
+    }
+
+    ptr += len;
+    return cp;
+}
+
+}  // end of namespace libsdcxx
+
+#endif  // end of #ifndef libsdcxx__utf8_hxx
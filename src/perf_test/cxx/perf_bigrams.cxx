@@ -0,0 +1,193 @@
+/**
+ *  \file
+ *  \brief  Bigram multiset operations microbenchmarks
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libsdcxx/bigrams.hxx"
+#include "libsdcxx/bigram_multiset.hxx"
+#include "libsdcxx/hashed_bigram_multiset.hxx"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+#include <random>
+#include <cstddef>
+
+
+namespace {
+
+/**
+ *  \brief  Generate random strings
+ *
+ *  The strings are made of lowercase letters (and spaces, so that there
+ *  are repeated bigrams as in natural text).
+ *  The generator is seeded by a constant, so that the strings are the same
+ *  for all the runs (and the results comparable).
+ *
+ *  \param  cnt  Number of strings
+ *  \param  len  String length
+ *
+ *  \return Strings
+ */
+std::vector<std::string> random_strings(size_t cnt, size_t len) {
+    static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz     ";
+
+    std::mt19937 rng(2023);
+    std::uniform_int_distribution<size_t> dist(0, sizeof(alphabet) - 2);
+
+    std::vector<std::string> strs(cnt);
+    for (auto & str: strs)
+        for (size_t i = 0; i < len; ++i) str.push_back(alphabet[dist(rng)]);
+
+    return strs;
+}
+
+
+/** Number of strings used per benchmark (cycled through) */
+constexpr size_t str_cnt = 64;
+
+
+/** Bigrams construction from string */
+template <class Bigrams>
+void construction(benchmark::State & state) {
+    const auto strs = random_strings(str_cnt, state.range(0));
+
+    size_t i = 0;
+    for (auto _: state) {
+        Bigrams bgrms(strs[i++ % str_cnt]);
+        benchmark::DoNotOptimize(bgrms);
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+
+/** Union by accumulation (\c operator \c +=), as done for token sequences */
+template <class Bigrams>
+void accumulation(benchmark::State & state) {
+    constexpr size_t acc_cnt = 8;  // accumulated tokens per iteration
+
+    const auto strs = random_strings(str_cnt, state.range(0));
+    std::vector<Bigrams> bgrms(strs.begin(), strs.end());
+
+    size_t i = 0;
+    for (auto _: state) {
+        Bigrams acc;
+        for (size_t j = 0; j < acc_cnt; ++j) acc += bgrms[i++ % str_cnt];
+        benchmark::DoNotOptimize(acc);
+    }
+
+    state.SetItemsProcessed(state.iterations() * acc_cnt);
+}
+
+
+/** Union of 4 multisets at once (\c unite) */
+template <class Bigrams>
+void union_of_4(benchmark::State & state) {
+    const auto strs = random_strings(str_cnt, state.range(0));
+    const std::vector<Bigrams> bgrms(strs.begin(), strs.end());
+
+    size_t i = 0;
+    for (auto _: state) {
+        const auto & b1 = bgrms[i++ % str_cnt];
+        const auto & b2 = bgrms[i++ % str_cnt];
+        const auto & b3 = bgrms[i++ % str_cnt];
+        const auto & b4 = bgrms[i++ % str_cnt];
+
+        benchmark::DoNotOptimize(Bigrams::unite(b1, b2, b3, b4));
+    }
+}
+
+
+/** Union of all the strings' multisets (range \c unite vs. accumulation fold) */
+template <class Bigrams, bool fold>
+void union_of_all(benchmark::State & state) {
+    const auto strs = random_strings(str_cnt, state.range(0));
+    const std::vector<Bigrams> bgrms(strs.begin(), strs.end());
+
+    for (auto _: state) {
+        if constexpr (fold) {
+            Bigrams acc;
+            for (const auto & bgrm: bgrms) acc += bgrm;
+            benchmark::DoNotOptimize(acc);
+        }
+        else
+            benchmark::DoNotOptimize(Bigrams::unite(bgrms.begin(), bgrms.end()));
+    }
+
+    state.SetItemsProcessed(state.iterations() * str_cnt);
+}
+
+
+/** Intersection size */
+template <class Bigrams>
+void intersection_size(benchmark::State & state) {
+    const auto strs = random_strings(str_cnt, state.range(0));
+    const std::vector<Bigrams> bgrms(strs.begin(), strs.end());
+
+    size_t i = 0;
+    for (auto _: state) {
+        const auto & b1 = bgrms[i++ % str_cnt];
+        const auto & b2 = bgrms[i % str_cnt];
+        benchmark::DoNotOptimize(Bigrams::intersect_size(b1, b2));
+    }
+}
+
+}  // end of anonymous namespace
+
+
+/** Register benchmark for all the implementations */
+#define BENCHMARK_IMPLEMENTATIONS(func) \
+    BENCHMARK_TEMPLATE(func, libsdcxx::bigrams)->RangeMultiplier(8)->Range(8, 512); \
+    BENCHMARK_TEMPLATE(func, libsdcxx::flat_bigrams)->RangeMultiplier(8)->Range(8, 512); \
+    BENCHMARK_TEMPLATE(func, libsdcxx::bigram_multiset)->RangeMultiplier(8)->Range(8, 512); \
+    BENCHMARK_TEMPLATE(func, libsdcxx::unordered_bigram_multiset)->RangeMultiplier(8)->Range(8, 512); \
+    BENCHMARK_TEMPLATE(func, libsdcxx::hashed_bigram_multiset)->RangeMultiplier(8)->Range(8, 512)
+
+BENCHMARK_IMPLEMENTATIONS(construction);
+BENCHMARK_IMPLEMENTATIONS(accumulation);
+BENCHMARK_IMPLEMENTATIONS(union_of_4);
+BENCHMARK_IMPLEMENTATIONS(intersection_size);
+
+BENCHMARK_TEMPLATE(union_of_all, libsdcxx::bigrams, true)->RangeMultiplier(8)->Range(8, 512);
+BENCHMARK_TEMPLATE(union_of_all, libsdcxx::bigrams, false)->RangeMultiplier(8)->Range(8, 512);
+BENCHMARK_TEMPLATE(union_of_all, libsdcxx::flat_bigrams, true)->RangeMultiplier(8)->Range(8, 512);
+BENCHMARK_TEMPLATE(union_of_all, libsdcxx::flat_bigrams, false)->RangeMultiplier(8)->Range(8, 512);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,260 @@
+/**
+ *  \file
+ *  \brief  Sequence matching benchmarks
+ *
+ *  The text sentences (lines of \c test.txt) are tokenised the same way
+ *  as \c perf_test/matching.py does it, and matched to all the sequences
+ *  of \c sequences.txt (pre-computed pattern bigrams).
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libsdcxx/sequence_matcher.hxx"
+#include "libsdcxx/pattern_set.hxx"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <ratio>
+#include <fstream>
+#include <stdexcept>
+#include <cctype>
+#include <cstddef>
+
+
+#ifndef PERF_TEST_DATA_DIR
+#define PERF_TEST_DATA_DIR "."
+#endif
+
+
+namespace {
+
+using token_t = std::pair<std::string, bool>;  /**< UTF-8 token, strip flag */
+using sentence_t = std::vector<token_t>;        /**< Tokenised text line     */
+
+/** Matching score threshold (as used by \c build.sh perf. tests) */
+constexpr double threshold = 0.8;
+
+/** The same threshold known at compile time */
+using static_threshold = std::ratio<4, 5>;
+
+
+/** Separator character (whitespace or punctuation) */
+bool is_separator(char ch) {
+    const auto uch = static_cast<unsigned char>(ch);
+    return uch < 0x80 && (std::isspace(uch) || std::ispunct(uch));
+}
+
+
+/**
+ *  \brief  Augment token
+ *
+ *  The token is lowercased (ASCII only) and single character tokens are
+ *  prefixed with space so that they produce a bigram.
+ */
+std::string augment_token(std::string_view token) {
+    std::string augmented;
+    size_t char_cnt = 0;
+    for (const char ch: token) {
+        const auto uch = static_cast<unsigned char>(ch);
+        augmented.push_back(uch < 0x80 ? static_cast<char>(std::tolower(uch)) : ch);
+        if ((uch & 0xc0) != 0x80) ++char_cnt;  // not a continuation byte
+    }
+
+    if (char_cnt == 1) augmented.insert(0, 1, ' ');
+    return augmented;
+}
+
+
+/**
+ *  \brief  Tokenise text file
+ *
+ *  Tokens are separated by runs of separators, which form "strip" tokens.
+ *  Empty lines are skipped.
+ *
+ *  \param  file  Text file name (organised in lines)
+ *
+ *  \return Tokenised lines
+ */
+std::vector<sentence_t> tokenise(const std::string & file) {
+    std::ifstream in(file);
+    if (!in) throw std::runtime_error("failed to open " + file);
+
+    std::vector<sentence_t> sentences;
+    for (std::string line; std::getline(in, line); ) {
+        // Trim separators (there is no leading or trailing strip token)
+        size_t begin = 0, end = line.size();
+        while (begin < end && std::isspace(static_cast<unsigned char>(line[begin]))) ++begin;
+        while (begin < end && std::isspace(static_cast<unsigned char>(line[end - 1]))) --end;
+        if (begin == end) continue;  // skip empty lines
+
+        sentence_t tokens;
+        for (size_t offset = begin; offset < end; ) {
+            const bool strip = is_separator(line[offset]);
+            size_t token_end = offset + 1;
+            while (token_end < end && is_separator(line[token_end]) == strip) ++token_end;
+
+            tokens.emplace_back(
+                augment_token(std::string_view(line).substr(offset, token_end - offset)),
+                strip);
+
+            offset = token_end;
+        }
+
+        sentences.push_back(std::move(tokens));
+    }
+
+    return sentences;
+}
+
+
+/** Text sentences (loaded once) */
+const std::vector<sentence_t> & sentences() {
+    static const auto sentences = tokenise(PERF_TEST_DATA_DIR "/test.txt");
+    return sentences;
+}
+
+
+/** Sequences (loaded once) */
+const std::vector<sentence_t> & sequences() {
+    static const auto sequences = tokenise(PERF_TEST_DATA_DIR "/sequences.txt");
+    return sequences;
+}
+
+
+/** Sequence bigrams (sum of its tokens bigrams, strip tokens included) */
+template <class Bigrams>
+std::vector<Bigrams> pattern_bigrams() {
+    std::vector<Bigrams> patterns;
+    patterns.reserve(sequences().size());
+
+    for (const auto & sequence: sequences()) {
+        Bigrams bgrms;
+        for (const auto & token: sequence) bgrms += Bigrams(libsdcxx::utf8, token.first);
+        patterns.push_back(std::move(bgrms));
+    }
+
+    return patterns;
+}
+
+
+/**
+ *  \brief  Match sentences
+ *
+ *  The 1st benchmark argument is the number of sentences matched per iteration;
+ *  0 means all of them.
+ *  A single matcher is re-used for all the sentences.
+ */
+template <class Matcher, class Patterns, class Threshold>
+void match_sentences(
+    benchmark::State & state, const Patterns & patterns, Threshold threshold)
+{
+    const auto & sntncs = sentences();
+    const size_t sntnc_cnt = 0 < state.range(0)
+        ? std::min<size_t>(state.range(0), sntncs.size())
+        : sntncs.size();
+
+    Matcher matcher;
+    size_t match_cnt = 0;
+    for (auto _: state) {
+        match_cnt = 0;
+        for (size_t i = 0; i < sntnc_cnt; ++i) {
+            matcher.clear();
+            for (const auto & [token, strip]: sntncs[i])
+                matcher.emplace_back(libsdcxx::utf8, token, strip);
+
+            matcher.match_all(patterns, threshold,
+                [&match_cnt](const libsdcxx::sequence_match & ) { ++match_cnt; });
+        }
+    }
+
+    state.counters["sentences"] = sntnc_cnt;
+    state.counters["matches"] = match_cnt;
+    state.SetItemsProcessed(state.iterations() * sntnc_cnt);
+}
+
+
+/** Match patterns given as a range of bigrams */
+template <class Matcher>
+void match_all(benchmark::State & state) {
+    using bigrams_t = typename Matcher::bigrams_t;
+
+    static const auto patterns = pattern_bigrams<bigrams_t>();
+    match_sentences<Matcher>(state, patterns, threshold);
+}
+
+
+/** Match patterns given as a range of bigrams (compile-time threshold) */
+template <class Matcher>
+void match_all_static(benchmark::State & state) {
+    using bigrams_t = typename Matcher::bigrams_t;
+
+    static const auto patterns = pattern_bigrams<bigrams_t>();
+    match_sentences<Matcher>(state, patterns, static_threshold());
+}
+
+
+/** Match frozen pattern set */
+template <class Matcher>
+void match_pattern_set(benchmark::State & state) {
+    using bigrams_t = typename Matcher::bigrams_t;
+    using char_t = typename bigrams_t::char_t;
+
+    static const libsdcxx::basic_pattern_set<char_t> patterns(pattern_bigrams<bigrams_t>());
+    match_sentences<Matcher>(state, patterns, threshold);
+}
+
+}  // end of anonymous namespace
+
+
+/** Register benchmark for 10, 100 and all the sentences */
+#define BENCHMARK_SENTENCES(func, matcher) \
+    BENCHMARK_TEMPLATE(func, matcher)->Unit(benchmark::kMillisecond) \
+        ->Arg(10)->Arg(100); \
+    BENCHMARK_TEMPLATE(func, matcher)->Unit(benchmark::kMillisecond) \
+        ->Arg(0)->Iterations(1)
+
+BENCHMARK_SENTENCES(match_all, libsdcxx::wsequence_matcher);
+BENCHMARK_SENTENCES(match_all, libsdcxx::wflat_sequence_matcher);
+BENCHMARK_SENTENCES(match_all, libsdcxx::wsketched_sequence_matcher);
+BENCHMARK_SENTENCES(match_all_static, libsdcxx::wsequence_matcher);
+BENCHMARK_SENTENCES(match_pattern_set, libsdcxx::wsequence_matcher);
+
+BENCHMARK_MAIN();
@@ -7,7 +7,7 @@ from time import time
 import re
 import string
 
-from pysdcxx import SequenceMatcher, Bigrams
+from pysdcxx import SequenceMatcher, Patterns, Bigrams
 
 
 def matching_perf(
@@ -27,12 +27,13 @@ def matching_perf(
 
     # Pre-compute sequence bigrams
     start = time()
-    sequences_bigrams = [
-        sum((Bigrams(token) for token in sequence), start=Bigrams())
-        for sequence in sequences
-    ]
+    sequences_bigrams = Patterns(
+        Bigrams.union(sequence) for sequence in sequences
+    )
     precomp_time = time() - start
 
+    matcher = SequenceMatcher()  # re-used for all the sentences
+
     total_time = 0.0
     match_cnt = 0
     sum_match_len = 0
@@ -41,19 +42,18 @@ def matching_perf(
         start = time()
 
         # Match all sequences to sentence
-        matcher = SequenceMatcher(sentence)
-        for seq_ix, sequence in enumerate(sequences_bigrams):
-            for match in matcher.match(sequence, threshold):
-                if print_matches:
-                    print(
-                        f"{match.score:.3}: "
-                        f"\"{''.join(sequences[seq_ix])}\" -> "
-                        f"\"{''.join(t for t, _ in sentence[match.begin:match.end])}\""
-                    )
-
-                match_cnt += 1
-                sum_match_len += match.end - match.begin
-                sum_match_score += match.score
+        matcher.assign(sentence)
+        for match in matcher.match_all(sequences_bigrams, threshold):
+            if print_matches:
+                print(
+                    f"{match.score:.3}: "
+                    f"\"{''.join(sequences[match.pattern])}\" -> "
+                    f"\"{''.join(t for t, _ in sentence[match.begin:match.end])}\""
+                )
+
+            match_cnt += 1
+            sum_match_len += match.end - match.begin
+            sum_match_score += match.score
 
         sent_time = time() - start
         total_time += sent_time
@@ -8,7 +8,8 @@ import re
 import string
 import random
 
-from pysdcxx import Bigrams, BigramMultiset, UnorderedBigramMultiset
+from pysdcxx import (
+    Bigrams, FlatBigrams, BigramMultiset, UnorderedBigramMultiset, HashedBigramMultiset)
 
 measure_pybigrams = True
 try:  # try to import Python multiset based bigrams implementation for comparison
@@ -247,8 +248,10 @@ def main(argv):
 
     # Produce performance statistics
     measure_perf(Bigrams, text, args.union_size_hwm)
+    measure_perf(FlatBigrams, text, args.union_size_hwm)
     measure_perf(BigramMultiset, text, args.union_size_hwm)
     measure_perf(UnorderedBigramMultiset, text, args.union_size_hwm)
+    measure_perf(HashedBigramMultiset, text, args.union_size_hwm)
     if measure_pybigrams:
         measure_perf(PyBigrams, text, args.union_size_hwm)
 
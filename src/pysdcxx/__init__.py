@@ -1,4 +1,9 @@
 from .bigrams import Bigrams
+from .flat_bigrams import FlatBigrams
 from .bigram_multiset import BigramMultiset
 from .unordered_bigram_multiset import UnorderedBigramMultiset
-from .sequence_matcher import SequenceMatcher
+from .hashed_bigram_multiset import HashedBigramMultiset
+from .sequence_matcher import SequenceMatcher, Patterns
+from .bigram_index import BigramIndex
+from .pattern_set import PatternSet
+from .stream_matcher import StreamMatcher
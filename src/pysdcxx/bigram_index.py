@@ -0,0 +1,89 @@
+from __future__ import annotations
+from typing import Union, Iterable, List
+from dataclasses import dataclass
+
+from .libpysdcxx import libpysdcxx
+from .bigrams import Bigrams
+
+
+class BigramIndex:
+    """
+    Inverted bigram index
+
+    Dictionary of bigram multisets (entries) allowing for fast lookup of all the entries
+    matching a query with Sørensen–Dice coefficient reaching a threshold.
+    Entry IDs are assigned in insertion order, starting from 0.
+    """
+
+    @dataclass
+    class Match:
+        """
+        Index match
+        :param entry: Matching entry ID
+        :param score: Sørensen–Dice similarity of the entry to the query
+        """
+        entry: int
+        score: float
+
+    def __init__(self, entries: Iterable[Union[str, Bigrams]] = (), reserve: int = 0):
+        """
+        :param entries: Entries (`str` or `Bigrams` objects)
+        :param reserve: Expected number of entries
+        """
+        self._impl = libpysdcxx.new_wbigram_index()
+
+        if reserve:
+            libpysdcxx.wbigram_index_reserve(self._impl, reserve)
+
+        for entry in entries:
+            self.insert(entry)
+
+    def __del__(self):
+        libpysdcxx.delete_wbigram_index(self._impl)
+
+    def __len__(self):
+        """
+        :return: Number of entries
+        """
+        return libpysdcxx.wbigram_index_size(self._impl)
+
+    def clear(self):
+        """
+        Remove all entries
+        """
+        libpysdcxx.wbigram_index_clear(self._impl)
+
+    def insert(self, entry: Union[str, Bigrams]) -> int:
+        """
+        Insert entry
+        :param entry: Entry (`str` or `Bigrams`)
+        :return: Entry ID
+        """
+        if not isinstance(entry, Bigrams):
+            entry = Bigrams(entry)
+
+        return libpysdcxx.wbigram_index_insert(self._impl, entry._impl)
+
+    def lookup(self, query: Union[str, Bigrams], threshold: float) -> List[BigramIndex.Match]:
+        """
+        Find all entries matching the query
+        :param query: Query (`str` or `Bigrams`)
+        :param threshold: Matching score (Sørensen–Dice coefficient) threshold (positive)
+        :return: Matches (in ascending entry ID order)
+        """
+        if not isinstance(query, Bigrams):
+            query = Bigrams(query)
+
+        # The native call releases the GIL, so the result buffer must not be shared
+        matches = libpysdcxx.new_bigram_index_matches()
+        try:
+            match_cnt = libpysdcxx.wbigram_index_lookup(
+                self._impl, query._impl, threshold, matches)
+
+            records = libpysdcxx.bigram_index_matches_data(matches)
+            return [
+                BigramIndex.Match(entry=record.entry, score=record.score)
+                for record in records[:match_cnt]
+            ]
+        finally:
+            libpysdcxx.delete_bigram_index_matches(matches)
@@ -1,5 +1,5 @@
 from __future__ import annotations
-from typing import Optional, ClassVar, Generator, Tuple
+from typing import Optional, ClassVar, Generator, Tuple, Sequence, List, Union
 import ctypes
 
 from .libpysdcxx import libpysdcxx
@@ -11,14 +11,42 @@ class Bigrams(Generator[Tuple[str, int], None, None]):
     Bigram multiset (custom implementation)
     """
 
+    class Error(Exception):
+        """
+        Bigrams error (access to a stale view)
+        """
+
     _str_fixed_len: ClassVar[int] = len("wbigrams(size: XXXXXXXXXX, {})")
 
-    def __init__(self, string: Optional[str] = None, _impl: Optional = None):
+    def __init__(
+        self,
+        string: Optional[Union[str, bytes]] = None,
+        _impl: Optional = None,
+        _owner: Optional = None,
+    ):
         """
         :param string: String from which bigrams multiset shall be created
+                       (`bytes` are taken as UTF-8, decoded natively)
         """
-        self._impl = libpysdcxx.new_wbigrams_str(ctypes.c_wchar_p(string)) \
-            if string is not None else _impl or libpysdcxx.new_wbigrams()
+        # Owner of the native object (read-only view if set); the owner provides
+        # `_generation()`, the view is only valid while it stays the same
+        self._owner = _owner
+        self._generation = _owner._generation() if _owner is not None else None
+        if isinstance(string, bytes):
+            self._native = libpysdcxx.new_wbigrams_utf8(string, len(string))
+        else:
+            self._native = libpysdcxx.new_wbigrams_str(ctypes.c_wchar_p(string)) \
+                if string is not None else _impl or libpysdcxx.new_wbigrams()
+
+    @property
+    def _impl(self):
+        """
+        :return: Native object (checked for validity if it's a view)
+        """
+        if self._owner is not None and self._owner._generation() != self._generation:
+            raise Bigrams.Error("Bigrams view is stale (its owner was modified)")
+
+        return self._native
 
     def __deepcopy__(self, memo):
         """
@@ -51,6 +79,7 @@ class Bigrams(Generator[Tuple[str, int], None, None]):
 
                 yield (ch1.value + ch2.value, cnt.value)
 
+                self._impl  # a view may become stale meanwhile (raises if so)
                 libpysdcxx.wbigrams_citer_inc(itr)
 
         finally:
@@ -68,6 +97,9 @@ class Bigrams(Generator[Tuple[str, int], None, None]):
         Update by `other` bigrams (in-place union)
         """
         assert isinstance(other, Bigrams)
+        if self._owner is not None:
+            raise TypeError("Bigrams view is read-only (make a copy first)")
+
         libpysdcxx.wbigrams_iadd(self._impl, other._impl)
         return self
 
@@ -78,6 +110,63 @@ class Bigrams(Generator[Tuple[str, int], None, None]):
         assert isinstance(other, Bigrams)
         return Bigrams(_impl=libpysdcxx.wbigrams_add(self._impl, other._impl))
 
+    def to_bytes(self) -> bytes:
+        """
+        Compact, versioned binary representation (see `from_bytes`)
+        :return: Binary representation
+        """
+        size = 26 + 20 * len(self)  # header, size varints and [key delta, count] varints
+        buff = ctypes.create_string_buffer(size)
+        size = libpysdcxx.wbigrams_binary(self._impl, buff, size)
+
+        return buff.raw[:size]
+
+    @staticmethod
+    def from_bytes(data: bytes) -> Bigrams:
+        """
+        Construct bigrams from binary representation (see `to_bytes`)
+        :param data: Binary representation
+        :return: Bigrams
+        """
+        impl = libpysdcxx.new_wbigrams_binary(data, len(data))
+        if not impl:
+            raise ValueError("Malformed bigrams binary")
+
+        return Bigrams(_impl=impl)
+
+    @staticmethod
+    def bulk(strings: Sequence[str]) -> List[Bigrams]:
+        """
+        Construct bigrams of many strings at once (in one native call)
+        :param strings: Strings
+        :return: Bigrams of the strings
+        """
+        impls = (ctypes.c_void_p * len(strings))()
+        libpysdcxx.new_wbigrams_bulk(
+            (ctypes.c_wchar_p * len(strings))(*strings), len(strings), impls)
+
+        return [Bigrams(_impl=impl) for impl in impls]
+
+    @staticmethod
+    def union(strings: Sequence[str]) -> Bigrams:
+        """
+        Construct union of bigrams of many strings at once (in one native call)
+        :param strings: Strings
+        :return: Union of the strings' bigrams
+        """
+        return Bigrams(_impl=libpysdcxx.new_wbigrams_union(
+            (ctypes.c_wchar_p * len(strings))(*strings), len(strings)))
+
+    @staticmethod
+    def unite(bigrams: Sequence[Bigrams]) -> Bigrams:
+        """
+        Construct union of many bigrams at once (one k-way merge, in one native call)
+        :param bigrams: Bigrams
+        :return: Union of the bigrams
+        """
+        impls = (ctypes.c_void_p * len(bigrams))(*(bgrms._impl for bgrms in bigrams))
+        return Bigrams(_impl=libpysdcxx.new_wbigrams_unite(impls, len(bigrams)))
+
     @staticmethod
     def intersect_size(bgrms1: Bigrams, bgrms2: Bigrams) -> int:
         """
@@ -103,5 +192,20 @@ class Bigrams(Generator[Tuple[str, int], None, None]):
             libpysdcxx.wbigrams_str,
         )
 
+    @property
+    def is_view(self) -> bool:
+        """
+        :return: `True` iff the object is a read-only view of bigrams owned elsewhere
+        """
+        return self._owner is not None
+
+    @property
+    def is_stale(self) -> bool:
+        """
+        :return: `True` iff the object is a view invalidated by its owner modification
+        """
+        return self._owner is not None and self._owner._generation() != self._generation
+
     def __del__(self):
-        libpysdcxx.delete_wbigrams(self._impl)
+        if self._owner is None:
+            libpysdcxx.delete_wbigrams(self._native)
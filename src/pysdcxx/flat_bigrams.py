@@ -0,0 +1,107 @@
+from __future__ import annotations
+from typing import Optional, ClassVar, Generator, Tuple
+import ctypes
+
+from .libpysdcxx import libpysdcxx
+from .util import serialise
+
+
+class FlatBigrams(Generator[Tuple[str, int], None, None]):
+    """
+    Bigram multiset (custom implementation, flat storage)
+    """
+
+    _str_fixed_len: ClassVar[int] = len("wflat_bigrams(size: XXXXXXXXXX, {})")
+
+    def __init__(self, string: Optional[str] = None, _impl: Optional = None):
+        """
+        :param string: String from which bigrams multiset shall be created
+        """
+        self._impl = libpysdcxx.new_wflat_bigrams_str(ctypes.c_wchar_p(string)) \
+            if string is not None else _impl or libpysdcxx.new_wflat_bigrams()
+
+    def __deepcopy__(self, memo):
+        """
+        Make a copy on the native level
+        :param memo: IDs of already copied objects (unused, we're non-recursive)
+        """
+        return FlatBigrams(_impl=libpysdcxx.new_wflat_bigrams_copy(self._impl))
+
+    def __copy__(self):
+        """
+        We don't do shallow copies
+        """
+        return self.__deepcopy__(None)
+
+    def __len__(self):
+        return libpysdcxx.wflat_bigrams_size(self._impl)
+
+    def __iter__(self):
+        """
+        :return: Generator of bigrams together with their counts as tuple[str, int]
+        """
+        itr = libpysdcxx.wflat_bigrams_cbegin(self._impl)
+        end = libpysdcxx.wflat_bigrams_cend(self._impl)
+        try:
+            while libpysdcxx.wflat_bigrams_citer_ne(itr, end):
+                ch1, ch2 = ctypes.c_wchar(), ctypes.c_wchar()
+                cnt = ctypes.c_size_t()
+                libpysdcxx.wflat_bigrams_citer_deref(
+                    itr, ctypes.byref(ch1), ctypes.byref(ch2), ctypes.byref(cnt))
+
+                yield (ch1.value + ch2.value, cnt.value)
+
+                libpysdcxx.wflat_bigrams_citer_inc(itr)
+
+        finally:
+            libpysdcxx.delete_wflat_bigrams_citer(end)
+            libpysdcxx.delete_wflat_bigrams_citer(itr)
+
+    def send(self):
+        pass
+
+    def throw(self):
+        pass
+
+    def __iadd__(self, other: FlatBigrams) -> FlatBigrams:
+        """
+        Update by `other` bigrams (in-place union)
+        """
+        assert isinstance(other, FlatBigrams)
+        libpysdcxx.wflat_bigrams_iadd(self._impl, other._impl)
+        return self
+
+    def __add__(self, other: FlatBigrams) -> FlatBigrams:
+        """
+        :return: Union of `self` and `other` bigrams
+        """
+        assert isinstance(other, FlatBigrams)
+        return FlatBigrams(_impl=libpysdcxx.wflat_bigrams_add(self._impl, other._impl))
+
+    @staticmethod
+    def intersect_size(bgrms1: FlatBigrams, bgrms2: FlatBigrams) -> int:
+        """
+        :return: Cardinality of intersection of `bgrms1` and `bgrms2` multisets
+        """
+        assert isinstance(bgrms1, FlatBigrams)
+        assert isinstance(bgrms2, FlatBigrams)
+        return libpysdcxx.wflat_bigrams_intersect_size(bgrms1._impl, bgrms2._impl)
+
+    @staticmethod
+    def sorensen_dice_coef(bgrms1: FlatBigrams, bgrms2: FlatBigrams) -> float:
+        """
+        :return: Sørensen–Dice coefficient of `bgrms1` and `bgrms2` multisets
+        """
+        assert isinstance(bgrms1, FlatBigrams)
+        assert isinstance(bgrms2, FlatBigrams)
+        return libpysdcxx.wflat_bigrams_sorensen_dice_coef(bgrms1._impl, bgrms2._impl)
+
+    def __str__(self):
+        return serialise(
+            self,
+            FlatBigrams._str_fixed_len + 10 * len(self),
+            libpysdcxx.wflat_bigrams_str,
+        )
+
+    def __del__(self):
+        libpysdcxx.delete_wflat_bigrams(self._impl)
@@ -0,0 +1,117 @@
+from __future__ import annotations
+from typing import Optional, ClassVar, Generator
+import ctypes
+
+from .libpysdcxx import libpysdcxx
+from .util import serialise
+
+
+class HashedBigramMultiset(Generator[str, None, None]):
+    """
+    Hashed bigram multiset (implemented by counted open addressing hash map)
+    """
+
+    _str_fixed_len: ClassVar[int] = \
+        len("hashed_wbigram_multiset(size: XXXXXXXXXX, {})")
+
+    def __init__(self, string: Optional[str] = None, _impl: Optional = None):
+        """
+        :param string: String from which bigrams multiset shall be created
+        """
+        self._impl = libpysdcxx.new_hashed_wbigram_multiset_str(ctypes.c_wchar_p(string)) \
+            if string is not None else _impl or libpysdcxx.new_hashed_wbigram_multiset()
+
+    def __deepcopy__(self, memo):
+        """
+        Make a copy on the native level
+        :param memo: IDs of already copied objects (unused, we're non-recursive)
+        """
+        return HashedBigramMultiset(
+            _impl=libpysdcxx.new_hashed_wbigram_multiset_copy(self._impl))
+
+    def __copy__(self):
+        """
+        We don't do shallow copies
+        """
+        return self.__deepcopy__(None)
+
+    def __len__(self):
+        return libpysdcxx.hashed_wbigram_multiset_size(self._impl)
+
+    def __iter__(self):
+        """
+        :return: Generator of bigrams together with their counts as tuple[str, int]
+        """
+        itr = libpysdcxx.hashed_wbigram_multiset_cbegin(self._impl)
+        end = libpysdcxx.hashed_wbigram_multiset_cend(self._impl)
+        try:
+            while libpysdcxx.hashed_wbigram_multiset_citer_ne(itr, end):
+                ch1, ch2 = ctypes.c_wchar(), ctypes.c_wchar()
+                libpysdcxx.hashed_wbigram_multiset_citer_deref(
+                    itr, ctypes.byref(ch1), ctypes.byref(ch2))
+
+                yield ch1.value + ch2.value
+
+                libpysdcxx.hashed_wbigram_multiset_citer_inc(itr)
+
+        finally:
+            libpysdcxx.delete_hashed_wbigram_multiset_citer(end)
+            libpysdcxx.delete_hashed_wbigram_multiset_citer(itr)
+
+    def send(self):
+        pass
+
+    def throw(self):
+        pass
+
+    def __iadd__(self, other: HashedBigramMultiset) -> HashedBigramMultiset:
+        """
+        Update by `other` bigrams (in-place union)
+        """
+        assert isinstance(other, HashedBigramMultiset)
+        libpysdcxx.hashed_wbigram_multiset_iadd(self._impl, other._impl)
+        return self
+
+    def __add__(self, other: HashedBigramMultiset) -> HashedBigramMultiset:
+        """
+        :return: Union of `self` and `other` bigrams
+        """
+        assert isinstance(other, HashedBigramMultiset)
+        return HashedBigramMultiset(
+            _impl=libpysdcxx.hashed_wbigram_multiset_add(self._impl, other._impl))
+
+    @staticmethod
+    def intersect_size(
+        bgrms1: HashedBigramMultiset,
+        bgrms2: HashedBigramMultiset,
+    ) -> int:
+        """
+        :return: Cardinality of intersection of `bgrms1` and `bgrms2` multisets
+        """
+        assert isinstance(bgrms1, HashedBigramMultiset)
+        assert isinstance(bgrms2, HashedBigramMultiset)
+        return libpysdcxx.hashed_wbigram_multiset_intersect_size(
+            bgrms1._impl, bgrms2._impl)
+
+    @staticmethod
+    def sorensen_dice_coef(
+        bgrms1: HashedBigramMultiset,
+        bgrms2: HashedBigramMultiset,
+    ) -> float:
+        """
+        :return: Sørensen–Dice coefficient of `bgrms1` and `bgrms2` multisets
+        """
+        assert isinstance(bgrms1, HashedBigramMultiset)
+        assert isinstance(bgrms2, HashedBigramMultiset)
+        return libpysdcxx.hashed_wbigram_multiset_sorensen_dice_coef(
+            bgrms1._impl, bgrms2._impl)
+
+    def __str__(self):
+        return serialise(
+            self,
+            HashedBigramMultiset._str_fixed_len + 4 * len(self),
+            libpysdcxx.hashed_wbigram_multiset_str,
+        )
+
+    def __del__(self):
+        libpysdcxx.delete_hashed_wbigram_multiset(self._impl)
@@ -29,6 +29,9 @@ def _load_libpysdcxx() -> ctypes.CDLL:
     if not shared_obj:  # bugger! x-(
         raise FileNotFoundError("Failed to find extension library")
 
+    # Note that CDLL (unlike PyDLL) releases the GIL for the duration of native calls;
+    # bulk calls (doing a lot of work per call) therefore allow Python threads to run
+    # in parallel
     return ctypes.cdll.LoadLibrary(shared_obj)
 
 
@@ -42,6 +45,40 @@ def _bind_bigrams(libpysdcxx: ctypes.CDLL):
     libpysdcxx.new_wbigrams_copy.argtypes = (ctypes.c_void_p, )
     libpysdcxx.new_wbigrams_copy.restype = ctypes.c_void_p
 
+    libpysdcxx.new_wbigrams_utf8.argtypes = (ctypes.c_char_p, ctypes.c_size_t)
+    libpysdcxx.new_wbigrams_utf8.restype = ctypes.c_void_p
+
+    libpysdcxx.new_wbigrams_binary.argtypes = (ctypes.c_char_p, ctypes.c_size_t)
+    libpysdcxx.new_wbigrams_binary.restype = ctypes.c_void_p
+
+    # Bulk constructors
+    libpysdcxx.new_wbigrams_bulk_utf8.argtypes = (
+        ctypes.c_char_p,
+        ctypes.POINTER(ctypes.c_size_t),
+        ctypes.c_size_t,
+        ctypes.POINTER(ctypes.c_void_p),
+    )
+    libpysdcxx.new_wbigrams_bulk_utf8.restype = None  # void
+
+    libpysdcxx.new_wbigrams_bulk.argtypes = (
+        ctypes.POINTER(ctypes.c_wchar_p),
+        ctypes.c_size_t,
+        ctypes.POINTER(ctypes.c_void_p),
+    )
+    libpysdcxx.new_wbigrams_bulk.restype = None  # void
+
+    libpysdcxx.new_wbigrams_union.argtypes = (
+        ctypes.POINTER(ctypes.c_wchar_p),
+        ctypes.c_size_t,
+    )
+    libpysdcxx.new_wbigrams_union.restype = ctypes.c_void_p
+
+    libpysdcxx.new_wbigrams_unite.argtypes = (
+        ctypes.POINTER(ctypes.c_void_p),
+        ctypes.c_size_t,
+    )
+    libpysdcxx.new_wbigrams_unite.restype = ctypes.c_void_p
+
     # Destructor
     libpysdcxx.delete_wbigrams.argtypes = (ctypes.c_void_p, )
     libpysdcxx.delete_wbigrams.restype = None  # void
@@ -50,6 +87,14 @@ def _bind_bigrams(libpysdcxx: ctypes.CDLL):
     libpysdcxx.wbigrams_size.argtypes = (ctypes.c_void_p, )
     libpysdcxx.wbigrams_size.restype = ctypes.c_size_t
 
+    # Binary representation
+    libpysdcxx.wbigrams_binary.argtypes = (
+        ctypes.c_void_p,
+        ctypes.c_char_p,
+        ctypes.c_size_t,
+    )
+    libpysdcxx.wbigrams_binary.restype = ctypes.c_size_t
+
     # Iterators
     libpysdcxx.wbigrams_cbegin.argtypes = (ctypes.c_void_p, )
     libpysdcxx.wbigrams_cbegin.restype = ctypes.c_void_p
@@ -97,6 +142,74 @@ def _bind_bigrams(libpysdcxx: ctypes.CDLL):
     libpysdcxx.wbigrams_str.restype = ctypes.c_size_t
 
 
+def _bind_flat_bigrams(libpysdcxx: ctypes.CDLL):
+    # Constructors
+    libpysdcxx.new_wflat_bigrams.restype = ctypes.c_void_p
+
+    libpysdcxx.new_wflat_bigrams_str.argtypes = (ctypes.c_wchar_p, )
+    libpysdcxx.new_wflat_bigrams_str.restype = ctypes.c_void_p
+
+    libpysdcxx.new_wflat_bigrams_copy.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.new_wflat_bigrams_copy.restype = ctypes.c_void_p
+
+    # Destructor
+    libpysdcxx.delete_wflat_bigrams.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.delete_wflat_bigrams.restype = None  # void
+
+    # Size
+    libpysdcxx.wflat_bigrams_size.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.wflat_bigrams_size.restype = ctypes.c_size_t
+
+    # Iterators
+    libpysdcxx.wflat_bigrams_cbegin.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.wflat_bigrams_cbegin.restype = ctypes.c_void_p
+
+    libpysdcxx.wflat_bigrams_cend.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.wflat_bigrams_cend.restype = ctypes.c_void_p
+
+    libpysdcxx.wflat_bigrams_citer_ne.argtypes = (ctypes.c_void_p, ctypes.c_void_p)
+    libpysdcxx.wflat_bigrams_citer_ne.restype = ctypes.c_int
+
+    libpysdcxx.wflat_bigrams_citer_deref.argtypes = (
+        ctypes.c_void_p,
+        ctypes.POINTER(ctypes.c_wchar),
+        ctypes.POINTER(ctypes.c_wchar),
+        ctypes.POINTER(ctypes.c_size_t),
+    )
+    libpysdcxx.wflat_bigrams_citer_deref.restype = None  # void
+
+    libpysdcxx.wflat_bigrams_citer_inc.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.wflat_bigrams_citer_inc.restype = None  # void
+
+    libpysdcxx.delete_wflat_bigrams_citer.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.delete_wflat_bigrams_citer.restype = None  # void
+
+    # Union (add operators)
+    libpysdcxx.wflat_bigrams_iadd.argtypes = (ctypes.c_void_p, ctypes.c_void_p)
+    libpysdcxx.wflat_bigrams_iadd.restype = ctypes.c_void_p
+
+    libpysdcxx.wflat_bigrams_add.argtypes = (ctypes.c_void_p, ctypes.c_void_p)
+    libpysdcxx.wflat_bigrams_add.restype = ctypes.c_void_p
+
+    # SDC
+    libpysdcxx.wflat_bigrams_intersect_size.argtypes = (ctypes.c_void_p, ctypes.c_void_p)
+    libpysdcxx.wflat_bigrams_intersect_size.restype = ctypes.c_size_t
+
+    libpysdcxx.wflat_bigrams_sorensen_dice_coef.argtypes = (
+        ctypes.c_void_p,
+        ctypes.c_void_p,
+    )
+    libpysdcxx.wflat_bigrams_sorensen_dice_coef.restype = ctypes.c_double
+
+    # Serialisation
+    libpysdcxx.wflat_bigrams_str.argtypes = (
+        ctypes.c_void_p,
+        ctypes.POINTER(ctypes.c_wchar),
+        ctypes.c_size_t,
+    )
+    libpysdcxx.wflat_bigrams_str.restype = ctypes.c_size_t
+
+
 def _bind_bigram_multiset(libpysdcxx: ctypes.CDLL):
     # Constructors
     libpysdcxx.new_wbigram_multiset.restype = ctypes.c_void_p
@@ -246,6 +359,114 @@ def _bind_unordered_bigram_multiset(libpysdcxx: ctypes.CDLL):
     libpysdcxx.unordered_wbigram_multiset_str.restype = ctypes.c_size_t
 
 
+def _bind_hashed_bigram_multiset(libpysdcxx: ctypes.CDLL):
+    # Constructors
+    libpysdcxx.new_hashed_wbigram_multiset.restype = ctypes.c_void_p
+
+    libpysdcxx.new_hashed_wbigram_multiset_str.argtypes = (ctypes.c_wchar_p, )
+    libpysdcxx.new_hashed_wbigram_multiset_str.restype = ctypes.c_void_p
+
+    libpysdcxx.new_hashed_wbigram_multiset_copy.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.new_hashed_wbigram_multiset_copy.restype = ctypes.c_void_p
+
+    # Destructor
+    libpysdcxx.delete_hashed_wbigram_multiset.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.delete_hashed_wbigram_multiset.restype = None  # void
+
+    # Size
+    libpysdcxx.hashed_wbigram_multiset_size.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.hashed_wbigram_multiset_size.restype = ctypes.c_size_t
+
+    # Iterators
+    libpysdcxx.hashed_wbigram_multiset_cbegin.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.hashed_wbigram_multiset_cbegin.restype = ctypes.c_void_p
+
+    libpysdcxx.hashed_wbigram_multiset_cend.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.hashed_wbigram_multiset_cend.restype = ctypes.c_void_p
+
+    libpysdcxx.hashed_wbigram_multiset_citer_ne.argtypes = (
+        ctypes.c_void_p,
+        ctypes.c_void_p,
+    )
+    libpysdcxx.hashed_wbigram_multiset_citer_ne.restype = ctypes.c_int
+
+    libpysdcxx.hashed_wbigram_multiset_citer_deref.argtypes = (
+        ctypes.c_void_p,
+        ctypes.POINTER(ctypes.c_wchar),
+        ctypes.POINTER(ctypes.c_wchar),
+    )
+    libpysdcxx.hashed_wbigram_multiset_citer_deref.restype = None  # void
+
+    libpysdcxx.hashed_wbigram_multiset_citer_inc.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.hashed_wbigram_multiset_citer_inc.restype = None  # void
+
+    libpysdcxx.delete_hashed_wbigram_multiset_citer.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.delete_hashed_wbigram_multiset_citer.restype = None  # void
+
+    # Union (add operators)
+    libpysdcxx.hashed_wbigram_multiset_iadd.argtypes = (
+        ctypes.c_void_p,
+        ctypes.c_void_p,
+    )
+    libpysdcxx.hashed_wbigram_multiset_iadd.restype = ctypes.c_void_p
+
+    libpysdcxx.hashed_wbigram_multiset_add.argtypes = (
+        ctypes.c_void_p,
+        ctypes.c_void_p,
+    )
+    libpysdcxx.hashed_wbigram_multiset_add.restype = ctypes.c_void_p
+
+    # SDC
+    libpysdcxx.hashed_wbigram_multiset_intersect_size.argtypes = (
+        ctypes.c_void_p,
+        ctypes.c_void_p,
+    )
+    libpysdcxx.hashed_wbigram_multiset_intersect_size.restype = ctypes.c_size_t
+
+    libpysdcxx.hashed_wbigram_multiset_sorensen_dice_coef.argtypes = (
+        ctypes.c_void_p,
+        ctypes.c_void_p,
+    )
+    libpysdcxx.hashed_wbigram_multiset_sorensen_dice_coef.restype = ctypes.c_double
+
+    # Serialisation
+    libpysdcxx.hashed_wbigram_multiset_str.argtypes = (
+        ctypes.c_void_p,
+        ctypes.POINTER(ctypes.c_wchar),
+        ctypes.c_size_t,
+    )
+    libpysdcxx.hashed_wbigram_multiset_str.restype = ctypes.c_size_t
+
+
+class SequenceMatchRecord(ctypes.Structure):
+    """
+    Sequence match record (see `libsdcxx::sequence_match`)
+    """
+    _fields_ = [
+        ("pattern", ctypes.c_size_t),
+        ("begin", ctypes.c_size_t),
+        ("end", ctypes.c_size_t),
+        ("score", ctypes.c_double),
+    ]
+
+
+
+class MatchStatsRecord(ctypes.Structure):
+    """
+    Matching statistics record (see `libsdcxx::match_stats`)
+    """
+    _fields_ = [
+        ("visited", ctypes.c_size_t),
+        ("strip_skips", ctypes.c_size_t),
+        ("card_pruned", ctypes.c_size_t),
+        ("sdc_computations", ctypes.c_size_t),
+        ("threshold_rejects", ctypes.c_size_t),
+        ("sketch_rejects", ctypes.c_size_t),
+        ("unions", ctypes.c_size_t),
+        ("bytes_allocated", ctypes.c_size_t),
+    ]
+
+
 def _bind_sequence_matcher(libpysdcxx: ctypes.CDLL):
     # Constructor
     libpysdcxx.new_wsequence_matcher.restype = ctypes.c_void_p
@@ -258,6 +479,10 @@ def _bind_sequence_matcher(libpysdcxx: ctypes.CDLL):
     libpysdcxx.wsequence_matcher_reserve.argtypes = (ctypes.c_void_p, ctypes.c_size_t)
     libpysdcxx.wsequence_matcher_reserve.restype = None  # void
 
+    # Clear
+    libpysdcxx.wsequence_matcher_clear.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.wsequence_matcher_clear.restype = None  # void
+
     # Size
     libpysdcxx.wsequence_matcher_size.argtypes = (ctypes.c_void_p, )
     libpysdcxx.wsequence_matcher_size.restype = ctypes.c_size_t
@@ -278,6 +503,64 @@ def _bind_sequence_matcher(libpysdcxx: ctypes.CDLL):
     )
     libpysdcxx.wsequence_matcher_emplace_back.restype = None  # void
 
+    libpysdcxx.wsequence_matcher_emplace_back_utf8.argtypes = (
+        ctypes.c_void_p,
+        ctypes.c_char_p,
+        ctypes.c_size_t,
+        ctypes.c_int,
+    )
+    libpysdcxx.wsequence_matcher_emplace_back_utf8.restype = None  # void
+
+    # Bulk assignment
+    libpysdcxx.wsequence_matcher_assign_utf8.argtypes = (
+        ctypes.c_void_p,
+        ctypes.c_char_p,
+        ctypes.POINTER(ctypes.c_size_t),
+        ctypes.POINTER(ctypes.c_int),
+        ctypes.c_size_t,
+    )
+    libpysdcxx.wsequence_matcher_assign_utf8.restype = None  # void
+
+    libpysdcxx.wsequence_matcher_assign_tokens.argtypes = (
+        ctypes.c_void_p,
+        ctypes.POINTER(ctypes.c_wchar_p),
+        ctypes.POINTER(ctypes.c_int),
+        ctypes.c_size_t,
+    )
+    libpysdcxx.wsequence_matcher_assign_tokens.restype = None  # void
+
+    # Bulk match
+    libpysdcxx.wsequence_matcher_match.argtypes = (
+        ctypes.c_void_p,
+        ctypes.c_void_p,
+        ctypes.c_double,
+        ctypes.POINTER(SequenceMatchRecord),
+        ctypes.c_size_t,
+    )
+    libpysdcxx.wsequence_matcher_match.restype = ctypes.c_size_t
+
+    # Matching statistics
+    libpysdcxx.wsequence_matcher_stats.argtypes = (
+        ctypes.c_void_p,
+        ctypes.POINTER(MatchStatsRecord),
+    )
+    libpysdcxx.wsequence_matcher_stats.restype = None  # void
+
+    libpysdcxx.wsequence_matcher_reset_stats.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.wsequence_matcher_reset_stats.restype = None  # void
+
+    # Sub-sequence bigrams
+    libpysdcxx.wsequence_matcher_subsequence.argtypes = (
+        ctypes.c_void_p,
+        ctypes.c_size_t,
+        ctypes.c_size_t,
+    )
+    libpysdcxx.wsequence_matcher_subsequence.restype = ctypes.c_void_p
+
+    # Generation (sub-sequence bigrams views validity)
+    libpysdcxx.wsequence_matcher_generation.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.wsequence_matcher_generation.restype = ctypes.c_size_t
+
     # Match iterators
     libpysdcxx.wsequence_matcher_begin.argtypes = (
         ctypes.c_void_p,
@@ -321,9 +604,204 @@ def _bind_sequence_matcher(libpysdcxx: ctypes.CDLL):
     )
     libpysdcxx.wsequence_matcher_iter_str.restype = ctypes.c_size_t
 
+    # Multiple patterns matching
+    libpysdcxx.wsequence_matcher_match_all.argtypes = (
+        ctypes.c_void_p,
+        ctypes.POINTER(ctypes.c_void_p),
+        ctypes.c_size_t,
+        ctypes.c_double,
+        ctypes.c_void_p,
+    )
+    libpysdcxx.wsequence_matcher_match_all.restype = ctypes.c_size_t
+
+    # Best matches
+    libpysdcxx.wsequence_matcher_best_matches.argtypes = (
+        ctypes.c_void_p,
+        ctypes.c_void_p,
+        ctypes.c_size_t,
+        ctypes.c_double,
+        ctypes.c_int,
+        ctypes.c_void_p,
+    )
+    libpysdcxx.wsequence_matcher_best_matches.restype = ctypes.c_size_t
+
+    # Matches buffer
+    libpysdcxx.new_sequence_matches.restype = ctypes.c_void_p
+
+    libpysdcxx.delete_sequence_matches.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.delete_sequence_matches.restype = None  # void
+
+    libpysdcxx.sequence_matches_size.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.sequence_matches_size.restype = ctypes.c_size_t
+
+    libpysdcxx.sequence_matches_data.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.sequence_matches_data.restype = ctypes.POINTER(SequenceMatchRecord)
+
+
+class BigramIndexMatchRecord(ctypes.Structure):
+    """
+    Bigram index match record (see `libsdcxx::bigram_index_match`)
+    """
+    _fields_ = [
+        ("entry", ctypes.c_size_t),
+        ("score", ctypes.c_double),
+    ]
+
+
+def _bind_bigram_index(libpysdcxx: ctypes.CDLL):
+    # Constructor
+    libpysdcxx.new_wbigram_index.restype = ctypes.c_void_p
+
+    # Destructor
+    libpysdcxx.delete_wbigram_index.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.delete_wbigram_index.restype = None  # void
+
+    # Reserve
+    libpysdcxx.wbigram_index_reserve.argtypes = (ctypes.c_void_p, ctypes.c_size_t)
+    libpysdcxx.wbigram_index_reserve.restype = None  # void
+
+    # Size
+    libpysdcxx.wbigram_index_size.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.wbigram_index_size.restype = ctypes.c_size_t
+
+    # Clear
+    libpysdcxx.wbigram_index_clear.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.wbigram_index_clear.restype = None  # void
+
+    # Insert entry
+    libpysdcxx.wbigram_index_insert.argtypes = (ctypes.c_void_p, ctypes.c_void_p)
+    libpysdcxx.wbigram_index_insert.restype = ctypes.c_size_t
+
+    # Lookup
+    libpysdcxx.wbigram_index_lookup.argtypes = (
+        ctypes.c_void_p,
+        ctypes.c_void_p,
+        ctypes.c_double,
+        ctypes.c_void_p,
+    )
+    libpysdcxx.wbigram_index_lookup.restype = ctypes.c_size_t
+
+    # Matches buffer
+    libpysdcxx.new_bigram_index_matches.restype = ctypes.c_void_p
+
+    libpysdcxx.delete_bigram_index_matches.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.delete_bigram_index_matches.restype = None  # void
+
+    libpysdcxx.bigram_index_matches_data.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.bigram_index_matches_data.restype = \
+        ctypes.POINTER(BigramIndexMatchRecord)
+
+
+def _bind_pattern_set(libpysdcxx: ctypes.CDLL):
+    # Constructor
+    libpysdcxx.new_wpattern_set.argtypes = (
+        ctypes.POINTER(ctypes.c_void_p),
+        ctypes.c_size_t,
+        ctypes.c_int,
+    )
+    libpysdcxx.new_wpattern_set.restype = ctypes.c_void_p
+
+    libpysdcxx.wpattern_set_load.argtypes = (ctypes.c_char_p, ctypes.c_int)
+    libpysdcxx.wpattern_set_load.restype = ctypes.c_void_p
+
+    # Destructor
+    libpysdcxx.delete_wpattern_set.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.delete_wpattern_set.restype = None  # void
+
+    # Size
+    libpysdcxx.wpattern_set_size.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.wpattern_set_size.restype = ctypes.c_size_t
+
+    # Blob size
+    libpysdcxx.wpattern_set_blob_size.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.wpattern_set_blob_size.restype = ctypes.c_size_t
+
+    # Indexed
+    libpysdcxx.wpattern_set_indexed.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.wpattern_set_indexed.restype = ctypes.c_int
+
+    # Save
+    libpysdcxx.wpattern_set_save.argtypes = (ctypes.c_void_p, ctypes.c_char_p)
+    libpysdcxx.wpattern_set_save.restype = ctypes.c_int
+
+    # Lookup
+    libpysdcxx.wpattern_set_lookup.argtypes = (
+        ctypes.c_void_p,
+        ctypes.c_void_p,
+        ctypes.c_double,
+        ctypes.c_void_p,
+    )
+    libpysdcxx.wpattern_set_lookup.restype = ctypes.c_size_t
+
+    # Match all the set patterns
+    libpysdcxx.wsequence_matcher_match_set.argtypes = (
+        ctypes.c_void_p,
+        ctypes.c_void_p,
+        ctypes.c_double,
+        ctypes.c_void_p,
+    )
+    libpysdcxx.wsequence_matcher_match_set.restype = ctypes.c_size_t
+
+
+def _bind_stream_matcher(libpysdcxx: ctypes.CDLL):
+    # Constructor
+    libpysdcxx.new_wstream_matcher.argtypes = (
+        ctypes.POINTER(ctypes.c_void_p),
+        ctypes.c_size_t,
+        ctypes.c_double,
+        ctypes.c_size_t,
+    )
+    libpysdcxx.new_wstream_matcher.restype = ctypes.c_void_p
+
+    # Destructor
+    libpysdcxx.delete_wstream_matcher.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.delete_wstream_matcher.restype = None  # void
+
+    # Window & position
+    libpysdcxx.wstream_matcher_window.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.wstream_matcher_window.restype = ctypes.c_size_t
+
+    libpysdcxx.wstream_matcher_position.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.wstream_matcher_position.restype = ctypes.c_size_t
+
+    # Reset
+    libpysdcxx.wstream_matcher_reset.argtypes = (ctypes.c_void_p, )
+    libpysdcxx.wstream_matcher_reset.restype = None  # void
+
+    # Push token
+    libpysdcxx.wstream_matcher_push_back.argtypes = (
+        ctypes.c_void_p,
+        ctypes.c_void_p,
+        ctypes.c_int,
+        ctypes.c_void_p,
+    )
+    libpysdcxx.wstream_matcher_push_back.restype = ctypes.c_size_t
+
+    libpysdcxx.wstream_matcher_emplace_back.argtypes = (
+        ctypes.c_void_p,
+        ctypes.c_wchar_p,
+        ctypes.c_int,
+        ctypes.c_void_p,
+    )
+    libpysdcxx.wstream_matcher_emplace_back.restype = ctypes.c_size_t
+
+    libpysdcxx.wstream_matcher_emplace_back_utf8.argtypes = (
+        ctypes.c_void_p,
+        ctypes.c_char_p,
+        ctypes.c_size_t,
+        ctypes.c_int,
+        ctypes.c_void_p,
+    )
+    libpysdcxx.wstream_matcher_emplace_back_utf8.restype = ctypes.c_size_t
+
 
 libpysdcxx = _load_libpysdcxx()
 _bind_bigrams(libpysdcxx)
+_bind_flat_bigrams(libpysdcxx)
 _bind_bigram_multiset(libpysdcxx)
 _bind_unordered_bigram_multiset(libpysdcxx)
+_bind_hashed_bigram_multiset(libpysdcxx)
 _bind_sequence_matcher(libpysdcxx)
+_bind_bigram_index(libpysdcxx)
+_bind_pattern_set(libpysdcxx)
+_bind_stream_matcher(libpysdcxx)
@@ -0,0 +1,107 @@
+from __future__ import annotations
+from typing import Union, Iterable, List
+import ctypes
+import os
+
+from .libpysdcxx import libpysdcxx
+from .bigrams import Bigrams
+from .bigram_index import BigramIndex
+
+
+class PatternSet:
+    """
+    Frozen pattern set
+
+    Read-only, compact copy of patterns' bigrams (in one cache-aligned native blob),
+    which may be shared by any number of `SequenceMatcher`s (and threads) without locking.
+    Optionally, the set also carries an inverted index, allowing for fast lookup
+    of the patterns matching a query.
+    The set may be saved to a file and loaded (memory-mapped) back with no deserialisation.
+    """
+
+    def __init__(self, patterns: Iterable[Union[str, Bigrams]], index: bool = False):
+        """
+        :param patterns: Patterns (`str` tokens or `Bigrams` objects)
+        :param index: Build inverted index (for `lookup`)
+        """
+        bigrams = [
+            pattern if isinstance(pattern, Bigrams) else Bigrams(pattern)
+            for pattern in patterns
+        ]
+
+        impls = (ctypes.c_void_p * len(bigrams))(*(bgrms._impl for bgrms in bigrams))
+        self._impl = libpysdcxx.new_wpattern_set(impls, len(bigrams), 1 if index else 0)
+
+    def __del__(self):
+        libpysdcxx.delete_wpattern_set(self._impl)
+
+    @classmethod
+    def load(cls, path: Union[str, os.PathLike], index: bool = False) -> PatternSet:
+        """
+        Load saved set (the file is memory-mapped and used in place)
+        :param path: File path
+        :param index: Build inverted index (for `lookup`; the index isn't saved)
+        :return: Pattern set
+        """
+        impl = libpysdcxx.wpattern_set_load(os.fsencode(path), 1 if index else 0)
+        if not impl:
+            raise ValueError(f"Failed to load pattern set from {path}")
+
+        pattern_set = cls.__new__(cls)
+        pattern_set._impl = impl
+        return pattern_set
+
+    def save(self, path: Union[str, os.PathLike]):
+        """
+        Save the set (see `load`)
+        :param path: File path
+        """
+        if 0 != libpysdcxx.wpattern_set_save(self._impl, os.fsencode(path)):
+            raise OSError(f"Failed to save pattern set to {path}")
+
+    def __len__(self):
+        """
+        :return: Number of patterns
+        """
+        return libpysdcxx.wpattern_set_size(self._impl)
+
+    @property
+    def blob_size(self) -> int:
+        """
+        :return: Native blob size (in bytes)
+        """
+        return libpysdcxx.wpattern_set_blob_size(self._impl)
+
+    @property
+    def indexed(self) -> bool:
+        """
+        :return: `True` iff the set carries inverted index
+        """
+        return bool(libpysdcxx.wpattern_set_indexed(self._impl))
+
+    def lookup(self, query: Union[str, Bigrams], threshold: float) -> List[BigramIndex.Match]:
+        """
+        Find all patterns matching the query (requires the set to be indexed)
+        :param query: Query (`str` or `Bigrams`)
+        :param threshold: Matching score (Sørensen–Dice coefficient) threshold (positive)
+        :return: Matches (in ascending pattern index order)
+        """
+        if not self.indexed:
+            raise ValueError("Pattern set isn't indexed")
+
+        if not isinstance(query, Bigrams):
+            query = Bigrams(query)
+
+        # The native call releases the GIL, so the result buffer must not be shared
+        matches = libpysdcxx.new_bigram_index_matches()
+        try:
+            match_cnt = libpysdcxx.wpattern_set_lookup(
+                self._impl, query._impl, threshold, matches)
+
+            records = libpysdcxx.bigram_index_matches_data(matches)
+            return [
+                BigramIndex.Match(entry=record.entry, score=record.score)
+                for record in records[:match_cnt]
+            ]
+        finally:
+            libpysdcxx.delete_bigram_index_matches(matches)
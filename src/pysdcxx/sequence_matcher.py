@@ -1,10 +1,39 @@
 from __future__ import annotations
-from typing import Optional, ClassVar, Tuple, Union, Type
+from typing import Optional, ClassVar, Tuple, Union, Type, Iterable, List, Sequence
 from dataclasses import dataclass
 import ctypes
+import sys
 
-from .libpysdcxx import libpysdcxx
+from .libpysdcxx import libpysdcxx, SequenceMatchRecord, MatchStatsRecord
 from .bigrams import Bigrams
+from .pattern_set import PatternSet
+
+
+class Patterns:
+    """
+    Patterns collection for `SequenceMatcher.match_all`
+
+    Keeps the patterns `Bigrams` and their native handles array, so that the collection
+    may be prepared once and matched to many sentences.
+    """
+
+    def __init__(self, patterns: Iterable[Union[str, Bigrams]]):
+        """
+        :param patterns: Patterns (`str` tokens or `Bigrams` objects)
+        """
+        self.bigrams: List[Bigrams] = [
+            pattern if isinstance(pattern, Bigrams) else Bigrams(pattern)
+            for pattern in patterns
+        ]
+
+        self._impl = (ctypes.c_void_p * len(self.bigrams))(
+            *(bgrms._impl for bgrms in self.bigrams))
+
+    def __len__(self):
+        """
+        :return: Number of patterns
+        """
+        return len(self.bigrams)
 
 
 class SequenceMatcher:
@@ -20,7 +49,7 @@ class SequenceMatcher:
         Sequence matcher error
         """
 
-    TokenOrBigrams = Union[str, Bigrams]                        # token or token Bigrams
+    TokenOrBigrams = Union[str, bytes, Bigrams]                 # token or token Bigrams
     Token = Union[TokenOrBigrams, Tuple[TokenOrBigrams, bool]]  # token (with strip flag)
 
     @dataclass
@@ -31,11 +60,35 @@ class SequenceMatcher:
         :param end: Index just past the last token of the matching sub-sequence
         :param score: Sørensen–Dice similarity of the sub-sequence
         :param bigrams: Matching sub-sequence bigrams (if required)
+        :param pattern: Matching pattern index (see `match_all`)
         """
         begin: int
         end: int
         score: float
         bigrams: Optional[Bigrams]
+        pattern: Optional[int] = None
+
+    @dataclass
+    class Stats:
+        """
+        Matching statistics (see `stats`)
+        :param visited: Sub-sequences visited (matrix cells)
+        :param strip_skips: Sub-sequences skipped for "strip" begin or end token
+        :param card_pruned: Sub-sequences pruned by cardinality ratio
+        :param sdc_computations: Sub-sequence vs pattern SDC computations
+        :param threshold_rejects: SDC computations below the threshold
+        :param sketch_rejects: SDC computations avoided by bigrams sketch bound
+        :param unions: Sub-sequence bigrams unions materialised
+        :param bytes_allocated: Matrix memory allocated for the unions [B]
+        """
+        visited: int
+        strip_skips: int
+        card_pruned: int
+        sdc_computations: int
+        threshold_rejects: int
+        sketch_rejects: int
+        unions: int
+        bytes_allocated: int
 
     def __init__(
         self,
@@ -53,14 +106,57 @@ class SequenceMatcher:
         The `tokens` parameter is expected to iterate the sequence tokens.
         The following values are acceptable:
         * `str` token
+        * `bytes` token (UTF-8 encoded)
         * `Bigrams` object
         * `tuple[str,bool]` of `str` token together with "strip" flag (see `append`)
+        * `tuple[bytes,bool]` the same for `bytes` token
         * `tuple[Bigrams,bool]` the same for `Bigrams` object
 
         :param tokens: Token sequence
         :param reserve: Reserve space for `reserve` tokens of text (for 1-by-1 additions)
         """
         self._impl = libpysdcxx.new_wsequence_matcher()
+        self._matches = libpysdcxx.new_sequence_matches()
+        self._buffer = (SequenceMatchRecord * 64)()  # match records buffer
+        self.assign(tokens, reserve)
+
+    def assign(
+        self,
+        tokens: Optional[Iterable[Token]] = None,
+        reserve: int = 0,
+    ):
+        """
+        Replace the token sequence
+
+        Acceptable `tokens` and `reserve` parameters are the same as for the constructor.
+        The matcher memory is re-used, so a long-lived matcher processing one sentence
+        after another is cheaper than a new matcher per sentence.
+
+        :param tokens: Token sequence
+        :param reserve: Reserve space for `reserve` tokens of text (for 1-by-1 additions)
+        """
+        if tokens and hasattr(tokens, "__len__"):
+            strs, strips = [], []
+            for token in tokens:
+                strip = False
+                if isinstance(token, tuple):
+                    token, strip = token
+
+                if not isinstance(token, str):
+                    break  # not all the tokens are strings
+
+                strs.append(token)
+                strips.append(1 if strip else 0)
+
+            else:  # all tokens are strings, assign them in one native call
+                libpysdcxx.wsequence_matcher_assign_tokens(
+                    self._impl,
+                    (ctypes.c_wchar_p * len(strs))(*strs),
+                    (ctypes.c_int * len(strips))(*strips),
+                    len(strs))
+                return
+
+        self.clear()
 
         if tokens and hasattr(tokens, "__len__"):
             reserve = len(tokens)
@@ -74,6 +170,51 @@ class SequenceMatcher:
 
                 self.append(token, strip)
 
+    def assign_utf8(
+        self,
+        text: Union[bytes, bytearray, memoryview],
+        offsets: Sequence[int],
+        strips: Optional[Sequence[bool]] = None,
+    ):
+        """
+        Replace the token sequence by tokens of UTF-8 encoded text
+
+        The tokens are given by their offsets in the text: i-th token spans bytes
+        `text[offsets[i]:offsets[i+1]]` (there are `len(offsets) - 1` tokens).
+        The text is decoded natively, in one call; `bytes` are passed without copying,
+        as are writable buffers (e.g. `bytearray` or `mmap` opened for writing).
+
+        :param text: UTF-8 encoded text
+        :param offsets: Token offsets (in bytes)
+        :param strips: Token "strip" flags (see `append`), all `False` by default
+        """
+        cnt = max(len(offsets) - 1, 0)
+        if strips is not None and len(strips) != cnt:
+            raise SequenceMatcher.Error(f"{len(strips)} strip flags for {cnt} tokens")
+
+        if cnt and not (
+            0 <= offsets[0] and offsets[-1] <= len(text) and
+            all(begin <= end for begin, end in zip(offsets, offsets[1:]))
+        ):
+            raise SequenceMatcher.Error("Invalid token offsets")
+
+        if not isinstance(text, bytes):
+            text = (ctypes.c_char * len(text)).from_buffer(text) \
+                if not memoryview(text).readonly else bytes(text)
+
+        libpysdcxx.wsequence_matcher_assign_utf8(
+            self._impl,
+            text,
+            (ctypes.c_size_t * len(offsets))(*offsets),
+            (ctypes.c_int * cnt)(*strips) if strips is not None else None,
+            cnt)
+
+    def clear(self):
+        """
+        Remove the token sequence (the matcher memory is kept for re-use)
+        """
+        libpysdcxx.wsequence_matcher_clear(self._impl)
+
     def reserve(self, size: int):
         """
         Reserve space for token bigrams
@@ -88,7 +229,7 @@ class SequenceMatcher:
         If the `strip` parameter is set to true, the matcher shall not produce matches
         which begin or end with that token.
 
-        :param token: Appended token (may be a string or `Bigrams` object)
+        :param token: Appended token (may be a string, UTF-8 bytes or `Bigrams` object)
         :param strip: Whether matches may begin/ end by the token or not
         """
         strip_int = 1 if strip else 0
@@ -97,6 +238,9 @@ class SequenceMatcher:
             libpysdcxx.wsequence_matcher_push_back(self._impl, token._impl, strip_int)
         elif isinstance(token, str):
             libpysdcxx.wsequence_matcher_emplace_back(self._impl, token, strip_int)
+        elif isinstance(token, bytes):
+            libpysdcxx.wsequence_matcher_emplace_back_utf8(
+                self._impl, token, len(token), strip_int)
         else:
             raise SequenceMatcher.Error(f"Unsupported token: {token}")
 
@@ -120,6 +264,38 @@ class SequenceMatcher:
         """
         return self.__deepcopy__(None)
 
+    @staticmethod
+    def _bigrams(tokens: Union[TokenOrBigrams, Iterable[TokenOrBigrams]]) -> Bigrams:
+        """
+        :param tokens: Matched tokens specification (see `match`)
+        :return: Tokens bigrams
+        """
+        if isinstance(tokens, Bigrams):  # single bigram multiset
+            return tokens
+
+        if isinstance(tokens, (str, bytes)):  # single token
+            return Bigrams(tokens)
+
+        if not hasattr(tokens, "__iter__"):
+            raise SequenceMatcher.Error(f"Unsupported tokens: {tokens}")
+
+        tokens = list(tokens)
+        if all(isinstance(token, str) for token in tokens):  # one native call
+            return Bigrams.union(tokens)
+
+        bgrms = []  # create Bigrams union (one k-way merge)
+        for token in tokens:
+            if isinstance(token, Bigrams):
+                pass
+            elif isinstance(token, (str, bytes)):
+                token = Bigrams(token)
+            else:
+                raise SequenceMatcher.Error(f"Unsupported token: {token}")
+
+            bgrms.append(token)
+
+        return Bigrams.unite(bgrms)
+
     def match(
         self,
         tokens: Union[TokenOrBigrams, Iterable[TokenOrBigrams]],
@@ -130,9 +306,9 @@ class SequenceMatcher:
         Match `tokens` to the matcher-managed token sequence
 
         The function can, again, accept various types for the `tokens` parameter:
-        * A `str` token
+        * A `str` token (or UTF-8 encoded `bytes` token)
         * A `Bigrams` object
-        * An iterable of `str` tokens
+        * An iterable of `str` (or `bytes`) tokens
         * An iterable of `Bigrams` objects
 
         Produced match may take 2 possible forms:
@@ -145,53 +321,246 @@ class SequenceMatcher:
         Match score is the calculated Sørensen–Dice similarity of the matching
         sub-sequence and the specified `token`.
         If `include_bigrams` is `True`, the tuple shall also contain the matching
-        sub-sequence bigrams.
+        sub-sequence bigrams, as a read-only view (see `subsequence`).
 
         Matches are produced in lexicographic order of ascending begin and length.
+        All the matches are obtained in one native call (the GIL is released for its
+        duration).  For many matches, consider `match_records`.
 
         :param tokens: Matched tokens specification
         :param threshold: Matching score (Sørensen–Dice coefficient) threshold
         :param include_bigrams: Include matching sub-sequence bigrams in match tuple
         :return: Generator of matches
         """
-        if isinstance(tokens, Bigrams):  # single bigram multiset
-            bgrms = tokens
+        bgrms = SequenceMatcher._bigrams(tokens)
+
+        records, match_cnt = self._match(bgrms, threshold)
+
+        yield from [  # note that the buffer is re-used, so the matches are copied
+            SequenceMatcher.Match(
+                begin=record.begin,
+                end=record.end,
+                score=record.score,
+                bigrams=self.subsequence(record.begin, record.end) \
+                    if include_bigrams else None,
+            )
+            for record in records[:match_cnt]
+        ]
+
+    def _match(self, bgrms: Bigrams, threshold: float) -> Tuple[ctypes.Array, int]:
+        """
+        Get all the matches in one native call
+        :param bgrms: Matched bigrams
+        :param threshold: Matching score (Sørensen–Dice coefficient) threshold
+        :return: Match records buffer (re-used) and number of matches
+        """
+        match_cnt = libpysdcxx.wsequence_matcher_match(
+            self._impl, bgrms._impl, threshold, self._buffer, len(self._buffer))
 
-        elif isinstance(tokens, str):  # single token
-            bgrms = Bigrams(tokens)
+        if match_cnt > len(self._buffer):  # buffer too small, enlarge and retry
+            self._buffer = (SequenceMatchRecord * (2 * match_cnt))()
+            match_cnt = libpysdcxx.wsequence_matcher_match(
+                self._impl, bgrms._impl, threshold, self._buffer, len(self._buffer))
 
-        elif hasattr(tokens, "__iter__"):  # create Bigrams union
-            bgrms = Bigrams()
-            for token in tokens:
-                if isinstance(token, Bigrams):
-                    pass
-                elif isinstance(token, str):
-                    token = Bigrams(token)
-                else:
-                    raise SequenceMatcher.Error(f"Unsupported token: {token}")
+        return self._buffer, match_cnt
+
+    def match_records(
+        self,
+        tokens: Union[TokenOrBigrams, Iterable[TokenOrBigrams]],
+        threshold: float,
+    ) -> ctypes.Array:
+        """
+        Match `tokens` to the matcher-managed token sequence, get match records
 
-                bgrms += token
+        Same as `match`, but no Python object is created per match; the matches
+        are returned as a ctypes array of `SequenceMatchRecord` structures (fields
+        `pattern` (always 0), `begin`, `end` and `score`) filled in by the native code.
+        The array supports the buffer protocol, so it may be accessed without copying,
+        e.g. as a NumPy structured array via `numpy.ctypeslib.as_array(records)`.
+        Sub-sequence bigrams may be obtained (lazily) by `subsequence`.
 
-        else:
-            raise SequenceMatcher.Error(f"Unsupported token: {token}")
+        :param tokens: Matched tokens specification (see `match`)
+        :param threshold: Matching score (Sørensen–Dice coefficient) threshold
+        :return: Match records
+        """
+        bgrms = SequenceMatcher._bigrams(tokens)
+
+        records, match_cnt = self._match(bgrms, threshold)
+        result = (SequenceMatchRecord * match_cnt)()
+        ctypes.memmove(result, records, ctypes.sizeof(result))
+
+        return result
+
+    def subsequence(self, begin: int, end: int) -> Bigrams:
+        """
+        Get sub-sequence bigrams
+
+        The bigrams are a read-only view of the matcher bigrams matrix cell (no copy
+        is made); the view is only valid until the token sequence is modified
+        (or the cell evicted from a bounded cache), its use raises `Bigrams.Error`
+        then.  Use `copy` to keep the bigrams for longer.
+
+        :param begin: Sub-sequence begin (index of the 1st token)
+        :param end: Sub-sequence end (index just past the last token)
+        :return: Sub-sequence bigrams view
+        """
+        if not 0 <= begin < end <= len(self):
+            raise SequenceMatcher.Error(f"Invalid sub-sequence [{begin}, {end})")
+
+        return Bigrams(
+            _impl=libpysdcxx.wsequence_matcher_subsequence(self._impl, begin, end),
+            _owner=self)
+
+    def _generation(self) -> int:
+        """
+        :return: Matcher generation (changes whenever sub-sequence views are invalidated)
+        """
+        return libpysdcxx.wsequence_matcher_generation(self._impl)
+
+    def stats(self) -> SequenceMatcher.Stats:
+        """
+        Get matching statistics
+
+        All the matching done by the matcher since its construction (or `reset_stats`)
+        is counted, so that it's possible to tell why matching is slow.
+
+        :return: Matching statistics
+        """
+        record = MatchStatsRecord()
+        libpysdcxx.wsequence_matcher_stats(self._impl, ctypes.byref(record))
+
+        return SequenceMatcher.Stats(**{
+            field: getattr(record, field) for field, _ in MatchStatsRecord._fields_})
+
+    def reset_stats(self):
+        """
+        Reset matching statistics
+        """
+        libpysdcxx.wsequence_matcher_reset_stats(self._impl)
 
-        itr = libpysdcxx.wsequence_matcher_begin(self._impl, bgrms._impl, threshold)
-        end = libpysdcxx.wsequence_matcher_end(self._impl)
-        try:
-            while libpysdcxx.wsequence_matcher_iter_ne(itr, end):
-                yield SequenceMatcher.Match(
-                    begin=libpysdcxx.wsequence_matcher_iter_begin(itr),
-                    end=libpysdcxx.wsequence_matcher_iter_end(itr),
-                    score=libpysdcxx.wsequence_matcher_iter_sdc(itr),
-                    bigrams=Bigrams(_impl=libpysdcxx.wsequence_matcher_iter_deref(itr)) \
-                        if include_bigrams else None,
-                )
+    def best_matches(
+        self,
+        tokens: Union[TokenOrBigrams, Iterable[TokenOrBigrams]],
+        k: int = 1,
+        threshold: float = sys.float_info.min,
+        non_overlapping: bool = False,
+    ) -> List[SequenceMatcher.Match]:
+        """
+        Find the best matches of `tokens` to the matcher-managed token sequence
+
+        Up to `k` matches with the highest score are found; ties are resolved in favour
+        of the 1st match in the usual match order (by begin and length).
+        That's faster than getting all the matches and sorting them, as the threshold
+        is raised as better matches are found.
+
+        If `non_overlapping` is `True`, the matches are selected greedily by score,
+        dropping those overlapping an already selected one.
+
+        :param tokens: Matched tokens specification (see `match`)
+        :param k: Max. number of matches
+        :param threshold: Matching score (Sørensen–Dice coefficient) threshold (positive)
+        :param non_overlapping: Drop overlapping matches
+        :return: Matches in descending order by score
+        """
+        bgrms = SequenceMatcher._bigrams(tokens)
+
+        match_cnt = libpysdcxx.wsequence_matcher_best_matches(
+            self._impl, bgrms._impl, k, threshold, int(non_overlapping), self._matches)
+
+        records = libpysdcxx.sequence_matches_data(self._matches)
+        return [
+            SequenceMatcher.Match(
+                begin=record.begin,
+                end=record.end,
+                score=record.score,
+                bigrams=None,
+            )
+            for record in records[:match_cnt]
+        ]
+
+    def match_all(
+        self,
+        patterns: Union[Patterns, PatternSet, Iterable[Union[str, Bigrams]]],
+        threshold: float,
+    ) -> List[SequenceMatcher.Match]:
+        """
+        Match multiple patterns to the matcher-managed token sequence at once
+
+        This is much faster than matching the patterns one by one: each candidate
+        sub-sequence is only visited once, and all the matches are obtained in one call.
+        If the same patterns are matched repeatedly (e.g. sentence by sentence),
+        pass them as a prepared `Patterns` collection, or as a frozen `PatternSet`
+        (which may be shared by many matchers).
+
+        Matches are produced in lexicographic order of ascending begin, length and
+        pattern index (which is set in the matches).
+
+        :param patterns: Patterns
+        :param threshold: Matching score (Sørensen–Dice coefficient) threshold (positive)
+        :return: Matches
+        """
+        match_cnt = self._match_all(patterns, threshold)
+
+        records = libpysdcxx.sequence_matches_data(self._matches)
+        return [
+            SequenceMatcher.Match(
+                begin=record.begin,
+                end=record.end,
+                score=record.score,
+                bigrams=None,
+                pattern=record.pattern,
+            )
+            for record in records[:match_cnt]
+        ]
+
+    def match_all_records(
+        self,
+        patterns: Union[Patterns, PatternSet, Iterable[Union[str, Bigrams]]],
+        threshold: float,
+    ) -> ctypes.Array:
+        """
+        Match multiple patterns at once, get match records
+
+        Same as `match_all`, but the matches are returned as a ctypes array
+        of `SequenceMatchRecord` structures (see `match_records`).
+
+        :param patterns: Patterns
+        :param threshold: Matching score (Sørensen–Dice coefficient) threshold (positive)
+        :return: Match records
+        """
+        match_cnt = self._match_all(patterns, threshold)
+
+        result = (SequenceMatchRecord * match_cnt)()
+        if match_cnt:
+            ctypes.memmove(
+                result, libpysdcxx.sequence_matches_data(self._matches), ctypes.sizeof(result))
+
+        return result
+
+    def _match_all(
+        self,
+        patterns: Union[Patterns, PatternSet, Iterable[Union[str, Bigrams]]],
+        threshold: float,
+    ) -> int:
+        """
+        Match multiple patterns at once (matches are stored in the matches buffer)
+        :param patterns: Patterns
+        :param threshold: Matching score (Sørensen–Dice coefficient) threshold (positive)
+        :return: Number of matches
+        """
+        if isinstance(patterns, PatternSet):
+            match_cnt = libpysdcxx.wsequence_matcher_match_set(
+                self._impl, patterns._impl, threshold, self._matches)
+
+        else:
+            if not isinstance(patterns, Patterns):
+                patterns = Patterns(patterns)
 
-                libpysdcxx.wsequence_matcher_iter_inc(itr)
+            match_cnt = libpysdcxx.wsequence_matcher_match_all(
+                self._impl, patterns._impl, len(patterns), threshold, self._matches)
 
-        finally:
-            libpysdcxx.delete_wsequence_matcher_iter(end)
-            libpysdcxx.delete_wsequence_matcher_iter(itr)
+        return match_cnt
 
     def __del__(self):
+        libpysdcxx.delete_sequence_matches(self._matches)
         libpysdcxx.delete_wsequence_matcher(self._impl)
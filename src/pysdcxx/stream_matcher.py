@@ -0,0 +1,116 @@
+from __future__ import annotations
+from typing import Iterable, List, Union
+
+from .libpysdcxx import libpysdcxx
+from .bigrams import Bigrams
+from .sequence_matcher import SequenceMatcher, Patterns
+
+
+class StreamMatcher:
+    """
+    Sliding window matcher of (unbounded) token streams
+
+    Patterns are registered up front; as tokens are pushed, matches of sub-sequences
+    ending with each token are reported right away.
+    Only sub-sequences of up to `window` tokens are considered, so the memory
+    and the work per token are bounded (regardless of the stream length).
+    Match `begin` and `end` are stream positions (token indices since construction
+    or `reset`).
+    """
+
+    def __init__(
+        self,
+        patterns: Union[Patterns, Iterable[Union[str, Bigrams]]],
+        threshold: float,
+        window: int,
+    ):
+        """
+        :param patterns: Patterns (`str` tokens or `Bigrams` objects)
+        :param threshold: Matching score (Sørensen–Dice coefficient) threshold (positive)
+        :param window: Max. match length (number of tokens, positive)
+        """
+        if window < 1:
+            raise ValueError("Window must be positive")
+        if not threshold > 0.0:
+            raise ValueError("Threshold must be positive")
+
+        if not isinstance(patterns, Patterns):
+            patterns = Patterns(patterns)
+
+        self._impl = libpysdcxx.new_wstream_matcher(
+            patterns._impl, len(patterns), threshold, window)
+        self._matches = libpysdcxx.new_sequence_matches()
+
+    def __del__(self):
+        if not hasattr(self, "_impl"):
+            return  # construction failed
+
+        libpysdcxx.delete_sequence_matches(self._matches)
+        libpysdcxx.delete_wstream_matcher(self._impl)
+
+    @property
+    def window(self) -> int:
+        """
+        :return: Max. match length (number of tokens)
+        """
+        return libpysdcxx.wstream_matcher_window(self._impl)
+
+    @property
+    def position(self) -> int:
+        """
+        :return: Stream position (number of tokens pushed)
+        """
+        return libpysdcxx.wstream_matcher_position(self._impl)
+
+    def reset(self):
+        """
+        Start new stream
+        """
+        libpysdcxx.wstream_matcher_reset(self._impl)
+
+    def push(
+        self, token: SequenceMatcher.TokenOrBigrams, strip: bool = False,
+    ) -> List[SequenceMatcher.Match]:
+        """
+        Push another token to the stream
+        :param token: Token (string, UTF-8 bytes or `Bigrams` object)
+        :param strip: Whether matches may begin/ end by the token or not
+        :return: Matches ending with the token (in ascending order by begin and pattern)
+        """
+        strip_int = 1 if strip else 0
+
+        if isinstance(token, Bigrams):
+            match_cnt = libpysdcxx.wstream_matcher_push_back(
+                self._impl, token._impl, strip_int, self._matches)
+        elif isinstance(token, str):
+            match_cnt = libpysdcxx.wstream_matcher_emplace_back(
+                self._impl, token, strip_int, self._matches)
+        elif isinstance(token, bytes):
+            match_cnt = libpysdcxx.wstream_matcher_emplace_back_utf8(
+                self._impl, token, len(token), strip_int, self._matches)
+        else:
+            raise SequenceMatcher.Error(f"Unsupported token: {token}")
+
+        records = libpysdcxx.sequence_matches_data(self._matches)
+        return [
+            SequenceMatcher.Match(
+                begin=record.begin,
+                end=record.end,
+                score=record.score,
+                bigrams=None,
+                pattern=record.pattern,
+            )
+            for record in records[:match_cnt]
+        ]
+
+    def extend(self, tokens: Iterable[SequenceMatcher.Token]) -> List[SequenceMatcher.Match]:
+        """
+        Push tokens to the stream
+        :param tokens: Tokens (optionally paired with "strip" flag, see `SequenceMatcher`)
+        :return: Matches ending with the tokens (in ascending order by end)
+        """
+        matches = []
+        for token in tokens:
+            matches.extend(self.push(*token) if isinstance(token, tuple) else self.push(token))
+
+        return matches
@@ -0,0 +1,125 @@
+#ifndef random_fixture_hxx
+#define random_fixture_hxx
+
+/**
+ *  \file
+ *  \brief  Random test data and match record tuples (shared by unit tests)
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <libsdcxx/sequence_matcher.hxx>
+#include <libsdcxx/parallel_matcher.hxx>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <utility>
+
+
+/** Sentence (tokens with "strip" flags) */
+using sentence_t = std::vector<std::pair<std::string, bool>>;
+
+/** Match record tuple: pattern, begin, end, score */
+using match_tuple_t = std::tuple<size_t, size_t, size_t, double>;
+
+/** Corpus match record tuple: sequence, pattern, begin, end, score */
+using corpus_match_tuple_t = std::tuple<size_t, size_t, size_t, size_t, double>;
+
+
+/**
+ *  \brief  Random token
+ *
+ *  \param  alphabet  Token characters (bytes)
+ *  \param  max_size  Max. token size
+ *
+ *  \return Token of 1 to \c max_size characters
+ */
+inline std::string random_token(const char * alphabet = "abcd ", size_t max_size = 6) {
+    const size_t alphabet_size = std::strlen(alphabet);
+
+    std::string token(1 + std::rand() % max_size, ' ');
+    for (auto & ch: token) ch = alphabet[std::rand() % alphabet_size];
+
+    return token;
+}
+
+/**
+ *  \brief  Random sentence
+ *
+ *  \param  max_len     Max. number of tokens (exclusive)
+ *  \param  strip_odds  1 in \c strip_odds tokens is a "strip" token (in average)
+ *  \param  alphabet    Token characters (see \c random_token)
+ *  \param  max_size    Max. token size
+ *
+ *  \return Sentence of 0 to \c max_len - 1 tokens
+ */
+inline sentence_t random_sentence(
+    size_t max_len = 20, unsigned strip_odds = 4,
+    const char * alphabet = "abcd ", size_t max_size = 6)
+{
+    sentence_t sentence(std::rand() % max_len);
+    for (auto & token: sentence)
+        token = std::make_pair(random_token(alphabet, max_size), 0 == std::rand() % strip_odds);
+
+    return sentence;
+}
+
+/** Match records as tuples */
+inline std::vector<match_tuple_t> tuples(
+    const std::vector<libsdcxx::sequence_match> & matches)
+{
+    std::vector<match_tuple_t> result;
+    for (const auto & match: matches)
+        result.emplace_back(match.pattern, match.begin, match.end, match.score);
+
+    return result;
+}
+
+/** Corpus match records as tuples */
+inline std::vector<corpus_match_tuple_t> tuples(
+    const std::vector<libsdcxx::corpus_match> & cmatches)
+{
+    std::vector<corpus_match_tuple_t> result;
+    for (const auto & cmatch: cmatches)
+        result.emplace_back(cmatch.sequence, cmatch.match.pattern,
+            cmatch.match.begin, cmatch.match.end, cmatch.match.score);
+
+    return result;
+}
+
+#endif  // end of #ifndef random_fixture_hxx
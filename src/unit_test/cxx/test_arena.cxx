@@ -0,0 +1,134 @@
+/**
+ *  \file
+ *  \brief  Monotonic memory arena unit test
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <libsdcxx/arena.hxx>
+#include <libsdcxx/bigrams.hxx>
+#include <iostream>
+#include <cstdint>
+#include <vector>
+#include <memory_resource>
+
+#include "unit_test.hxx"
+
+
+/** Monotonic memory arena unit test */
+class test_arena: public unit_test {
+    private:
+
+    /** Test allocations */
+    void test_allocation() const {
+        libsdcxx::arena arena(256);
+
+        void * first = arena.allocate(10, 1);
+        for (size_t alignment: {1, 2, 4, 8, 16, 32, 64}) {
+            void * ptr = arena.allocate(3, alignment);
+            assert(reinterpret_cast<uintptr_t>(ptr) % alignment == 0,
+                "Allocation is aligned to " + std::to_string(alignment));
+        }
+
+        void * large = arena.allocate(10000, 8);  // larger than a chunk
+        assert(nullptr != large, "Large allocation succeeds");
+        assert(arena.allocated() == 10 + 7 * 3 + 10000, "Allocated bytes are counted");
+
+        arena.reset();
+        assert(arena.allocated() == 0, "Nothing allocated after reset");
+        assert(arena.allocate(10, 1) == first, "Memory is re-used after reset");
+    }
+
+    /** Test bigrams allocated in arena */
+    void test_bigrams() const {
+        libsdcxx::arena arena;
+        const std::pmr::polymorphic_allocator<std::byte> alloc(&arena);
+
+        for (size_t round = 0; round < 2; ++round) {
+            const auto list = libsdcxx::bigrams("abracadabra", alloc);
+            const auto flat = libsdcxx::flat_bigrams("abracadabra, simsalabim", alloc);
+            const auto flat_copy = libsdcxx::flat_bigrams(flat, alloc);
+            const auto flat_heap = flat;  // copy is on default heap
+
+            assert(list.get_allocator() == alloc, "List bigrams use the arena");
+            assert(flat_copy.get_allocator() == alloc, "Flat bigrams copy uses the arena");
+            assert(flat_heap.get_allocator() != alloc, "Plain copy uses default heap");
+            assert(arena.allocated() > 0, "Arena is used");
+
+            const auto unite = libsdcxx::flat_bigrams(flat, flat_copy, alloc);
+            assert(unite.size() == 2 * flat.size(), "Union is computed in arena");
+            assert(libsdcxx::flat_bigrams::intersect_size(unite, flat_heap) == flat.size(),
+                "Union contains the bigrams");
+        }
+    }
+
+    /** Test counting resource */
+    void test_counting() const {
+        libsdcxx::arena arena;
+        libsdcxx::counting_resource counting(&arena);
+        const std::pmr::polymorphic_allocator<std::byte> alloc(&counting);
+
+        void * ptr = counting.allocate(100, 8);
+        assert(counting.used() == 100, "Allocated bytes are counted");
+
+        {
+            const auto flat = libsdcxx::flat_bigrams("abracadabra, simsalabim", alloc);
+            assert(counting.used() > 100, "Bigrams storage is counted");
+        }
+
+        assert(counting.used() == 100, "Deallocated bytes are discounted");
+        counting.deallocate(ptr, 100, 8);
+        assert(counting.used() == 0, "Nothing in use");
+        assert(arena.allocated() > 100, "Upstream resource is used");
+    }
+
+    public:
+
+    test_arena(int argc, char * const argv[]): unit_test(argc, argv) {}
+
+    /** Run unit test */
+    void run() const {
+        test_allocation();
+        test_bigrams();
+        test_counting();
+    }
+
+};  // end of class test_arena
+
+
+int main(int argc, char * const argv[]) {
+    return test_arena(argc, argv).exec();
+}
@@ -0,0 +1,195 @@
+/**
+ *  \file
+ *  \brief  Inverted bigram index unit test
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <libsdcxx/bigram_index.hxx>
+#include <libsdcxx/bigrams.hxx>
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "unit_test.hxx"
+
+
+/** Inverted bigram index unit test */
+class test_bigram_index: public unit_test {
+    private:
+
+    using bigrams = libsdcxx::bigrams;
+    using flat_bigrams = libsdcxx::flat_bigrams;
+    using bigram_index = libsdcxx::bigram_index;
+    using wbigram_index = libsdcxx::wbigram_index;
+
+    /** Random string (small alphabet to get plenty of similar strings) */
+    static std::string random_string(size_t max_len) {
+        static const char alphabet[] = "abcde \xc3\xa9";
+
+        std::string str(std::rand() % (max_len + 1), ' ');
+        for (auto & ch: str)
+            ch = alphabet[std::rand() % (sizeof(alphabet) - 1)];
+
+        return str;
+    }
+
+    /** Compare index lookup with brute force on random dictionaries */
+    template <class Query>
+    void test_random(size_t rounds, size_t entry_cnt, size_t max_len) const {
+        for (size_t round = 0; round < rounds; ++round) {
+            std::vector<bigrams> entries;
+            bigram_index index;
+            index.reserve(entry_cnt);
+            for (size_t i = 0; i < entry_cnt; ++i) {
+                entries.emplace_back(random_string(max_len));
+                assert(index.insert(entries.back()) == i, "Entry IDs are sequential");
+            }
+            assert(index.size() == entry_cnt, "All entries are indexed");
+
+            const auto query_str = random_string(max_len);
+            const auto query = bigrams(query_str);
+            const double threshold = 0.05 + 0.95 * (std::rand() % 100) / 100.0;
+
+            std::vector<libsdcxx::bigram_index_match> expected;
+            for (size_t i = 0; i < entry_cnt; ++i) {
+                const auto sdc = bigrams::sorensen_dice_coef(entries[i], query);
+                if (sdc >= threshold) expected.push_back({i, sdc});
+            }
+
+            const auto matches = index.lookup(Query(query_str), threshold);
+            assert(matches.size() == expected.size(),
+                "Index finds the same number of matches as brute force");
+            for (size_t i = 0; i < matches.size(); ++i) {
+                assert(matches[i].entry == expected[i].entry,
+                    "Index finds the same entries as brute force");
+                assert(matches[i].score == expected[i].score,
+                    "Index scores are the same as brute force ones");
+            }
+        }
+    }
+
+    /** Throwing and re-entrant sinks mustn't corrupt the lookup scratch space */
+    void test_sinks() const {
+        bigram_index index;
+        index.insert(bigrams("abcd"));
+        index.insert(bigrams("abcde"));
+        index.insert(bigrams("bcd"));
+
+        const auto query = bigrams("abcd");
+        assert(index.lookup(query, 0.7).size() == 3, "abcd matches {abcd, abcde, bcd}");
+
+        // std::function sink: the same sink type for all the lookups
+        struct sink_error {};
+        bool throwing = true;
+        std::vector<size_t> found;
+        const std::function<void (const libsdcxx::bigram_index_match &)> sink =
+            [&](const libsdcxx::bigram_index_match & match) {
+                if (throwing) throw sink_error();
+                found.push_back(match.entry);
+            };
+        try {
+            index.lookup(query, 0.7, sink);
+            assert(false, "Sink exception is propagated");
+        }
+        catch (const sink_error & ) {}
+
+        throwing = false;
+        index.lookup(query, 0.7, sink);
+        assert(found.size() == 3, "Thrown sink loses no matches");
+
+        std::vector<size_t> outer, inner;
+        index.lookup(query, 0.7, [&](const libsdcxx::bigram_index_match & match) {
+            outer.push_back(match.entry);
+            inner.push_back(index.lookup(bigrams("bcd"), 0.7).size());
+        });
+        assert(outer == std::vector<size_t>({ 0, 1, 2 }), "Re-entrant sink gets all matches");
+        assert(inner == std::vector<size_t>({ 2, 2, 2 }), "Nested lookups are correct");
+    }
+
+    public:
+
+    test_bigram_index(int argc, char * const argv[]): unit_test(argc, argv) {}
+
+    /** Run unit test */
+    void run() const {
+        bigram_index index;
+        assert(index.size() == 0, "Empty index");
+        assert(index.lookup(bigrams("abcd"), 0.5).empty(), "Empty index matches nothing");
+
+        index.insert(bigrams("abcd"));
+        index.insert(bigrams("bcd"));
+        index.insert(bigrams("xyz"));
+        index.insert(bigrams(""));
+        index.insert(bigrams("abcdefghijkl"));
+        assert(index.size() == 5, "5 entries indexed");
+        assert(index.entry_size(4) == 11, "Entry size is the number of bigrams");
+
+        const auto matches = index.lookup(bigrams("abcd"), 0.7);
+        for (const auto & match: matches)
+            std::cout << "abcd ~ #" << match.entry << ": " << match.score << std::endl;
+
+        assert(matches.size() == 2, "abcd matches {abcd, bcd}");
+        assert(matches[0].entry == 0 && matches[0].score == 1.0, "abcd == abcd");
+        assert(matches[1].entry == 1 && matches[1].score == 0.8, "SDC(abcd, bcd) == 0.8");
+        assert(index.lookup(bigrams("a"), 0.1).empty(), "No bigrams match nothing");
+
+        index.clear();
+        assert(index.size() == 0, "Cleared index is empty");
+        assert(index.lookup(bigrams("abcd"), 0.5).empty(), "Cleared index matches nothing");
+
+        wbigram_index windex;
+        windex.insert(libsdcxx::wbigrams(L"Sørensen"));
+        windex.insert(libsdcxx::wbigrams(L"Dice"));
+        const auto wmatches = windex.lookup(libsdcxx::wbigrams(L"Sørenson"), 0.7);
+        assert(wmatches.size() == 1 && wmatches[0].entry == 0, "Sørenson ~ Sørensen");
+
+        test_sinks();
+
+        seed_rng();
+        test_random<bigrams>(200, 100, 12);
+        test_random<flat_bigrams>(200, 100, 12);
+        test_random<bigrams>(20, 1000, 40);
+    }
+
+};  // end of class test_bigram_index
+
+
+int main(int argc, char * const argv[]) {
+    return test_bigram_index(argc, argv).exec();
+}
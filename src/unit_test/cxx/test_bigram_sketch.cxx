@@ -0,0 +1,169 @@
+/**
+ *  \file
+ *  \brief  Bigram sketches unit test
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <libsdcxx/bigrams.hxx>
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <algorithm>
+
+#include "unit_test.hxx"
+
+
+/** Bigram sketches unit test */
+class test_bigram_sketch: public unit_test {
+    private:
+
+    using flat_bigrams = libsdcxx::flat_bigrams;
+    using sketched_bigrams = libsdcxx::sketched_bigrams;
+    using wsketched_bigrams = libsdcxx::wsketched_bigrams;
+
+    /** List storage bigrams with sketch (of few buckets) */
+    using sketched_list_bigrams = libsdcxx::basic_bigrams<char,
+        libsdcxx::sketched_bigram_storage<libsdcxx::list_bigram_storage<char>, 4>>;
+
+    /** Random string */
+    static std::string random_string(size_t max_len) {
+        static const char alphabet[] = "abcdefgh \xc3\xa9";
+
+        std::string str(std::rand() % (max_len + 1), ' ');
+        for (auto & ch: str)
+            ch = alphabet[std::rand() % (sizeof(alphabet) - 1)];
+
+        return str;
+    }
+
+    /** Sketches must be equal */
+    template <class Sketch>
+    static bool same(const Sketch & sketch1, const Sketch & sketch2) {
+        for (size_t b = 0; b < Sketch::buckets; ++b)
+            if (sketch1.count(b) != sketch2.count(b)) return false;
+
+        return true;
+    }
+
+    /** Sketch must match bigrams */
+    template <class Bigrams>
+    static bool consistent(const Bigrams & bgrms) {
+        using key_traits = typename Bigrams::storage_t::key_traits;
+        using sketch_t = typename Bigrams::storage_t::sketch_t;
+
+        auto sketch = sketch_t();
+        for (const auto & bigram_cnt: bgrms)
+            sketch.add(key_traits::pack(std::get<0>(bigram_cnt)), std::get<1>(bigram_cnt));
+
+        size_t size = 0;
+        for (size_t b = 0; b < sketch_t::buckets; ++b) size += sketch.count(b);
+
+        return size == bgrms.size() && same(sketch, bgrms.storage().sketch());
+    }
+
+    /** Sketches of random strings and their unions */
+    template <class Bigrams>
+    void test_random(size_t rounds, size_t max_len = 20) const {
+        size_t pruned = 0;
+        for (size_t round = 0; round < rounds; ++round) {
+            const auto str1 = random_string(max_len);
+            const auto str2 = random_string(max_len);
+
+            const auto bgrms1 = Bigrams(str1), bgrms2 = Bigrams(str2);
+            const auto flat1 = flat_bigrams(str1), flat2 = flat_bigrams(str2);
+
+            assert(consistent(bgrms1), "Sketch of bigrams");
+            assert(consistent(bgrms1 + bgrms2), "Sketch of bigrams union");
+
+            auto sum = bgrms1;
+            sum += bgrms2;
+            assert(consistent(sum), "Sketch of bigrams updated by union");
+            assert(consistent(Bigrams::unite(bgrms1, bgrms2, bgrms1)), "Sketch of unions");
+
+            const size_t isect_size = Bigrams::intersect_size(bgrms1, bgrms2);
+            const size_t bound = Bigrams::intersect_bound(bgrms1, bgrms2);
+            assert(isect_size == flat_bigrams::intersect_size(flat1, flat2),
+                "Intersection size is exact");
+            assert(isect_size <= bound, "Sketch bound is an upper bound");
+            assert(bound <= std::min(bgrms1.size(), bgrms2.size()),
+                "Sketch bound isn't worse than the cardinality bound");
+
+            pruned += bound < std::min(bgrms1.size(), bgrms2.size());
+        }
+
+        assert(0 < pruned, "Sketch bound is sometimes better than the cardinality bound");
+    }
+
+    public:
+
+    test_bigram_sketch(int argc, char * const argv[]): unit_test(argc, argv) {}
+
+    /** Run unit test */
+    void run() const {
+        static_assert(sketched_bigrams::sketched && !flat_bigrams::sketched,
+            "Sketched storage is detected");
+
+        const auto bgrms = sketched_bigrams();
+        std::cout << "sketched_bigrams() == " << bgrms << std::endl;
+        assert(0 == sketched_bigrams::intersect_bound(bgrms, bgrms), "Empty sketch");
+
+        const auto bgrms_abcd = sketched_bigrams("abcd");
+        const auto bgrms_bcd = sketched_bigrams("bcd");
+        std::cout << "sketched_bigrams(\"abcd\") == " << bgrms_abcd << std::endl;
+        assert(sketched_bigrams::intersect_bound(bgrms_abcd, bgrms_bcd) >= 2,
+            "|intersection({ab, bc, cd}, {bc, cd})| == 2");
+        assert(sketched_bigrams::intersect_bound(bgrms_abcd, bgrms_abcd) == 3,
+            "Sketch bound of self-intersection is exact");
+        assert(sketched_bigrams::sorensen_dice_coef(bgrms_abcd, bgrms_bcd) == 0.8,
+            "SDC({ab, bc, cd}, {bc, cd}) == 2 * 2 / (3 + 2) == 4/5");
+
+        const auto wbgrms = wsketched_bigrams(L"S\u00f8rensen");
+        std::wcout << L"wsketched_bigrams(\"S\u00f8rensen\") == " << wbgrms << std::endl;
+        assert(consistent(wbgrms), "Sketch of UNICODE bigrams");
+
+        seed_rng();
+        test_random<sketched_bigrams>(1000);
+        test_random<sketched_bigrams>(200, 200);  // beyond inline storage capacity
+        test_random<sketched_list_bigrams>(1000);
+    }
+
+};  // end of class test_bigram_sketch
+
+
+int main(int argc, char * const argv[]) {
+    return test_bigram_sketch(argc, argv).exec();
+}
@@ -0,0 +1,133 @@
+/**
+ *  \file
+ *  \brief  Bigram keys sorting unit test
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <libsdcxx/bigram_sort.hxx>
+#include <libsdcxx/bigrams.hxx>
+#include <iostream>
+#include <cstdlib>
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "unit_test.hxx"
+
+
+/** Bigram keys sorting unit test */
+class test_bigram_sort: public unit_test {
+    private:
+
+    /** Test keys sorting on random arrays */
+    template <typename Key>
+    void test_sort_keys(size_t rounds) const {
+        std::cout << "Testing sort of " << 8 * sizeof(Key) << "-bit keys" << std::endl;
+
+        for (size_t round = 0; round < rounds; ++round) {
+            const size_t len = std::rand() % 300;  // crosses all the thresholds
+            const size_t range = 1 + std::rand() % 70000;
+
+            std::vector<Key> keys(len), scratch(len);
+            for (auto & key: keys)
+                key = static_cast<Key>(std::rand() % range);
+
+            auto expected = keys;
+            std::sort(expected.begin(), expected.end());
+
+            libsdcxx::sort_keys(keys.data(), len, scratch.data());
+            assert(keys == expected,
+                "Keys (" + std::to_string(len) + ") are sorted");
+        }
+    }
+
+    /** Test bigrams construction against naive bigram counting */
+    template <typename Char, class Bigrams>
+    void test_construction(size_t rounds, int ch_min, int ch_range) const {
+        std::cout << "Testing construction of bigrams of "
+            << 8 * sizeof(Char) << "-bit characters" << std::endl;
+
+        for (size_t round = 0; round < rounds; ++round) {
+            std::basic_string<Char> str(std::rand() % 200, Char());
+            for (auto & ch: str)
+                ch = static_cast<Char>(ch_min + std::rand() % ch_range);
+
+            std::map<std::tuple<Char, Char>, size_t> expected;
+            for (size_t i = 1; i < str.size(); ++i)
+                ++expected[std::make_tuple(str[i-1], str[i])];
+
+            const Bigrams bgrms(str);
+            assert(bgrms.size() == (str.size() < 2 ? 0 : str.size() - 1),
+                "Bigrams size is string length - 1");
+
+            auto bigram = bgrms.begin();
+            for (const auto & bigram_cnt: expected) {
+                assert(bigram != bgrms.end(), "Bigram is present");
+                assert(std::get<0>(*bigram) == bigram_cnt.first, "Bigrams match");
+                assert(std::get<1>(*bigram) == bigram_cnt.second, "Counts match");
+                ++bigram;
+            }
+            assert(bigram == bgrms.end(), "No more bigrams");
+        }
+    }
+
+    public:
+
+    test_bigram_sort(int argc, char * const argv[]): unit_test(argc, argv) {}
+
+    /** Run unit test */
+    void run() const {
+        seed_rng();
+        test_sort_keys<uint16_t>(2000);
+        test_sort_keys<uint64_t>(500);
+
+        test_construction<char, libsdcxx::bigrams>(500, -128, 256);
+        test_construction<char, libsdcxx::bigrams>(500, 'a', 4);
+        test_construction<char, libsdcxx::flat_bigrams>(500, -128, 256);
+        test_construction<wchar_t, libsdcxx::wbigrams>(500, 0, 0x3000);
+        test_construction<wchar_t, libsdcxx::wflat_bigrams>(500, 'a', 4);
+    }
+
+};  // end of class test_bigram_sort
+
+
+int main(int argc, char * const argv[]) {
+    return test_bigram_sort(argc, argv).exec();
+}
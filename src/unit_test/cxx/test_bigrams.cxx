@@ -40,6 +40,7 @@
 
 #include <libsdcxx/bigrams.hxx>
 #include <iostream>
+#include <iterator>
 
 #include "unit_test.hxx"
 
@@ -75,6 +76,19 @@ class test_bigrams: public unit_test {
             << bgrms_abcd_bcd << std::endl;
         assert(bgrms_abcd_bcd.size() == 5, "|{ab, bc, cd} + {bc, cd}| == 3");
 
+        const bigrams bgrms_range[] = { bgrms_abcd, bgrms, bgrms_bcd, bigrams("cda") };
+        const auto bgrms_range_union = bigrams::unite(
+            std::begin(bgrms_range), std::end(bgrms_range));
+        std::cout
+            << "bigrams::unite({abcd, , bcd, cda}) == "
+            << bgrms_range_union << std::endl;
+        assert(bgrms_range_union.size() == 7,
+            "|{ab, bc, cd} + {} + {bc, cd} + {cd, da}| == 7");
+        assert(bigrams::intersect_size(bgrms_range_union, bgrms_range_union) == 7,
+            "Range union has multiplicities: {ab, 2 bc, 3 cd, da}");
+        assert(bigrams::unite(bgrms_range, bgrms_range).size() == 0,
+            "Empty range union is empty");
+
         const auto isect_size = bigrams::intersect_size(bgrms_abcd, bgrms_bcd);
         std::cout
             << "bigrams::intersect_size(bigrams(\"abcd\"), bigrams(\"bcd\")) == "
@@ -0,0 +1,279 @@
+/**
+ *  \file
+ *  \brief  Binary serialisation unit test
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <libsdcxx/binary.hxx>
+#include <libsdcxx/bigrams.hxx>
+#include <libsdcxx/pattern_set.hxx>
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <type_traits>
+#include <memory>
+#include <new>
+
+#include "unit_test.hxx"
+
+
+/** Binary serialisation unit test */
+class test_binary: public unit_test {
+    private:
+
+    using bigrams = libsdcxx::bigrams;
+    using pattern_set = libsdcxx::pattern_set;
+
+    /** Random string */
+    template <typename Char>
+    static std::basic_string<Char> random_string() {
+        std::basic_string<Char> str(std::rand() % 30, ' ');
+        for (auto & ch: str) ch = static_cast<Char>(std::rand() % 4 ? 'a' + std::rand() % 4 : 0xE0);
+
+        return str;
+    }
+
+    /** Bigrams equality */
+    template <class Bigrams>
+    static bool equal(const Bigrams & bgrms1, const Bigrams & bgrms2) {
+        if (bgrms1.size() != bgrms2.size()) return false;
+
+        auto bigram1 = bgrms1.begin();
+        auto bigram2 = bgrms2.begin();
+        for (; bigram1 != bgrms1.end() && bigram2 != bgrms2.end(); ++bigram1, ++bigram2)
+            if (*bigram1 != *bigram2) return false;
+
+        return bigram1 == bgrms1.end() && bigram2 == bgrms2.end();
+    }
+
+    /** Malformed input check */
+    template <class Fn>
+    static bool throws(Fn fn) {
+        try { fn(); }
+        catch (const libsdcxx::binary_format_error & ) { return true; }
+        return false;
+    }
+
+    /** Varint encoding UT */
+    void test_varint() const {
+        const uint64_t values[] = { 0, 1, 127, 128, 300, 16383, 16384, UINT32_MAX, UINT64_MAX };
+        for (const auto value: values) {
+            std::string buffer;
+            libsdcxx::binary::put_varint(buffer, value);
+
+            const auto * ptr = reinterpret_cast<const unsigned char *>(buffer.data());
+            const auto * const end = ptr + buffer.size();
+            assert(libsdcxx::binary::get_varint(ptr, end) == value && ptr == end,
+                "Varint decoding inverts encoding");
+            assert(throws([&]() {
+                const auto * ptr = reinterpret_cast<const unsigned char *>(buffer.data());
+                libsdcxx::binary::get_varint(ptr, end - 1);
+            }), "Truncated varint is detected");
+        }
+    }
+
+    /**
+     *  \brief  Bigrams round trip UT
+     *
+     *  \tparam  Bigrams  Bigrams type
+     *
+     *  \param  rounds  Number of rounds
+     */
+    template <class Bigrams>
+    void test_bigrams(size_t rounds) const {
+        using char_t = typename Bigrams::char_t;
+
+        for (size_t round = 0; round < rounds; ++round) {
+            const auto bgrms = Bigrams(random_string<char_t>()) + Bigrams(random_string<char_t>());
+            const auto binary = libsdcxx::serialise_binary(bgrms);
+            assert(binary.size() <= 6 + 20 + 20 * bgrms.size(), "Binary is compact");
+
+            const auto copy = libsdcxx::deserialise_binary<Bigrams>(binary.data(), binary.size());
+            assert(equal(copy, bgrms), "Deserialisation inverts serialisation");
+
+            if (binary.size() > 6)
+                assert(throws([&]() {
+                    libsdcxx::deserialise_binary<Bigrams>(
+                        binary.data(), binary.size() - 1 - std::rand() % (binary.size() - 6));
+                }), "Truncated binary is detected");
+        }
+    }
+
+    /** Malformed bigrams binaries UT */
+    void test_malformed() const {
+        const auto binary = libsdcxx::serialise_binary(bigrams("abcab"));
+        const auto deserialise = [](const std::string & binary) {
+            return libsdcxx::deserialise_binary<bigrams>(binary.data(), binary.size());
+        };
+
+        assert(equal(deserialise(binary), bigrams("abcab")), "Well-formed binary");
+        assert(throws([&]() { deserialise(""); }), "Empty binary");
+        assert(throws([&]() { deserialise("SDCX" + binary.substr(4)); }), "Bad magic");
+
+        auto tampered = binary;
+        tampered[4] = 99;
+        assert(throws([&]() { deserialise(tampered); }), "Unsupported version");
+
+        tampered = binary;
+        tampered[5] = 4;
+        assert(throws([&]() { deserialise(tampered); }), "Character size mismatch");
+
+        tampered = binary;
+        tampered[6] ^= 1;
+        assert(throws([&]() { deserialise(tampered); }), "Character signedness mismatch");
+
+        tampered = binary;
+        ++tampered[7];
+        assert(throws([&]() { deserialise(tampered); }), "Size mismatch");
+
+        // Hand-made binaries of [key delta, count] pairs
+        const auto make = [&](size_t size, const std::vector<uint64_t> & pairs) {
+            std::string binary = "SDCB\x02\x01";
+            binary += static_cast<char>(std::is_signed_v<char>);
+            libsdcxx::binary::put_varint(binary, size);
+            libsdcxx::binary::put_varint(binary, pairs.size() / 2);
+            for (const auto value: pairs) libsdcxx::binary::put_varint(binary, value);
+            return binary;
+        };
+
+        assert(deserialise(make(3, { 0x6162, 2, 1, 1 })).size() == 3, "Hand-made binary");
+        assert(throws([&]() { deserialise(make(3, { 0x6162, 2, 0, 1 })); }),
+            "Keys not ascending");
+        assert(throws([&]() { deserialise(make(2, { 0x6162, 2, 1, 0 })); }), "Zero count");
+        assert(throws([&]() { deserialise(make(3, { 0xFFFF, 2, 1, 1 })); }), "Key overflow");
+
+        assert(throws([&]() {
+            libsdcxx::deserialise_binary<libsdcxx::wbigrams>(binary.data(), binary.size());
+        }), "Character type mismatch");
+    }
+
+    /** Pattern set save, map and load UT */
+    void test_pattern_set() const {
+        std::vector<bigrams> patterns(50);
+        for (auto & pattern: patterns)
+            pattern = bigrams(random_string<char>()) + bigrams(random_string<char>());
+
+        const auto set = pattern_set(patterns, pattern_set::INDEX);
+        std::ostringstream out;
+        set.save(out);
+        const auto saved = out.str();
+        assert(saved.size() == pattern_set::alignment + set.blob_size(), "Saved set size");
+
+        // Memory-mapped set must be aligned
+        const auto deleter = [](std::byte * ptr) {
+            ::operator delete[](ptr, std::align_val_t(pattern_set::alignment));
+        };
+        std::unique_ptr<std::byte[], decltype(deleter)> memory(
+            new (std::align_val_t(pattern_set::alignment)) std::byte[saved.size()], deleter);
+        std::memcpy(memory.get(), saved.data(), saved.size());
+
+        const char * const path = "test_binary.sdcxxps";
+        set.save(path);
+
+        const auto mapped = pattern_set::map(memory.get(), saved.size(), pattern_set::INDEX);
+        const auto loaded = pattern_set::load(path, pattern_set::INDEX);
+        std::remove(path);
+
+        for (const auto * copy: { &mapped, &loaded }) {
+            assert(copy->size() == set.size() && copy->indexed(), "Saved set is restored");
+
+            for (size_t p = 0; p < set.size(); ++p) {
+                assert(copy->pattern_size(p) == set.pattern_size(p) &&
+                    copy->order()[p] == set.order()[p], "Saved set structure is restored");
+
+                const auto query = patterns[std::rand() % patterns.size()];
+                assert(pattern_set::view_t::sorensen_dice_coef(query, copy->pattern(p)) ==
+                    bigrams::sorensen_dice_coef(query, patterns[p]),
+                    "Saved set patterns are restored");
+            }
+
+            const auto query = bigrams(random_string<char>());
+            const auto expected = set.lookup(query, 0.5);
+            const auto lookup = copy->lookup(query, 0.5);
+            assert(lookup.size() == expected.size(), "Saved set index is re-built");
+            for (size_t i = 0; i < lookup.size(); ++i)
+                assert(lookup[i].entry == expected[i].entry, "Saved set index is re-built");
+        }
+
+        // Malformed saved sets
+        const auto map = [&](size_t size) { pattern_set::map(memory.get(), size); };
+        assert(throws([&]() { map(saved.size() - 1); }), "Truncated set");
+        assert(throws([&]() { map(pattern_set::alignment - 1); }), "Truncated set header");
+
+        memory[0] = std::byte('X');
+        assert(throws([&]() { map(saved.size()); }), "Bad magic");
+        memory[0] = std::byte(saved[0]);
+
+        memory[8] = std::byte(99);
+        assert(throws([&]() { map(saved.size()); }), "Unsupported version");
+        memory[8] = std::byte(saved[8]);
+
+        memory[28] ^= std::byte(1);  // char_signed
+        assert(throws([&]() { map(saved.size()); }), "Character signedness mismatch");
+        memory[28] = std::byte(saved[28]);
+
+        assert(pattern_set::map(memory.get(), saved.size()).size() == set.size(),
+            "Restored memory is well-formed");
+    }
+
+    public:
+
+    test_binary(int argc, char * const argv[]): unit_test(argc, argv) {}
+
+    /** Run unit test */
+    void run() const {
+        test_varint();
+
+        seed_rng();
+        test_bigrams<libsdcxx::bigrams>(300);
+        test_bigrams<libsdcxx::wbigrams>(300);
+        test_bigrams<libsdcxx::flat_bigrams>(300);
+        test_malformed();
+        test_pattern_set();
+    }
+
+};  // end of class test_binary
+
+
+int main(int argc, char * const argv[]) {
+    return test_binary(argc, argv).exec();
+}
@@ -0,0 +1,193 @@
+/**
+ *  \file
+ *  \brief  Flat storage bigrams unit test
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <libsdcxx/bigrams.hxx>
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <tuple>
+
+#include "unit_test.hxx"
+
+
+/** Flat storage bigrams unit test */
+class test_flat_bigrams: public unit_test {
+    private:
+
+    using bigrams = libsdcxx::bigrams;
+    using flat_bigrams = libsdcxx::flat_bigrams;
+    using wflat_bigrams = libsdcxx::wflat_bigrams;
+
+    /** Flat storage bigrams with tiny inline storage (spills most of the time) */
+    using spilling_flat_bigrams =
+        libsdcxx::basic_bigrams<char, libsdcxx::flat_bigram_storage<char, 2>>;
+
+    /** Random string (including 8-bit characters to test signed ordering) */
+    static std::string random_string(size_t max_len) {
+        static const char alphabet[] = "abcde \xc3\xa9\xc3\xb8";
+
+        std::string str(std::rand() % (max_len + 1), ' ');
+        for (auto & ch: str)
+            ch = alphabet[std::rand() % (sizeof(alphabet) - 1)];
+
+        return str;
+    }
+
+    /** Flat storage bigrams must be identical to list storage bigrams */
+    template <class Flat>
+    static bool same(const Flat & flat, const bigrams & list) {
+        if (flat.size() != list.size()) return false;
+
+        auto list_bigram = list.cbegin();
+        for (auto flat_bigram = flat.cbegin(); flat_bigram != flat.cend(); ++flat_bigram) {
+            if (list_bigram == list.cend()) return false;
+            if (*flat_bigram != *list_bigram) return false;
+            ++list_bigram;
+        }
+
+        return list_bigram == list.cend();
+    }
+
+    /** Compare flat and list storage bigrams on random strings */
+    template <class Flat = flat_bigrams>
+    void test_random(size_t rounds, size_t max_len = 20) const {
+        for (size_t round = 0; round < rounds; ++round) {
+            const auto str1 = random_string(max_len);
+            const auto str2 = random_string(max_len);
+
+            const auto flat1 = Flat(str1), flat2 = Flat(str2);
+            const auto list1 = bigrams(str1), list2 = bigrams(str2);
+
+            assert(same(flat1, list1), "Flat and list bigrams are the same");
+            assert(same(flat1 + flat2, list1 + list2),
+                "Flat and list bigrams unions are the same");
+            assert(Flat::intersect_size(flat1, flat2) ==
+                bigrams::intersect_size(list1, list2),
+                "Flat and list bigrams intersection sizes are the same");
+        }
+    }
+
+    /** Range union must be the same as (list storage) union fold */
+    template <class Flat = flat_bigrams>
+    void test_range_union(size_t rounds, size_t max_cnt = 20) const {
+        for (size_t round = 0; round < rounds; ++round) {
+            std::vector<Flat> flats;
+            std::vector<const Flat *> ptrs;
+            bigrams list;
+
+            const size_t cnt = std::rand() % (max_cnt + 1);
+            flats.reserve(cnt);
+            for (size_t i = 0; i < cnt; ++i) {
+                const auto str = random_string(20);
+                flats.emplace_back(str);
+                list += bigrams(str);
+            }
+            for (const auto & flat: flats) ptrs.push_back(&flat);
+
+            assert(same(Flat::unite(flats.begin(), flats.end()), list),
+                "Range union is the same as union fold");
+            assert(same(Flat::unite(ptrs.cbegin(), ptrs.cend()), list),
+                "Range (of pointers) union is the same as union fold");
+        }
+    }
+
+    public:
+
+    test_flat_bigrams(int argc, char * const argv[]): unit_test(argc, argv) {}
+
+    /** Run unit test */
+    void run() const {
+        const auto bgrms = flat_bigrams();
+        std::cout << "flat_bigrams() == " << bgrms << std::endl;
+        assert(bgrms.size() == 0, "Empty bigrams have size 0");
+
+        const auto bgrms_abcd = flat_bigrams("abcd");
+        std::cout << "flat_bigrams(\"abcd\") == " << bgrms_abcd << std::endl;
+        assert(bgrms_abcd.size() == 3, "abcd -> |{ab, bc, cd}| == 3");
+
+        const auto bgrms_bcd = flat_bigrams("bcd");
+        std::cout << "flat_bigrams(\"bcd\") == " << bgrms_bcd << std::endl;
+        assert(bgrms_bcd.size() == 2, "bcd -> |{bc, cd}| == 2");
+
+        const auto bgrms_abcd_bcd = flat_bigrams::unite(bgrms_abcd, bgrms_bcd);
+        std::cout
+            << "flat_bigrams::unite(flat_bigrams(\"abcd\"), flat_bigrams(\"bcd\")) == "
+            << bgrms_abcd_bcd << std::endl;
+        assert(bgrms_abcd_bcd.size() == 5, "|{ab, bc, cd} + {bc, cd}| == 3");
+
+        const auto isect_size = flat_bigrams::intersect_size(bgrms_abcd, bgrms_bcd);
+        std::cout
+            << "flat_bigrams::intersect_size(flat_bigrams(\"abcd\"), flat_bigrams(\"bcd\")) == "
+            << isect_size << std::endl;
+        assert(isect_size == 2, "|intersection({ab, bc, cd}, {bc, cd})| == 2");
+
+        const auto sdc = flat_bigrams::sorensen_dice_coef(bgrms_abcd, bgrms_bcd);
+        std::cout
+            << "flat_bigrams::sorensen_dice_coef(flat_bigrams(\"abcd\"), flat_bigrams(\"bcd\")) == "
+            << sdc << std::endl;
+        assert(sdc == 0.8, "SDC({ab, bc, cd}, {bc, cd}) == 2 * 2 / (3 + 2) == 4/5");
+
+        const auto wbgrms = wflat_bigrams(L"S\u00f8rensen");
+        std::wcout << L"wflat_bigrams(\"S\u00f8rensen\") == " << wbgrms << std::endl;
+        assert(wbgrms.size() == 7, "|{So, or, re, en, ns, se, en}| == 7");
+
+        seed_rng();
+        test_random(1000);
+        test_random(200, 200);  // beyond inline storage capacity
+        test_random<spilling_flat_bigrams>(1000);
+        test_range_union(200);
+        test_range_union<spilling_flat_bigrams>(200);
+        test_range_union<libsdcxx::sketched_bigrams>(200);
+
+        auto copy = flat_bigrams("abcd");  // assignments between inline and heap
+        const auto spilt = flat_bigrams(random_string(200) + "abcdefghijklmnopqrstuvwxyz");
+        copy = spilt;
+        assert(copy.size() == spilt.size(), "Spilt bigrams copy assigned");
+        copy = flat_bigrams("abcd");
+        assert(copy.size() == 3, "Inline bigrams move assigned over spilt ones");
+    }
+
+};  // end of class test_flat_bigrams
+
+
+int main(int argc, char * const argv[]) {
+    return test_flat_bigrams(argc, argv).exec();
+}
@@ -0,0 +1,165 @@
+/**
+ *  \file
+ *  \brief  Hashed bigram multiset unit test
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <libsdcxx/hashed_bigram_multiset.hxx>
+#include <libsdcxx/bigrams.hxx>
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <map>
+#include <tuple>
+
+#include "unit_test.hxx"
+
+
+/** Hashed bigram multiset unit test */
+class test_hashed_bigram_multiset: public unit_test {
+    private:
+
+    using hashed_bigram_multiset = libsdcxx::hashed_bigram_multiset;
+    using hashed_wbigram_multiset = libsdcxx::hashed_wbigram_multiset;
+    using bigrams = libsdcxx::bigrams;
+
+    /** Random string (including 8-bit characters) */
+    static std::string random_string(size_t max_len) {
+        static const char alphabet[] = "abcdefghij \xc3\xa9\xc3\xb8";
+
+        std::string str(std::rand() % (max_len + 1), ' ');
+        for (auto & ch: str)
+            ch = alphabet[std::rand() % (sizeof(alphabet) - 1)];
+
+        return str;
+    }
+
+    /** Bigram multisets must be equal (as [bigram, count] maps) */
+    static bool same(const hashed_bigram_multiset & hashed, const bigrams & sorted) {
+        std::map<std::tuple<char, char>, size_t> counts;
+        for (const auto & bigram: hashed) ++counts[bigram];
+
+        size_t length = 0;
+        for (const auto & bigram_cnt: sorted) {
+            const auto & bigram = std::get<0>(bigram_cnt);
+            if (counts[bigram] != std::get<1>(bigram_cnt)) return false;
+            if (hashed.count(bigram) != std::get<1>(bigram_cnt)) return false;
+            ++length;
+        }
+
+        return
+            hashed.size() == sorted.size() &&
+            hashed.length() == length &&
+            counts.size() == length;
+    }
+
+    /** Compare hashed and sorted bigrams on random strings */
+    void test_random(size_t rounds, size_t max_len) const {
+        for (size_t round = 0; round < rounds; ++round) {
+            const auto str1 = random_string(max_len);
+            const auto str2 = random_string(max_len);
+
+            const auto hashed1 = hashed_bigram_multiset(str1);
+            const auto hashed2 = hashed_bigram_multiset(str2);
+            const auto sorted1 = bigrams(str1), sorted2 = bigrams(str2);
+
+            assert(same(hashed1, sorted1), "Hashed and sorted bigrams are the same");
+            assert(same(hashed1 + hashed2, sorted1 + sorted2),
+                "Hashed and sorted bigrams unions are the same");
+
+            auto sum = hashed2;
+            for (size_t i = 0; i < 4; ++i) sum += hashed1;  // growing table
+            assert(same(sum, bigrams::unite(sorted2, sorted1, sorted1, sorted1, sorted1)),
+                "Hashed bigrams updated by unions");
+
+            assert(hashed_bigram_multiset::intersect_size(hashed1, hashed2) ==
+                bigrams::intersect_size(sorted1, sorted2),
+                "Hashed and sorted bigrams intersection sizes are the same");
+            assert(hashed_bigram_multiset::intersect_size(sum, hashed1) ==
+                bigrams::intersect_size(sorted1 + sorted1 + sorted1 + sorted2, sorted1),
+                "Hashed bigrams intersection size with multiple counts");
+        }
+    }
+
+    public:
+
+    test_hashed_bigram_multiset(int argc, char * const argv[]): unit_test(argc, argv) {}
+
+    /** Run unit test */
+    void run() const {
+        const auto bgrms = hashed_bigram_multiset();
+        std::cout << "hashed_bigram_multiset() == " << bgrms << std::endl;
+        assert(bgrms.size() == 0, "Empty bigrams have size 0");
+        assert(bgrms.begin() == bgrms.end(), "Empty bigrams iteration");
+
+        const auto bgrms_abcd = hashed_bigram_multiset("abcd");
+        std::cout << "hashed_bigram_multiset(\"abcd\") == " << bgrms_abcd << std::endl;
+        assert(bgrms_abcd.size() == 3, "abcd -> |{ab, bc, cd}| == 3");
+
+        const auto bgrms_bcd = hashed_bigram_multiset("bcd");
+        assert(bgrms_bcd.size() == 2, "bcd -> |{bc, cd}| == 2");
+
+        const auto bgrms_abcd_bcd = hashed_bigram_multiset::unite(bgrms_abcd, bgrms_bcd);
+        std::cout
+            << "hashed_bigram_multiset::unite(hashed_bigram_multiset(\"abcd\"), "
+                "hashed_bigram_multiset(\"bcd\")) == "
+            << bgrms_abcd_bcd << std::endl;
+        assert(bgrms_abcd_bcd.size() == 5, "|{ab, bc, cd} + {bc, cd}| == 5");
+        assert(bgrms_abcd_bcd.length() == 3, "{ab, bc, cd} + {bc, cd} has 3 distinct bigrams");
+
+        const auto isect_size = hashed_bigram_multiset::intersect_size(bgrms_abcd, bgrms_bcd);
+        assert(isect_size == 2, "|intersection({ab, bc, cd}, {bc, cd})| == 2");
+
+        const auto sdc = hashed_bigram_multiset::sorensen_dice_coef(bgrms_abcd, bgrms_bcd);
+        assert(sdc == 0.8, "SDC({ab, bc, cd}, {bc, cd}) == 2 * 2 / (3 + 2) == 4/5");
+
+        const auto wbgrms = hashed_wbigram_multiset(L"S\u00f8rensen");
+        std::wcout << L"hashed_wbigram_multiset(\"S\u00f8rensen\") == " << wbgrms << std::endl;
+        assert(wbgrms.size() == 7, "|{So, or, re, en, ns, se, en}| == 7");
+        assert(wbgrms.length() == 6, "en is there twice");
+
+        seed_rng();
+        test_random(1000, 20);
+        test_random(200, 400);  // several groups
+    }
+
+};  // end of class test_hashed_bigram_multiset
+
+
+int main(int argc, char * const argv[]) {
+    return test_hashed_bigram_multiset(argc, argv).exec();
+}
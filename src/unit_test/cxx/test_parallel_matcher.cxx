@@ -0,0 +1,170 @@
+/**
+ *  \file
+ *  \brief  Parallel sequence matcher unit test
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <libsdcxx/parallel_matcher.hxx>
+#include <libsdcxx/sequence_matcher.hxx>
+#include <libsdcxx/bigrams.hxx>
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <utility>
+#include <algorithm>
+
+#include "random_fixture.hxx"
+#include "unit_test.hxx"
+
+
+/** Parallel sequence matcher unit test */
+class test_parallel_matcher: public unit_test {
+    private:
+
+    using corpus_t = std::vector<sentence_t>;
+
+    /** Random corpus */
+    static corpus_t random_corpus(size_t seq_cnt) {
+        corpus_t corpus(seq_cnt);
+        for (auto & sentence: corpus) sentence = random_sentence();
+
+        return corpus;
+    }
+
+    /**
+     *  \brief  Compare parallel matching with sequential one
+     *
+     *  \tparam  Parallel  Parallel matcher type
+     *
+     *  \param  seq_cnt  Number of sequences
+     *  \param  threads  Number of threads
+     *  \param  grain    Chunk size
+     */
+    template <class Parallel>
+    void test_random(size_t seq_cnt, size_t threads, size_t grain) const {
+        using matcher_t = typename Parallel::matcher_t;
+        using bigrams = typename Parallel::bigrams_t;
+
+        const auto corpus = random_corpus(seq_cnt);
+
+        std::vector<bigrams> patterns(1 + std::rand() % 8);
+        for (auto & pattern: patterns)
+            pattern = bigrams(random_token()) + bigrams(random_token());
+
+        const double threshold = 0.3 + 0.1 * (std::rand() % 7);
+
+        std::vector<libsdcxx::corpus_match> expected;
+        auto matcher = matcher_t();
+        for (size_t seq = 0; seq < corpus.size(); ++seq) {
+            matcher.assign(corpus[seq].begin(), corpus[seq].end());
+            for (const auto & match: matcher.match_all(patterns, threshold))
+                expected.push_back(libsdcxx::corpus_match{seq, match});
+        }
+
+        auto parallel = Parallel(threads);
+        assert(parallel.threads() == threads, "Thread count is as required");
+
+        for (size_t round = 0; round < 3; ++round) {  // workers' matchers are re-used
+            if (2 == round) parallel.cache_budget(std::rand() % 50);  // bounded cache
+
+            const auto matches = parallel.match_all(corpus, patterns, threshold, grain);
+            assert(tuples(matches) == tuples(expected),
+                "Parallel matches are the same as sequential ones");
+        }
+    }
+
+    /**
+     *  \brief  Compare parallel union with sequential one
+     *
+     *  \tparam  Bigrams  Bigrams type
+     *
+     *  \param  cnt        Number of multisets
+     *  \param  threads    Number of threads
+     *  \param  min_block  Minimal number of multisets per thread
+     */
+    template <class Bigrams>
+    void test_parallel_unite(size_t cnt, size_t threads, size_t min_block) const {
+        std::vector<Bigrams> bgrms(cnt);
+        for (auto & bgrm: bgrms) bgrm = Bigrams(random_token() + random_token());
+
+        const auto expected = Bigrams::unite(bgrms.cbegin(), bgrms.cend());
+        const auto parallel = libsdcxx::parallel_unite<Bigrams>(
+            bgrms.cbegin(), bgrms.cend(), threads, min_block);
+
+        assert(parallel.size() == expected.size(), "Parallel union has the same size");
+        assert(std::equal(
+            parallel.cbegin(), parallel.cend(), expected.cbegin(), expected.cend()),
+            "Parallel union is the same as sequential one");
+    }
+
+    public:
+
+    test_parallel_matcher(int argc, char * const argv[]): unit_test(argc, argv) {}
+
+    /** Run unit test */
+    void run() const {
+        const auto parallel = libsdcxx::parallel_matcher();
+        std::cout << "Default thread count: " << parallel.threads() << std::endl;
+        assert(parallel.threads() > 0, "There's at least 1 thread");
+
+        auto empty = libsdcxx::parallel_matcher(4);
+        assert(empty.match_all(corpus_t(), std::vector<libsdcxx::bigrams>(), 0.5).empty(),
+            "Empty corpus has no matches");
+
+        seed_rng();
+        for (size_t round = 0; round < 20; ++round) {
+            test_random<libsdcxx::parallel_matcher>(200, 1, 0);
+            test_random<libsdcxx::parallel_matcher>(200, 4, 0);
+            test_random<libsdcxx::parallel_matcher>(200, 8, 1);
+            test_random<libsdcxx::flat_parallel_matcher>(300, 3, 7);
+            test_random<libsdcxx::flat_parallel_matcher>(5, 16, 0);  // idle workers
+
+            test_parallel_unite<libsdcxx::bigrams>(500, 4, 16);
+            test_parallel_unite<libsdcxx::flat_bigrams>(1000, 3, 1);
+            test_parallel_unite<libsdcxx::flat_bigrams>(10, 8, 64);  // serial
+            test_parallel_unite<libsdcxx::sketched_bigrams>(0, 2, 1);
+        }
+    }
+
+};  // end of class test_parallel_matcher
+
+
+int main(int argc, char * const argv[]) {
+    return test_parallel_matcher(argc, argv).exec();
+}
@@ -0,0 +1,210 @@
+/**
+ *  \file
+ *  \brief  Frozen pattern set unit test
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <libsdcxx/pattern_set.hxx>
+#include <libsdcxx/sequence_matcher.hxx>
+#include <libsdcxx/parallel_matcher.hxx>
+#include <libsdcxx/bigrams.hxx>
+#include <iostream>
+#include <cstdlib>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <utility>
+#include <thread>
+
+#include "random_fixture.hxx"
+#include "unit_test.hxx"
+
+
+/** Frozen pattern set unit test */
+class test_pattern_set: public unit_test {
+    private:
+
+    using bigrams = libsdcxx::bigrams;
+    using flat_bigrams = libsdcxx::flat_bigrams;
+    using pattern_set = libsdcxx::pattern_set;
+
+    /** Token characters (bytes, including those of UTF-8 encoded 'é') */
+    static constexpr const char * alphabet = "abcd \xc3\xa9";
+
+    /** Frozen set vs patterns comparison */
+    template <class Matcher>
+    void test_random(size_t rounds) const {
+        using bigrams_t = typename Matcher::bigrams_t;
+
+        for (size_t round = 0; round < rounds; ++round) {
+            std::vector<bigrams_t> patterns(std::rand() % 10);
+            for (auto & pattern: patterns)
+                pattern = bigrams_t(random_token(alphabet)) + bigrams_t(random_token(alphabet));
+
+            const auto set = pattern_set(patterns, pattern_set::INDEX);
+            assert(set.size() == patterns.size(), "All patterns are frozen");
+            assert(set.blob_size() % pattern_set::alignment == 0, "Blob is aligned");
+            assert(reinterpret_cast<std::uintptr_t>(set.order()) % pattern_set::alignment == 0,
+                "Sections are aligned");
+
+            const auto query = bigrams_t(random_token(alphabet) + random_token(alphabet));
+            for (size_t p = 0; p < patterns.size(); ++p) {
+                const auto view = set.pattern(p);
+                assert(view.size() == patterns[p].size(), "Pattern size is kept");
+
+                auto bigram = patterns[p].begin();
+                for (const auto & bigram_cnt: view) {
+                    assert(bigram != patterns[p].end() && *bigram == bigram_cnt,
+                        "Pattern bigrams are kept");
+                    ++bigram;
+                }
+                assert(bigram == patterns[p].end(), "Pattern bigrams are kept");
+
+                assert(pattern_set::view_t::sorensen_dice_coef(query, view) ==
+                    bigrams_t::sorensen_dice_coef(query, patterns[p]),
+                    "View SDC is the same");
+            }
+
+            for (size_t p = 1; p < set.size(); ++p)
+                assert(set.sorted_sizes()[p - 1] <= set.sorted_sizes()[p],
+                    "Size order is ascending");
+
+            const double threshold = 0.3 + 0.1 * (std::rand() % 7);
+
+            // Index lookup vs brute force
+            std::vector<size_t> expected_lookup, lookup;
+            for (size_t p = 0; p < patterns.size(); ++p)
+                if (bigrams_t::sorensen_dice_coef(query, patterns[p]) >= threshold)
+                    expected_lookup.push_back(p);
+            for (const auto & match: set.lookup(query, threshold))
+                lookup.push_back(match.entry);
+            assert(lookup == expected_lookup, "Set lookup is the same as brute force");
+
+            // Matching vs patterns matching
+            const auto sentence = random_sentence(20, 4, alphabet);
+            auto matcher = Matcher();
+            matcher.assign(sentence.begin(), sentence.end());
+
+            assert(tuples(matcher.match_all(set, threshold)) ==
+                tuples(matcher.match_all(patterns, threshold)),
+                "Set matches are the same as the patterns ones");
+        }
+    }
+
+    /** Concurrent matching of a shared set */
+    void test_concurrent() const {
+        std::vector<bigrams> patterns(50);
+        for (auto & pattern: patterns)
+            pattern = bigrams(random_token(alphabet)) + bigrams(random_token(alphabet));
+
+        const auto set = pattern_set(patterns);
+
+        std::vector<sentence_t> corpus(200);
+        for (auto & sentence: corpus) sentence = random_sentence(20, 4, alphabet);
+
+        std::vector<std::vector<match_tuple_t>> expected(corpus.size());
+        auto matcher = libsdcxx::sequence_matcher();
+        for (size_t seq = 0; seq < corpus.size(); ++seq) {
+            matcher.assign(corpus[seq].begin(), corpus[seq].end());
+            expected[seq] = tuples(matcher.match_all(patterns, 0.5));
+        }
+
+        std::vector<int> ok(4, 0);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < ok.size(); ++t)
+            threads.emplace_back([&, t]() {
+                auto matcher = libsdcxx::sequence_matcher();
+                ok[t] = 1;
+                for (size_t seq = 0; seq < corpus.size(); ++seq) {
+                    matcher.assign(corpus[seq].begin(), corpus[seq].end());
+                    if (tuples(matcher.match_all(set, 0.5)) != expected[seq]) ok[t] = 0;
+                }
+            });
+        for (auto & thread: threads) thread.join();
+
+        for (const auto thread_ok: ok)
+            assert(thread_ok, "Concurrent matching of shared set is correct");
+
+        auto parallel = libsdcxx::parallel_matcher(4);
+        const auto cmatches = parallel.match_all(corpus, set, 0.5);
+        size_t cmatch = 0;
+        for (size_t seq = 0; seq < corpus.size(); ++seq)
+            for (const auto & match: expected[seq]) {
+                assert(cmatch < cmatches.size() && cmatches[cmatch].sequence == seq &&
+                    std::get<0>(match) == cmatches[cmatch].match.pattern &&
+                    std::get<1>(match) == cmatches[cmatch].match.begin &&
+                    std::get<2>(match) == cmatches[cmatch].match.end,
+                    "Parallel matching of shared set is correct");
+                ++cmatch;
+            }
+        assert(cmatch == cmatches.size(), "Parallel matching of shared set is complete");
+    }
+
+    public:
+
+    test_pattern_set(int argc, char * const argv[]): unit_test(argc, argv) {}
+
+    /** Run unit test */
+    void run() const {
+        const auto empty = pattern_set();
+        assert(empty.size() == 0, "Empty set");
+        assert(!empty.indexed(), "Set isn't indexed by default");
+
+        const std::vector<bigrams> patterns = { bigrams("abcd"), bigrams("bcd") };
+        auto set = pattern_set(patterns, pattern_set::INDEX);
+        assert(set.indexed(), "Set is indexed on demand");
+        assert(set.pattern_size(0) == 3 && set.pattern_size(1) == 2, "Pattern sizes");
+        assert(set.order()[0] == 1 && set.order()[1] == 0, "Patterns size order");
+
+        const auto moved = std::move(set);
+        const auto view = moved.pattern(1);
+        assert(view.size() == 2 && view.length() == 2, "Moved set keeps the blob");
+        assert(moved.lookup(bigrams("abcd"), 0.8).size() == 2, "Moved set keeps the index");
+
+        seed_rng();
+        test_random<libsdcxx::sequence_matcher>(300);
+        test_random<libsdcxx::flat_sequence_matcher>(300);
+        test_concurrent();
+    }
+
+};  // end of class test_pattern_set
+
+
+int main(int argc, char * const argv[]) {
+    return test_pattern_set(argc, argv).exec();
+}
@@ -40,7 +40,17 @@
 
 #include <libsdcxx/sequence_matcher.hxx>
 #include <iostream>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+#include <string>
+#include <tuple>
+#include <algorithm>
+#include <limits>
+#include <ratio>
+#include <type_traits>
 
+#include "random_fixture.hxx"
 #include "unit_test.hxx"
 
 
@@ -54,6 +64,9 @@ class test_sequence_matcher: public unit_test {
     using wsequence_matcher = libsdcxx::wsequence_matcher;
     using wbigrams = wsequence_matcher::bigrams_t;
 
+    using flat_sequence_matcher = libsdcxx::flat_sequence_matcher;
+    using sketched_sequence_matcher = libsdcxx::sketched_sequence_matcher;
+
     /** Matcher space reservation mode */
     enum reserve_t {
         NONE = 0,   /**< No reservation (implies reallocations of bigrams matrix)   */
@@ -68,29 +81,21 @@ class test_sequence_matcher: public unit_test {
     }
 
     /**
-     *  \brief  Matching UT
+     *  \brief  Fill matcher with text and check matching
      *
-     *  \param  reserve  Space reservationA mode
+     *  \tparam  Matcher  Sequence matcher type
+     *
+     *  \param  matcher  Empty sequence matcher
      */
-    void test_matching(reserve_t reserve) const {
+    template <class Matcher>
+    void check_matching(Matcher & matcher) const {
+        using bigrams = typename Matcher::bigrams_t;
+
         const auto bgrms_hello = bigrams("Hello");
         const auto bgrms_space = bigrams("  ");     // 2 spaces to produce a bigram
         const auto bgrms_world = bigrams("world");
         const auto bgrms_xm = bigrams(" !");        // ditto
 
-        auto matcher = sequence_matcher();
-
-        // Reserve (or not) bigrams matrix for text of 9 tokens
-        switch (reserve) {
-            case NONE: break;
-            case PARTIAL:
-                matcher.reserve(5);
-                break;
-            case FULL:
-                matcher.reserve(9);
-                break;
-        }
-
         matcher.emplace_back("Prologue");
         matcher.emplace_back(" .", true);       // strip token
         matcher.emplace_back("  ", true);       // strip token
@@ -119,6 +124,532 @@ class test_sequence_matcher: public unit_test {
         assert(match == matcher.end(), "No more matches");
     }
 
+    /**
+     *  \brief  Matching UT
+     *
+     *  \tparam  Matcher  Sequence matcher type
+     *
+     *  \param  reserve  Space reservationA mode
+     */
+    template <class Matcher = sequence_matcher>
+    void test_matching(reserve_t reserve) const {
+        auto matcher = Matcher();
+
+        // Reserve (or not) bigrams matrix for text of 9 tokens
+        switch (reserve) {
+            case NONE: break;
+            case PARTIAL:
+                matcher.reserve(5);
+                break;
+            case FULL:
+                matcher.reserve(9);
+                break;
+        }
+
+        check_matching(matcher);
+
+        // Matcher re-use (the arena memory is kept)
+        matcher.clear();
+        assert(matcher.size() == 0, "Cleared matcher is empty");
+        assert(matcher.begin(typename Matcher::bigrams_t("Hello"), 0.0) == matcher.end(),
+            "No matches possible on cleared matcher");
+
+        check_matching(matcher);
+
+        auto moved = std::move(matcher);  // the arena stays put
+        assert(moved.size() == 9, "Matcher moved");
+        assert(moved.begin(typename Matcher::bigrams_t("world"), 0.9) != moved.end(),
+            "Moved matcher matches");
+    }
+
+    /**
+     *  \brief  Sequence assignment UT
+     *
+     *  \tparam  Matcher  Sequence matcher type
+     */
+    template <class Matcher = sequence_matcher>
+    void test_assign() const {
+        using bigrams = typename Matcher::bigrams_t;
+
+        const std::vector<std::pair<std::string, bool>> sentence1 = {
+            { "Hello", false }, { "  ", true }, { "world", false }, { " !", true },
+        };
+        const std::vector<std::string> sentence2 = { "Goodbye", "cruel", "world" };
+
+        const auto bgrms_hello_world = bigrams::unite(
+            bigrams("Hello"), bigrams("  "), bigrams("world"));
+        const auto bgrms_world = bigrams("world");
+
+        auto matcher = Matcher();
+        for (size_t round = 0; round < 3; ++round) {
+            matcher.assign(sentence1.begin(), sentence1.end());
+            assert(matcher.size() == 4, "1st sentence assigned");
+
+            const auto match1 = matcher.begin(bgrms_hello_world, 0.9);
+            assert(match1 != matcher.end(), "1st sentence matched");
+            assert(match1.begin() == 0 && match1.end() == 3, "Strip tokens are respected");
+            assert(&matcher.subsequence(match1.begin(), match1.end()) == &*match1,
+                "Sub-sequence bigrams are not copied");
+            assert(bigrams::sorensen_dice_coef(
+                matcher.subsequence(0, 3), bgrms_hello_world) == 1.0, "Sub-sequence bigrams");
+
+            matcher.assign(sentence2.begin(), sentence2.end());
+            assert(matcher.size() == 3, "2nd sentence assigned");
+
+            const auto match2 = matcher.begin(bgrms_world, 0.9);
+            assert(match2 != matcher.end(), "2nd sentence matched");
+            assert(match2.begin() == 2 && match2.end() == 3, "Match of 2nd sentence");
+        }
+    }
+
+    /**
+     *  \brief  Random matching UT (matches are compared with brute-force search)
+     *
+     *  \tparam  Matcher  Sequence matcher type
+     *
+     *  \param  rounds  Number of rounds
+     */
+    template <class Matcher = sequence_matcher>
+    void test_random(size_t rounds) const {
+        using bigrams = typename Matcher::bigrams_t;
+
+        auto matcher = Matcher();
+        for (size_t round = 0; round < rounds; ++round) {
+            auto tokens = random_sentence();
+
+            matcher.assign(tokens.begin(), tokens.end());
+
+            const auto pattern = bigrams(random_token() + random_token());
+            const double threshold = 0.3 + 0.1 * (std::rand() % 7);
+
+            // Brute-force matches (in the matcher order)
+            std::vector<std::pair<size_t, size_t>> expected;
+            for (size_t begin = 0; begin < tokens.size(); ++begin) {
+                auto bgrms = bigrams();
+                for (size_t end = begin + 1; end <= tokens.size(); ++end) {
+                    bgrms += bigrams(tokens[end - 1].first);
+
+                    if (tokens[begin].second || tokens[end - 1].second) continue;
+                    if (bigrams::sorensen_dice_coef(bgrms, pattern) < threshold) continue;
+
+                    expected.emplace_back(begin, end);
+                }
+            }
+
+            // Incremental scoring (before any sub-sequence bigrams are computed)
+            std::vector<std::tuple<size_t, size_t, double>> incremental;
+            for (const auto & match: matcher.match(pattern, threshold))
+                incremental.emplace_back(match.begin, match.end, match.score);
+
+            std::vector<std::pair<size_t, size_t>> matches;
+            std::vector<std::tuple<size_t, size_t, double>> scored;
+            for (auto match = matcher.begin(pattern, threshold); match != matcher.end(); ++match) {
+                matches.emplace_back(match.begin(), match.end());
+                scored.emplace_back(match.begin(), match.end(), match.sorensen_dice_coef());
+            }
+
+            assert(matches == expected, "Matches are the same as brute-force ones");
+            assert(incremental == scored, "Incremental scoring matches are the same");
+
+            // Multiple patterns matching
+            std::vector<bigrams> patterns(std::rand() % 8, pattern);
+            for (size_t p = 1; p < patterns.size(); ++p)
+                patterns[p] = bigrams(random_token()) + bigrams(random_token());
+
+            std::vector<std::tuple<size_t, size_t, size_t>> expected_all;
+            for (size_t p = 0; p < patterns.size(); ++p) {
+                auto match = matcher.begin(patterns[p], threshold);
+                for (; match != matcher.end(); ++match)
+                    expected_all.emplace_back(match.begin(), match.end(), p);
+            }
+            std::sort(expected_all.begin(), expected_all.end());
+
+            std::vector<std::tuple<size_t, size_t, size_t>> matches_all;
+            for (const auto & match: matcher.match_all(patterns, threshold)) {
+                assert(match.score >= threshold, "Match score is above threshold");
+                matches_all.emplace_back(match.begin, match.end, match.pattern);
+            }
+
+            assert(matches_all == expected_all,
+                "Multiple patterns matches are the same as one-by-one ones");
+
+            std::vector<const bigrams *> pttrns;
+            for (const auto & pttrn: patterns) pttrns.push_back(&pttrn);
+            std::vector<size_t> order, sizes;
+            Matcher::sort_by_size(pttrns.data(), pttrns.size(), order, sizes);
+
+            std::vector<std::tuple<size_t, size_t, size_t>> matches_sorted;
+            matcher.match_all(pttrns.data(), order.data(), sizes.data(), pttrns.size(),
+                threshold, [&matches_sorted](const libsdcxx::sequence_match & match) {
+                    matches_sorted.emplace_back(match.begin, match.end, match.pattern);
+                });
+
+            assert(matches_sorted == expected_all, "Pre-sorted patterns matches are the same");
+
+            // Best matches (brute force: sort by score desc., then begin and size)
+            std::vector<std::tuple<double, size_t, size_t>> ranked;
+            for (auto match = matcher.begin(pattern, threshold); match != matcher.end(); ++match)
+                ranked.emplace_back(-match.sorensen_dice_coef(), match.begin(), match.end());
+            std::sort(ranked.begin(), ranked.end());
+
+            const size_t k = 1 + std::rand() % 4;
+            std::vector<std::tuple<double, size_t, size_t>> expected_best(
+                ranked.begin(), ranked.begin() + std::min(k, ranked.size()));
+
+            std::vector<std::tuple<double, size_t, size_t>> expected_disjoint;
+            for (const auto & match: ranked) {
+                if (expected_disjoint.size() == k) break;
+
+                bool overlaps = false;
+                for (const auto & sel: expected_disjoint)
+                    overlaps = overlaps ||
+                        (std::get<1>(match) < std::get<2>(sel) &&
+                        std::get<1>(sel) < std::get<2>(match));
+
+                if (!overlaps) expected_disjoint.push_back(match);
+            }
+
+            auto best = [&](typename Matcher::overlap_t overlap) {
+                std::vector<std::tuple<double, size_t, size_t>> matches;
+                for (const auto & match: matcher.best_matches(pattern, k, threshold, overlap))
+                    matches.emplace_back(-match.score, match.begin, match.end);
+                return matches;
+            };
+
+            assert(best(Matcher::ALLOW_OVERLAP) == expected_best,
+                "Best matches are the same as brute-force ones");
+            assert(best(Matcher::NO_OVERLAP) == expected_disjoint,
+                "Best non-overlapping matches are the same as brute-force ones");
+        }
+    }
+
+    /**
+     *  \brief  Bounded cell cache UT (matches are the same as with unlimited cache)
+     *
+     *  \tparam  Matcher  Sequence matcher type
+     *
+     *  \param  rounds  Number of rounds
+     */
+    template <class Matcher = sequence_matcher>
+    void test_cache(size_t rounds) const {
+        using bigrams = typename Matcher::bigrams_t;
+        using match_t = std::tuple<size_t, size_t, size_t, double>;
+
+        const char * const alphabet = "abcdef ";  // token characters
+
+        auto matches = [](Matcher & matcher, const std::vector<bigrams> & patterns) {
+            std::vector<match_t> result;
+            for (size_t p = 0; p < patterns.size(); ++p) {
+                auto match = matcher.begin(patterns[p], 0.3);
+                for (; match != matcher.end(); ++match)
+                    result.emplace_back(p, match.begin(), match.end(), match.sorensen_dice_coef());
+            }
+
+            for (const auto & match: matcher.match_all(patterns, 0.3))
+                result.emplace_back(match.pattern, match.begin, match.end, match.score);
+
+            return result;
+        };
+
+        auto unlimited = Matcher();
+        auto bounded = Matcher();
+        assert(bounded.cache_budget() == Matcher::unlimited_cache, "Cache is unlimited by default");
+
+        for (size_t round = 0; round < rounds; ++round) {
+            auto tokens = random_sentence(40, 5, alphabet);
+
+            std::vector<bigrams> patterns(1 + std::rand() % 4);
+            for (auto & pattern: patterns)
+                pattern = bigrams(random_token(alphabet)) +
+                    bigrams(random_token(alphabet) + random_token(alphabet));
+
+            const size_t budget = std::rand() % 3 ? std::rand() % 4000 : 0;
+            bounded.cache_budget(budget);
+            assert(bounded.cache_budget() == budget, "Cache budget is set");
+
+            unlimited.assign(tokens.begin(), tokens.end());
+            bounded.assign(tokens.begin(), tokens.end());
+            assert(bounded.cache_size() == 0, "Cache is empty");
+
+            assert(matches(bounded, patterns) == matches(unlimited, patterns),
+                "Bounded cache matches are the same");
+
+            // Only the last computed cell may exceed the budget
+            assert(bounded.cache_size() <= budget || 1 == bounded.cache_cells(),
+                "Cache is bounded");
+
+            bounded.cache_budget(0);
+            assert(bounded.cache_size() == 0 && bounded.cache_cells() == 0,
+                "Cache is shrunk on demand");
+        }
+
+        // Statistics
+        bounded.reset_cache_stats();
+        bounded.cache_budget(0);
+        const std::vector<std::pair<std::string, bool>> tokens(10, std::make_pair("ab", false));
+        bounded.assign(tokens.begin(), tokens.end());
+
+        const auto pattern = bigrams("ababab");
+        bounded.match(pattern, 0.5);
+        assert(0 == bounded.cache_stats().misses, "Incremental scoring computes no unions");
+
+        const auto & bgrms = bounded.subsequence(2, 7);
+        assert(bgrms.size() == 5, "Sub-sequence bigrams");
+        assert(bounded.cache_stats().misses > 0 && bounded.cache_stats().hits == 0,
+            "Sub-sequence bigrams computed");
+        assert(bounded.cache_stats().evictions > 0, "Sub-cells evicted (zero budget)");
+        assert(1 == bounded.cache_cells() && bounded.cache_size() >= sizeof(bigrams),
+            "Only the computed cell is kept");
+
+        bounded.cache_budget(Matcher::unlimited_cache);
+        bounded.reset_cache_stats();
+        bounded.subsequence(2, 7);
+        bounded.subsequence(2, 7);
+        assert(bounded.cache_stats().misses == 0 && bounded.cache_stats().hits == 2,
+            "Cached cell hits");
+
+        const size_t generation = bounded.generation();
+        bounded.subsequence(2, 7);
+        assert(bounded.generation() == generation, "Cached cell hit keeps generation");
+        bounded.cache_budget(0);
+        assert(bounded.generation() != generation, "Eviction changes generation");
+        const size_t evicted = bounded.generation();
+        bounded.assign(tokens.begin(), tokens.end());
+        assert(bounded.generation() != evicted, "Assignment changes generation");
+    }
+
+    /**
+     *  \brief  Compile-time threshold UT (matches are the same as exact brute-force ones)
+     *
+     *  \tparam  Matcher    Sequence matcher type
+     *  \tparam  Threshold  Threshold (\c std::ratio)
+     *
+     *  \param  rounds  Number of rounds
+     */
+    template <class Matcher, class Threshold>
+    void test_static_threshold(size_t rounds) const {
+        using bigrams = typename Matcher::bigrams_t;
+        using match_t = std::tuple<size_t, size_t, size_t, double>;
+
+        auto matcher = Matcher();
+        for (size_t round = 0; round < rounds; ++round) {
+            auto tokens = random_sentence();
+
+            matcher.assign(tokens.begin(), tokens.end());
+
+            std::vector<bigrams> patterns(1 + std::rand() % 4);
+            for (auto & pattern: patterns)
+                pattern = bigrams(random_token()) + bigrams(random_token());
+
+            // Brute-force matches (exact rational threshold, in the matcher order)
+            std::vector<match_t> expected;
+            for (size_t begin = 0; begin < tokens.size(); ++begin) {
+                auto bgrms = bigrams();
+                for (size_t end = begin + 1; end <= tokens.size(); ++end) {
+                    bgrms += bigrams(tokens[end - 1].first);
+
+                    if (tokens[begin].second || tokens[end - 1].second) continue;
+
+                    for (size_t p = 0; p < patterns.size(); ++p) {
+                        const size_t isect = bigrams::intersect_size(bgrms, patterns[p]);
+                        const size_t size_sum = bgrms.size() + patterns[p].size();
+                        if (0 == isect) continue;
+                        if (2 * Threshold::den * isect < Threshold::num * size_sum) continue;
+
+                        expected.emplace_back(p, begin, end,
+                            bigrams::sorensen_dice_coef(bgrms, patterns[p]));
+                    }
+                }
+            }
+
+            std::vector<match_t> matches;
+            for (const auto & match: matcher.match_all(patterns, Threshold()))
+                matches.emplace_back(match.pattern, match.begin, match.end, match.score);
+
+            assert(matches == expected, "Compile-time threshold matches are exact");
+
+            const auto pttrn_set = libsdcxx::basic_pattern_set<typename bigrams::char_t>(patterns);
+            matches.clear();
+            for (const auto & match: matcher.match_all(pttrn_set, Threshold()))
+                matches.emplace_back(match.pattern, match.begin, match.end, match.score);
+
+            assert(matches == expected, "Compile-time threshold pattern set matches are exact");
+
+            std::vector<match_t> single;
+            for (const auto & match: expected)
+                if (0 == std::get<0>(match)) single.push_back(match);
+
+            matches.clear();
+            for (const auto & match: matcher.match(patterns[0], Threshold()))
+                matches.emplace_back(match.pattern, match.begin, match.end, match.score);
+
+            assert(matches == single, "Compile-time threshold incremental matches are exact");
+
+            // Run-time threshold of the same (exactly representable) value
+            if (std::is_same_v<Threshold, std::ratio<1, 2>>)
+                assert(matcher.match(patterns[0], 0.5).size() == single.size(),
+                    "Compile-time threshold matches are the same as run-time ones");
+        }
+    }
+
+    /**
+     *  \brief  Matching statistics UT
+     *
+     *  \tparam  Bigrams  Bigrams type
+     *
+     *  \param  rounds  Number of rounds
+     */
+    template <class Bigrams = bigrams>
+    void test_stats(size_t rounds) const {
+        using matcher_t = libsdcxx::basic_sequence_matcher<Bigrams>;
+        using counted_matcher_t = libsdcxx::basic_sequence_matcher<
+            Bigrams, libsdcxx::match_counters>;
+        using match_t = std::tuple<size_t, size_t, size_t, double>;
+
+        const char * const alphabet = "abcdef ";  // token characters
+
+        auto matcher = matcher_t();
+        auto counted = counted_matcher_t();
+
+        for (size_t round = 0; round < rounds; ++round) {
+            auto tokens = random_sentence(30, 5, alphabet);
+
+            const auto pattern =
+                Bigrams(random_token(alphabet)) + Bigrams(random_token(alphabet));
+            const double threshold = 0.1 + 0.1 * (std::rand() % 8);
+            const size_t cells = tokens.size() * (tokens.size() + 1) / 2;
+
+            matcher.assign(tokens.begin(), tokens.end());
+            counted.assign(tokens.begin(), tokens.end());
+            counted.reset_stats();
+            counted.reset_cache_stats();
+
+            // Match iterator
+            std::vector<match_t> expected, matches;
+            for (auto match = matcher.begin(pattern, threshold); match != matcher.end(); ++match)
+                expected.emplace_back(0, match.begin(), match.end(), match.sorensen_dice_coef());
+            for (auto match = counted.begin(pattern, threshold); match != counted.end(); ++match)
+                matches.emplace_back(0, match.begin(), match.end(), match.sorensen_dice_coef());
+
+            assert(matches == expected, "Counted matches are the same");
+
+            auto stats = counted.stats();
+            assert(stats.visited + stats.card_pruned <= cells, "Cells are visited at most once");
+            assert(stats.sdc_computations == matches.size() + stats.threshold_rejects,
+                "SDC is either accepted or rejected");
+            assert(stats.unions == counted.cache_stats().misses, "All unions are counted");
+            assert(0 < stats.unions || 0 == stats.bytes_allocated, "Only unions are counted");
+
+            const size_t strips = std::count_if(tokens.cbegin(), tokens.cend(),
+                [](const std::pair<std::string, bool> & token) { return token.second; });
+            assert(stats.strip_skips >= strips, "Strip tokens are skipped");
+
+            // Incremental scoring
+            counted.reset_stats();
+            const auto records = counted.match(pattern, threshold);
+            assert(records.size() == matches.size(), "Counted incremental matches");
+
+            const auto isect_stats = counted.stats();
+            assert(isect_stats.visited == stats.visited &&
+                isect_stats.card_pruned == stats.card_pruned &&
+                isect_stats.strip_skips == stats.strip_skips &&
+                isect_stats.sdc_computations == stats.sdc_computations + stats.sketch_rejects,
+                "Incremental scoring visits the same sub-sequences (with no sketch bound)");
+            assert(0 == isect_stats.unions, "Incremental scoring computes no unions");
+
+            // Multiple patterns
+            counted.reset_stats();
+            const std::vector<Bigrams> patterns{pattern, Bigrams(random_token(alphabet))};
+            const size_t match_cnt = counted.match_all(patterns, threshold).size();
+
+            stats = counted.stats();
+            assert(stats.sdc_computations == match_cnt + stats.threshold_rejects,
+                "SDC is either accepted or rejected (multiple patterns)");
+            assert(stats.visited + stats.card_pruned <= cells, "Cells are visited at most once");
+
+            // Best matches
+            counted.reset_stats();
+            const size_t best_cnt = counted.best_matches(pattern, 3, threshold).size();
+            stats = counted.stats();
+            assert(stats.sdc_computations >= best_cnt + stats.threshold_rejects,
+                "SDC is computed for the best matches");
+        }
+
+        // Without pruning, all the cells are visited
+        const std::vector<std::pair<std::string, bool>> tokens(10, std::make_pair("ab", false));
+        counted.assign(tokens.begin(), tokens.end());
+        counted.reset_stats();
+        counted.match(Bigrams("ab"), std::numeric_limits<double>::min());
+
+        auto stats = counted.stats();
+        assert(stats.visited == 55 && stats.card_pruned == 0 && stats.strip_skips == 0,
+            "All cells visited");
+        assert(stats.sdc_computations == 55 && stats.threshold_rejects == 0,
+            "All cells match");
+
+        // Sub-sequence bigrams are looked up once, whatever the number of patterns
+        const Bigrams pttrn("ab");
+        counted.assign(tokens.begin(), tokens.end());
+        counted.reset_cache_stats();
+        counted.match_all(std::vector<Bigrams>{pttrn}, std::numeric_limits<double>::min());
+        const auto single = counted.cache_stats();
+
+        counted.assign(tokens.begin(), tokens.end());
+        counted.reset_cache_stats();
+        counted.match_all(std::vector<Bigrams>{pttrn, pttrn, pttrn},
+            std::numeric_limits<double>::min());
+        assert(counted.cache_stats().hits == single.hits &&
+            counted.cache_stats().misses == single.misses,
+            "Cache lookups don't scale with patterns");
+
+        // Runs of strip strings are skipped
+        std::vector<std::pair<std::string, bool>> strips(6, std::make_pair("  ", true));
+        strips.front() = strips.back() = std::make_pair("ab", false);
+        counted.assign(strips.begin(), strips.end());
+
+        counted.reset_stats();
+        assert(counted.match(Bigrams("ab"), std::numeric_limits<double>::min()).size() == 3,
+            "Strip strings are skipped");
+        stats = counted.stats();
+        assert(stats.visited == 3 && stats.strip_skips == 8, "Strip runs skipped");
+
+        counted.reset_stats();
+        size_t match_cnt = 0;
+        const auto ab = Bigrams("ab");  // the iterator refers to the pattern
+        auto match = counted.begin(ab, std::numeric_limits<double>::min());
+        for (; match != counted.end(); ++match) ++match_cnt;
+        assert(3 == match_cnt, "Strip strings are skipped by iterator");
+        stats = counted.stats();
+        assert(stats.visited == 3 && stats.strip_skips == 8, "Strip runs skipped by iterator");
+
+        // Unions of many distinct bigrams aren't stored inline
+        const std::vector<std::string> words{
+            "lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing", "elit"};
+        counted.assign(words.begin(), words.end());
+        counted.reset_stats();
+        counted.subsequence(0, words.size());
+        stats = counted.stats();
+        assert(stats.unions > 0 && stats.bytes_allocated > 0, "Union allocations counted");
+
+        // Sub-sequences sharing no bigrams with the pattern are rejected by sketch bound
+        counted.reset_stats();
+        size_t sketch_cnt = 0;
+        auto sketch_match = counted.begin(Bigrams("xyzzyq"), 0.5);
+        for (; sketch_match != counted.end(); ++sketch_match)
+            ++sketch_cnt;
+        stats = counted.stats();
+        assert(0 == sketch_cnt, "No sub-sequence matches");
+        assert(stats.visited == stats.sdc_computations + stats.sketch_rejects,
+            "Visited sub-sequences are either scored or rejected by sketch bound");
+        assert(Bigrams::sketched ? 0 < stats.sketch_rejects : 0 == stats.sketch_rejects,
+            "Sketch bound rejects");
+
+        counted.reset_stats();
+        assert(0 == counted.stats().visited, "Statistics reset");
+        assert(0 == matcher.stats().visited && 0 == matcher.stats().unions,
+            "Statistics aren't counted by default");
+    }
+
     public:
 
     test_sequence_matcher(int argc, char * const argv[]): unit_test(argc, argv) {}
@@ -129,6 +660,25 @@ class test_sequence_matcher: public unit_test {
         test_matching(FULL);
         test_matching(PARTIAL);
         test_matching(NONE);
+        test_matching<flat_sequence_matcher>(FULL);
+        test_matching<flat_sequence_matcher>(NONE);
+        test_assign();
+        test_assign<flat_sequence_matcher>();
+
+        seed_rng();
+        test_random(500);
+        test_random<flat_sequence_matcher>(500);
+        test_random<sketched_sequence_matcher>(500);
+        test_cache(300);
+        test_cache<flat_sequence_matcher>(300);
+        test_static_threshold<sequence_matcher, std::ratio<1, 2>>(300);
+        test_static_threshold<sequence_matcher, std::ratio<4, 5>>(300);
+        test_static_threshold<flat_sequence_matcher, std::ratio<13, 20>>(300);
+        test_static_threshold<flat_sequence_matcher, std::ratio<1, 1>>(100);
+        test_static_threshold<sketched_sequence_matcher, std::ratio<4, 5>>(300);
+        test_stats(300);
+        test_stats<libsdcxx::flat_bigrams>(300);
+        test_stats<libsdcxx::sketched_bigrams>(300);
     }
 
 };  // end of class test_sequence_matcher
@@ -0,0 +1,276 @@
+/**
+ *  \file
+ *  \brief  Sharded pattern set unit test
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <libsdcxx/sharded_pattern_set.hxx>
+#include <libsdcxx/pattern_set.hxx>
+#include <libsdcxx/sequence_matcher.hxx>
+#include <libsdcxx/bigrams.hxx>
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <utility>
+
+#include "random_fixture.hxx"
+#include "unit_test.hxx"
+
+
+/** Sharded pattern set unit test */
+class test_sharded_pattern_set: public unit_test {
+    private:
+
+    using bigrams = libsdcxx::bigrams;
+    using pattern_set = libsdcxx::pattern_set;
+    using pattern_shard = libsdcxx::pattern_shard;
+    using sharded_pattern_set = libsdcxx::sharded_pattern_set;
+
+    /** Malformed input check */
+    template <class Fn>
+    static bool throws(Fn fn) {
+        try { fn(); }
+        catch (const libsdcxx::binary_format_error & ) { return true; }
+        return false;
+    }
+
+    /** Sharded set vs patterns comparison */
+    void test_random(size_t rounds) const {
+        for (size_t round = 0; round < rounds; ++round) {
+            std::vector<bigrams> patterns(std::rand() % 30);
+            for (auto & pattern: patterns)
+                pattern = bigrams(random_token()) + bigrams(random_token());
+
+            const size_t shard_cnt = 1 + std::rand() % 5;
+            const auto sharding = std::rand() % 2
+                ? sharded_pattern_set::HASH_SHARDING
+                : sharded_pattern_set::SIZE_SHARDING;
+
+            const auto set = sharded_pattern_set(
+                patterns, shard_cnt, sharding, pattern_set::INDEX);
+            assert(set.size() == patterns.size() && set.shard_cnt() == shard_cnt,
+                "All patterns are sharded");
+
+            std::vector<size_t> shard_of(patterns.size(), shard_cnt);
+            for (size_t s = 0; s < shard_cnt; ++s) {
+                const auto & shard = set.shard(s);
+                for (size_t p = 0; p < shard.size(); ++p) {
+                    const size_t id = shard.ids()[p];
+                    assert(id < patterns.size() && shard_cnt == shard_of[id],
+                        "Pattern is in exactly 1 shard");
+                    assert(shard.patterns().pattern_size(p) == patterns[id].size(),
+                        "Shard pattern is the pattern of the ID");
+                    shard_of[id] = s;
+                }
+            }
+            for (size_t p = 0; p < patterns.size(); ++p) {
+                assert(shard_of[p] < shard_cnt, "Pattern is sharded");
+                if (sharded_pattern_set::HASH_SHARDING == sharding)
+                    assert(sharded_pattern_set::shard_of(patterns[p], shard_cnt) == shard_of[p],
+                        "Pattern is in its hash shard");
+            }
+
+            const double threshold = 0.3 + 0.1 * (std::rand() % 7);
+
+            // Matching vs patterns matching (the order must be exactly the same)
+            std::vector<sentence_t> batch(1 + std::rand() % 5);
+            for (auto & sentence: batch) sentence = random_sentence();
+
+            auto matcher = libsdcxx::sequence_matcher();
+            std::vector<libsdcxx::corpus_match> expected;
+            for (size_t seq = 0; seq < batch.size(); ++seq) {
+                matcher.assign(batch[seq].begin(), batch[seq].end());
+                const auto matches = matcher.match_all(patterns, threshold);
+                assert(tuples(set.match_all(matcher, threshold)) == tuples(matches),
+                    "Sharded set matches are the same as the patterns ones");
+
+                for (const auto & match: matches)
+                    expected.push_back(libsdcxx::corpus_match{seq, match});
+            }
+
+            assert(tuples(set.match_batch(matcher, batch, threshold)) == tuples(expected),
+                "Sharded set batch matches are the same as the patterns ones");
+
+            // Shard answers serialised and merged in reverse order
+            std::vector<std::vector<libsdcxx::corpus_match>> answers;
+            for (size_t s = shard_cnt; s-- > 0; ) {
+                const auto answer = libsdcxx::serialise_matches(
+                    set.shard(s).match_batch(matcher, batch, threshold));
+                answers.push_back(libsdcxx::deserialise_matches(answer.data(), answer.size()));
+            }
+
+            assert(tuples(libsdcxx::merge_matches(answers)) == tuples(expected),
+                "Merged shard answers are the same as the patterns matches");
+
+            // Index lookup vs brute force
+            const auto query = bigrams(random_token() + random_token());
+            std::vector<size_t> expected_lookup, lookup;
+            for (size_t p = 0; p < patterns.size(); ++p)
+                if (bigrams::sorensen_dice_coef(query, patterns[p]) >= threshold)
+                    expected_lookup.push_back(p);
+            for (const auto & match: set.lookup(query, threshold))
+                lookup.push_back(match.entry);
+            assert(lookup == expected_lookup, "Sharded set lookup is the same as brute force");
+        }
+    }
+
+    /** Shard save, map and load UT */
+    void test_save() const {
+        std::vector<bigrams> patterns(40);
+        for (auto & pattern: patterns)
+            pattern = bigrams(random_token()) + bigrams(random_token());
+
+        const auto set = sharded_pattern_set(patterns, 3, sharded_pattern_set::SIZE_SHARDING);
+        const auto batch = std::vector<sentence_t>{ random_sentence(), random_sentence() };
+        auto matcher = libsdcxx::sequence_matcher();
+
+        std::vector<pattern_shard> loaded;
+        for (size_t s = 0; s < set.shard_cnt(); ++s) {
+            const auto & shard = set.shard(s);
+
+            std::ostringstream out;
+            shard.save(out);
+            const auto saved = out.str();
+            assert(saved.size() == pattern_set::alignment + shard.patterns().blob_size() +
+                16 + 8 * shard.size(), "Saved shard size");
+
+            const char * const path = "test_sharded_pattern_set.sdcxxps";
+            shard.save(path);
+            loaded.push_back(pattern_shard::load(path));
+            const auto as_set = pattern_set::load(path);  // shard is a pattern set, too
+            std::remove(path);
+
+            assert(loaded.back().ids() == shard.ids(), "Saved shard IDs are restored");
+            assert(as_set.size() == shard.size(), "Saved shard loads as pattern set");
+            assert(tuples(loaded.back().match_batch(matcher, batch, 0.5)) ==
+                tuples(shard.match_batch(matcher, batch, 0.5)),
+                "Saved shard patterns are restored");
+
+            // Malformed shard IDs
+            auto * const memory = static_cast<std::byte *>(
+                ::operator new(saved.size(), std::align_val_t(pattern_set::alignment)));
+            std::memcpy(memory, saved.data(), saved.size());
+
+            assert(pattern_shard::map(memory, saved.size()).ids() == shard.ids(),
+                "Mapped shard IDs are restored");
+            assert(throws([&]() { pattern_shard::map(memory, saved.size() - 1); }),
+                "Truncated shard IDs");
+            assert(throws([&]() { pattern_shard::map(memory, saved.size() - 8); }),
+                "Truncated shard IDs");
+            if (shard.size() > 1) {
+                std::swap(memory[saved.size() - 1], memory[saved.size() - 9]);
+                std::swap(memory[saved.size() - 8], memory[saved.size() - 16]);
+                assert(throws([&]() { pattern_shard::map(memory, saved.size()); }),
+                    "Shard IDs must be ascending");
+            }
+
+            ::operator delete(memory, std::align_val_t(pattern_set::alignment));
+        }
+
+        const auto reassembled = sharded_pattern_set(std::move(loaded));
+        assert(reassembled.size() == patterns.size(), "Shards are reassembled");
+        assert(tuples(reassembled.match_batch(matcher, batch, 0.5)) ==
+            tuples(set.match_batch(matcher, batch, 0.5)),
+            "Reassembled set matches are the same");
+    }
+
+    /** Match stream serialisation UT */
+    void test_serialisation() const {
+        const std::vector<libsdcxx::corpus_match> matches = {
+            { 0, { 3, 0, 1, 1.0 } },
+            { 0, { 1, 0, 2, 0.5 } },
+            { 0, { 7, 5, 9, 0.75 } },
+            { 4, { 300, 2, 3, 1.0 / 3.0 } },
+        };
+
+        const auto binary = libsdcxx::serialise_matches(matches);
+        std::cout << "Serialised " << matches.size() << " matches to "
+            << binary.size() << " bytes" << std::endl;
+        assert(binary.size() == 5 + 1 + 4 * 12 + 1, "Matches binary is compact");
+        assert(tuples(libsdcxx::deserialise_matches(binary.data(), binary.size())) ==
+            tuples(matches), "Matches are deserialised");
+
+        const auto empty = libsdcxx::serialise_matches({});
+        assert(libsdcxx::deserialise_matches(empty.data(), empty.size()).empty(),
+            "No matches are deserialised");
+
+        const auto deserialise = [](const std::string & binary) {
+            libsdcxx::deserialise_matches(binary.data(), binary.size());
+        };
+        assert(throws([&]() { deserialise(binary.substr(0, 4)); }), "Truncated header");
+        assert(throws([&]() { deserialise(binary.substr(0, binary.size() - 1)); }),
+            "Truncated matches");
+        assert(throws([&]() { deserialise("SDCX" + binary.substr(4)); }), "Bad magic");
+
+        auto bad_version = binary;
+        bad_version[4] = 2;
+        assert(throws([&]() { deserialise(bad_version); }), "Unsupported version");
+    }
+
+    public:
+
+    test_sharded_pattern_set(int argc, char * const argv[]): unit_test(argc, argv) {}
+
+    /** Run unit test */
+    void run() const {
+        const auto empty = sharded_pattern_set();
+        assert(empty.size() == 0 && empty.shard_cnt() == 0, "Empty set");
+
+        const std::vector<bigrams> patterns = {
+            bigrams("abcd"), bigrams("bcd"), bigrams("xyz"), bigrams("wxyz") };
+        const auto set = sharded_pattern_set(patterns, 2, sharded_pattern_set::SIZE_SHARDING);
+        assert(set.shard(0).ids() == std::vector<size_t>({ 1, 2 }), "Smaller patterns shard");
+        assert(set.shard(1).ids() == std::vector<size_t>({ 0, 3 }), "Bigger patterns shard");
+
+        seed_rng();
+        test_serialisation();
+        test_random(300);
+        test_save();
+    }
+
+};  // end of class test_sharded_pattern_set
+
+
+int main(int argc, char * const argv[]) {
+    return test_sharded_pattern_set(argc, argv).exec();
+}
@@ -0,0 +1,141 @@
+/**
+ *  \file
+ *  \brief  SIMD intersection size kernels unit test
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <libsdcxx/simd_intersect.hxx>
+#include <iostream>
+#include <cstdlib>
+#include <cstdint>
+#include <set>
+#include <vector>
+#include <string>
+
+#include "unit_test.hxx"
+
+
+/** SIMD intersection size kernels unit test */
+class test_simd_intersect: public unit_test {
+    private:
+
+    /** Sorted unique keys with counts */
+    template <typename Key>
+    struct keys_cnts {
+        std::vector<Key> keys;
+        std::vector<size_t> cnts;
+
+        keys_cnts(size_t len, size_t range) {
+            std::set<Key> key_set;
+            while (key_set.size() < len)
+                key_set.insert(static_cast<Key>(std::rand() % range));
+
+            keys.assign(key_set.begin(), key_set.end());
+            for (size_t i = 0; i < len; ++i)
+                cnts.push_back(1 + std::rand() % 4);
+        }
+    };
+
+    /**
+     *  \brief  Compare kernel with the scalar kernel on random data
+     *
+     *  \param  name    Kernel name
+     *  \param  kernel  Tested kernel
+     *  \param  rounds  Number of rounds
+     */
+    template <typename Key>
+    void test_kernel(
+        const std::string & name,
+        libsdcxx::simd::intersect_size_fn<Key, size_t> kernel,
+        size_t rounds) const
+    {
+        std::cout << "Testing " << name << " kernel ("
+            << 8 * sizeof(Key) << "-bit keys)" << std::endl;
+
+        for (size_t round = 0; round < rounds; ++round) {
+            const size_t range = 1 + std::rand() % 400;  // key density varies
+            const auto a = keys_cnts<Key>(std::rand() % std::min<size_t>(range, 150), range);
+            const auto b = keys_cnts<Key>(std::rand() % std::min<size_t>(range, 150), range);
+
+            const auto expected = libsdcxx::simd::intersect_size_scalar(
+                a.keys.data(), a.cnts.data(), a.keys.size(),
+                b.keys.data(), b.cnts.data(), b.keys.size());
+
+            const auto size = kernel(
+                a.keys.data(), a.cnts.data(), a.keys.size(),
+                b.keys.data(), b.cnts.data(), b.keys.size());
+
+            assert(size == expected,
+                name + " kernel result " + std::to_string(size) +
+                " == " + std::to_string(expected));
+        }
+    }
+
+    /** Test available kernels for key type */
+    template <typename Key>
+    void test_kernels(size_t rounds) const {
+        test_kernel<Key>("dispatched", &libsdcxx::simd::intersect_size<Key, size_t>, rounds);
+
+#if defined(LIBSDCXX_SIMD_X86)
+        if (libsdcxx::simd::cpu_has_avx2())
+            test_kernel<Key>("AVX2", &libsdcxx::simd::intersect_size_avx2<size_t>, rounds);
+        if (libsdcxx::simd::cpu_has_avx512())
+            test_kernel<Key>("AVX-512", &libsdcxx::simd::intersect_size_avx512<size_t>, rounds);
+#elif defined(LIBSDCXX_SIMD_NEON)
+        test_kernel<Key>("NEON", &libsdcxx::simd::intersect_size_neon<size_t>, rounds);
+#endif
+    }
+
+    public:
+
+    test_simd_intersect(int argc, char * const argv[]): unit_test(argc, argv) {}
+
+    /** Run unit test */
+    void run() const {
+        seed_rng();
+        test_kernels<uint16_t>(5000);
+        test_kernels<uint64_t>(5000);
+        test_kernel<uint32_t>("dispatched (scalar only)",
+            &libsdcxx::simd::intersect_size<uint32_t, size_t>, 100);
+    }
+
+};  // end of class test_simd_intersect
+
+
+int main(int argc, char * const argv[]) {
+    return test_simd_intersect(argc, argv).exec();
+}
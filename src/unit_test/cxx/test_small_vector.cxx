@@ -0,0 +1,136 @@
+/**
+ *  \file
+ *  \brief  Small vector unit test
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <libsdcxx/small_vector.hxx>
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "unit_test.hxx"
+
+
+/** Small vector unit test */
+class test_small_vector: public unit_test {
+    private:
+
+    using small_vector = libsdcxx::small_vector<int, 4>;
+
+    /** Small vector must have the same items as a vector */
+    static bool same(const small_vector & svec, const std::vector<int> & vec) {
+        return svec.size() == vec.size() && std::equal(vec.begin(), vec.end(), svec.begin());
+    }
+
+    /** Test random operations against std::vector */
+    void test_random(size_t rounds) const {
+        for (size_t round = 0; round < rounds; ++round) {
+            small_vector svec1, svec2;
+            std::vector<int> vec1, vec2;
+
+            for (size_t op = 0; op < 20; ++op) {
+                switch (std::rand() % 6) {
+                    case 0:
+                    case 1: {
+                        const int item = std::rand();
+                        svec1.push_back(item);
+                        vec1.push_back(item);
+                        break;
+                    }
+
+                    case 2:
+                        svec1.swap(svec2);
+                        vec1.swap(vec2);
+                        break;
+
+                    case 3:
+                        svec2 = svec1;
+                        vec2 = vec1;
+                        break;
+
+                    case 4:
+                        svec1 = small_vector(svec2);
+                        vec1 = vec2;
+                        break;
+
+                    case 5: {
+                        small_vector moved(std::move(svec1));
+                        svec1 = std::move(svec2);
+                        svec2 = std::move(moved);
+                        vec1.swap(vec2);
+                        break;
+                    }
+                }
+
+                assert(same(svec1, vec1) && same(svec2, vec2),
+                    "Small vectors have the expected items");
+            }
+        }
+    }
+
+    public:
+
+    test_small_vector(int argc, char * const argv[]): unit_test(argc, argv) {}
+
+    /** Run unit test */
+    void run() const {
+        small_vector svec;
+        assert(svec.empty() && svec.capacity() == 4, "Inline capacity is available");
+
+        for (int i = 0; i < 4; ++i) svec.push_back(i);
+        assert(svec.capacity() == 4, "No spill up to inline capacity");
+
+        svec.push_back(svec[0]);
+        assert(svec.size() == 5 && svec.capacity() > 4, "Spill past inline capacity");
+        assert(svec[4] == 0, "Own item pushed back on spill");
+
+        svec.clear();
+        assert(svec.empty() && svec.capacity() > 4, "Capacity is kept on clear");
+
+        seed_rng();
+        test_random(1000);
+    }
+
+};  // end of class test_small_vector
+
+
+int main(int argc, char * const argv[]) {
+    return test_small_vector(argc, argv).exec();
+}
@@ -0,0 +1,230 @@
+/**
+ *  \file
+ *  \brief  Stream matcher unit test
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <libsdcxx/stream_matcher.hxx>
+#include <libsdcxx/sequence_matcher.hxx>
+#include <libsdcxx/bigrams.hxx>
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <utility>
+#include <ratio>
+#include <algorithm>
+#include <stdexcept>
+
+#include "random_fixture.hxx"
+#include "unit_test.hxx"
+
+
+/** Stream matcher unit test */
+class test_stream_matcher: public unit_test {
+    private:
+
+    using match_t = std::tuple<size_t, size_t, size_t, double>;  // end, begin, pattern, SDC
+
+    /** Match tuple (in stream order) */
+    static match_t tuple(const libsdcxx::sequence_match & match) {
+        return match_t(match.end, match.begin, match.pattern, match.score);
+    }
+
+    /**
+     *  \brief  Stream matching vs whole sequence matching
+     *
+     *  \tparam  Bigrams  Bigrams type
+     *
+     *  \param  rounds  Number of rounds
+     */
+    template <class Bigrams>
+    void test_random(size_t rounds) const {
+        for (size_t round = 0; round < rounds; ++round) {
+            std::vector<Bigrams> patterns(1 + std::rand() % 8);
+            for (auto & pattern: patterns)
+                pattern = Bigrams(random_token("abcd ", 5) + random_token("abcd ", 5));
+
+            const auto stream = random_sentence(60, 5, "abcd ", 5);
+
+            const double threshold = 0.3 + 0.1 * (std::rand() % 7);
+            const size_t window = 1 + std::rand() % 8;
+
+            // Whole sequence matches up to the window length
+            auto matcher = libsdcxx::basic_sequence_matcher<Bigrams>();
+            matcher.assign(stream.begin(), stream.end());
+
+            std::vector<match_t> expected;
+            for (const auto & match: matcher.match_all(patterns, threshold))
+                if (match.end - match.begin <= window) expected.push_back(tuple(match));
+            std::sort(expected.begin(), expected.end());
+
+            auto smatcher = libsdcxx::basic_stream_matcher<Bigrams>(patterns, threshold, window);
+            assert(smatcher.patterns() == patterns.size() && smatcher.window() == window,
+                "Stream matcher attributes");
+
+            for (size_t pass = 0; pass < 2; ++pass) {  // 2nd pass after reset
+                std::vector<match_t> matches;
+                for (const auto & token: stream)
+                    smatcher.push_back(Bigrams(token.first), token.second,
+                        [&](const libsdcxx::sequence_match & match) {
+                            assert(match.end == smatcher.position(),
+                                "Match is reported as soon as it ends");
+                            matches.push_back(tuple(match));
+                        });
+
+                assert(smatcher.position() == stream.size(), "Stream position");
+                assert(matches == expected, "Stream matches are the whole sequence ones");
+                assert(std::is_sorted(matches.begin(), matches.end()),
+                    "Stream matches are ordered by end");
+
+                smatcher.reset();
+            }
+        }
+    }
+
+    /**
+     *  \brief  Stream matching with compile-time threshold
+     *
+     *  \tparam  Bigrams  Bigrams type
+     *  \tparam  Ratio    Threshold
+     *
+     *  \param  rounds  Number of rounds
+     */
+    template <class Bigrams, class Ratio>
+    void test_static_threshold(size_t rounds) const {
+        using threshold_t = decltype(libsdcxx::make_threshold(Ratio()));
+        using smatcher_t = libsdcxx::basic_stream_matcher<Bigrams, threshold_t>;
+
+        for (size_t round = 0; round < rounds; ++round) {
+            std::vector<Bigrams> patterns(1 + std::rand() % 8);
+            for (auto & pattern: patterns)
+                pattern = Bigrams(random_token("abcd ", 5) + random_token("abcd ", 5));
+
+            const auto stream = random_sentence(60, 5, "abcd ", 5);
+
+            const size_t window = 1 + std::rand() % 8;
+
+            auto matcher = libsdcxx::basic_sequence_matcher<Bigrams>();
+            matcher.assign(stream.begin(), stream.end());
+
+            std::vector<match_t> expected;
+            for (const auto & match: matcher.match_all(patterns, Ratio()))
+                if (match.end - match.begin <= window) expected.push_back(tuple(match));
+            std::sort(expected.begin(), expected.end());
+
+            auto smatcher = smatcher_t(patterns, Ratio(), window);
+            std::vector<match_t> matches;
+            for (const auto & token: stream)
+                smatcher.push_back(Bigrams(token.first), token.second,
+                    [&](const libsdcxx::sequence_match & match) {
+                        matches.push_back(tuple(match));
+                    });
+
+            assert(matches == expected, "Static threshold stream matches");
+        }
+    }
+
+    /** Long stream UT */
+    void test_long() const {
+        const std::vector<libsdcxx::bigrams> patterns = {
+            libsdcxx::bigrams("Sorensen Dice"), libsdcxx::bigrams("coefficient") };
+        auto matcher = libsdcxx::stream_matcher(patterns, 0.8, 4);
+        assert(18 == matcher.max_size(), "Max. sub-sequence size");
+
+        const char * const tokens[] = { "the", " ", "Sorensen", " ", "Dice", " ",
+            "coeficient", " ", "of", " ", "Sørensen", "-", "Dice" };
+
+        size_t match_cnt = 0;
+        for (size_t round = 0; round < 10000; ++round)
+            for (const auto token: tokens) {
+                const auto matches = matcher.emplace_back(token, ' ' == *token);
+                for (const auto & match: matches) {
+                    assert(match.end == matcher.position(), "Match end");
+                    assert(match.end - match.begin <= matcher.window(), "Match length");
+                }
+                match_cnt += matches.size();
+            }
+
+        assert(matcher.position() == 10000 * sizeof(tokens) / sizeof(*tokens),
+            "Stream position");
+        assert(match_cnt == 4 + 5 * 9999, "Stream matches");  // + 1 across rounds
+    }
+
+    /** Throwing sink UT (no stale matches are reported afterwards) */
+    void test_throwing_sink() const {
+        const std::vector<libsdcxx::bigrams> patterns = {
+            libsdcxx::bigrams("abcd"), libsdcxx::bigrams("abcd") };
+        auto matcher = libsdcxx::stream_matcher(patterns, 0.5, 1);
+
+        try {
+            matcher.push_back(libsdcxx::bigrams("abcd"), false,
+                [](const libsdcxx::sequence_match &) {
+                    throw std::runtime_error("sink failure");
+                });
+            assert(false, "Sink exception is propagated");
+        }
+        catch (const std::runtime_error &) {}
+
+        const auto matches = matcher.emplace_back("abcd");
+        assert(2 == matches.size(), "Only the current matches are reported");
+        for (const auto & match: matches)
+            assert(match.end == matcher.position(), "Match end");
+    }
+
+    public:
+
+    test_stream_matcher(int argc, char * const argv[]): unit_test(argc, argv) {}
+
+    /** Run unit test */
+    void run() const {
+        seed_rng();
+        test_random<libsdcxx::bigrams>(300);
+        test_random<libsdcxx::flat_bigrams>(300);
+        test_static_threshold<libsdcxx::bigrams, std::ratio<1, 2>>(300);
+        test_static_threshold<libsdcxx::flat_bigrams, std::ratio<4, 5>>(300);
+        test_long();
+        test_throwing_sink();
+    }
+
+};  // end of class test_stream_matcher
+
+
+int main(int argc, char * const argv[]) {
+    return test_stream_matcher(argc, argv).exec();
+}
@@ -39,6 +39,10 @@
  */
 
 #include <libsdcxx/bigram_multiset.hxx>
+#include <libsdcxx/bigrams.hxx>
+#include <iostream>
+#include <cstdlib>
+#include <string>
 
 #include "unit_test.hxx"
 
@@ -50,6 +54,33 @@ class test_unordered_bigram_multiset: public unit_test {
     using unordered_bigram_multiset = libsdcxx::unordered_bigram_multiset;
     using unordered_wbigram_multiset = libsdcxx::unordered_wbigram_multiset;
 
+    /** Random string (few characters, so that bigrams repeat) */
+    static std::string random_string(size_t max_len) {
+        static const char alphabet[] = "abcdef ";
+
+        std::string str(std::rand() % (max_len + 1), ' ');
+        for (auto & ch: str)
+            ch = alphabet[std::rand() % (sizeof(alphabet) - 1)];
+
+        return str;
+    }
+
+    /** Intersection sizes are the same as the sorted bigrams ones */
+    void test_random(size_t rounds, size_t max_len = 80) const {
+        for (size_t round = 0; round < rounds; ++round) {
+            const auto str1 = random_string(max_len);
+            const auto str2 = random_string(max_len);
+
+            const auto bgrms1 = unordered_bigram_multiset(str1);
+            const auto bgrms2 = unordered_bigram_multiset(str2);
+
+            assert(unordered_bigram_multiset::intersect_size(bgrms1, bgrms2) ==
+                libsdcxx::bigrams::intersect_size(
+                    libsdcxx::bigrams(str1), libsdcxx::bigrams(str2)),
+                "Unordered bigram multisets intersection size is correct");
+        }
+    }
+
     public:
 
     test_unordered_bigram_multiset(int argc, char * const argv[]):
@@ -94,6 +125,9 @@ class test_unordered_bigram_multiset: public unit_test {
             << L"unordered_wbigram_multiset(\"S\u00f8rensen\") == "
             << wbgrms << std::endl;
         assert(wbgrms.size() == 7, "|{So, or, re, en, ns, se, en}| == 7");
+
+        seed_rng();
+        test_random(1000);
     }
 
 };  // end of class test_unordered_bigram_multiset
@@ -0,0 +1,203 @@
+/**
+ *  \file
+ *  \brief  UTF-8 decoding unit test
+ *
+ *  \date   2026/10/14
+ *  \author Václav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2023, Václav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <libsdcxx/utf8.hxx>
+#include <libsdcxx/bigrams.hxx>
+#include <libsdcxx/sequence_matcher.hxx>
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "unit_test.hxx"
+
+
+/** UTF-8 decoding unit test */
+class test_utf8: public unit_test {
+    private:
+
+    /** UTF-8 encoding (of valid code points) */
+    static std::string encode(const std::u32string & str) {
+        std::string utf8;
+        for (const char32_t cp: str) {
+            if (cp < 0x80) utf8 += static_cast<char>(cp);
+            else if (cp < 0x800) {
+                utf8 += static_cast<char>(0xC0 | (cp >> 6));
+                utf8 += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+            else if (cp < 0x10000) {
+                utf8 += static_cast<char>(0xE0 | (cp >> 12));
+                utf8 += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                utf8 += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+            else {
+                utf8 += static_cast<char>(0xF0 | (cp >> 18));
+                utf8 += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                utf8 += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                utf8 += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+        }
+
+        return utf8;
+    }
+
+    /** Decode whole string */
+    static std::u32string decode(std::string_view utf8) {
+        std::u32string str;
+        const char * ptr = utf8.data();
+        const char * const end = ptr + utf8.size();
+        while (ptr < end) str += libsdcxx::utf8_decode(ptr, end);
+
+        return str;
+    }
+
+    /** Wide string (of code points) */
+    static std::wstring wide(const std::u32string & str) {
+        return std::wstring(str.begin(), str.end());
+    }
+
+    /** Bigrams equality */
+    template <class Bigrams>
+    static bool equal(const Bigrams & bgrms1, const Bigrams & bgrms2) {
+        if (bgrms1.size() != bgrms2.size()) return false;
+
+        auto bigram1 = bgrms1.begin();
+        auto bigram2 = bgrms2.begin();
+        for (; bigram1 != bgrms1.end() && bigram2 != bgrms2.end(); ++bigram1, ++bigram2)
+            if (*bigram1 != *bigram2) return false;
+
+        return bigram1 == bgrms1.end() && bigram2 == bgrms2.end();
+    }
+
+    /** Random code point (of all encoding lengths) */
+    static char32_t random_code_point() {
+        switch (std::rand() % 4) {
+            case 0:  return U"ab c"[std::rand() % 4];
+            case 1:  return 0xE0 + std::rand() % 4;
+            case 2:  return 0x4E00 + std::rand() % 4;
+            default: return 0x1F600 + std::rand() % 4;
+        }
+    }
+
+    /** Decoding of (mal)formed sequences UT */
+    void test_decode() const {
+        assert(decode("") == U"", "Empty string");
+        assert(decode("abc") == U"abc", "ASCII");
+        assert(decode("S\xc3\xb8rensen") == U"Sørensen", "2-byte sequence");
+        assert(decode("\xe2\x82\xac") == U"€", "3-byte sequence");
+        assert(decode("\xf0\x9f\x98\x80") == U"\U0001F600", "4-byte sequence");
+
+        assert(decode("a\xc3") == U"a�", "Truncated sequence");
+        assert(decode("\xc3" "a") == U"�" "a", "Bad continuation byte");
+        assert(decode("\x80" "a") == U"�" "a", "Stray continuation byte");
+        assert(decode("\xc0\xaf") == U"��", "Overlong sequence");
+        assert(decode("\xe0\x80\xaf") == U"���", "Overlong sequence");
+        assert(decode("\xed\xa0\x80") == U"���", "Surrogate");
+        assert(decode("\xf4\x90\x80\x80") == U"����", "Out of range");
+        assert(decode("\xff") == U"�", "Invalid lead byte");
+    }
+
+    /**
+     *  \brief  Bigrams of UTF-8 strings UT
+     *
+     *  \tparam  Bigrams  Bigrams type
+     *
+     *  \param  rounds  Number of rounds
+     */
+    template <class Bigrams>
+    void test_bigrams(size_t rounds) const {
+        assert(Bigrams(libsdcxx::utf8, "").size() == 0, "Empty string");
+        assert(Bigrams(libsdcxx::utf8, "\xc3\xb8").size() == 0, "Single character");
+        assert(equal(Bigrams(libsdcxx::utf8, "S\xc3\xb8rensen"), Bigrams(L"Sørensen")),
+            "UTF-8 bigrams are the same as wide string ones");
+        assert(equal(Bigrams(libsdcxx::utf8, "a\xc3"), Bigrams(L"a�")),
+            "Malformed sequence produces replacement character");
+
+        for (size_t round = 0; round < rounds; ++round) {
+            std::u32string str(std::rand() % 40, U' ');
+            for (auto & cp: str) cp = random_code_point();
+
+            const auto utf8 = encode(str);
+            assert(decode(utf8) == str, "Decoding inverts encoding");
+            assert(equal(Bigrams(libsdcxx::utf8, utf8), Bigrams(wide(str))),
+                "UTF-8 bigrams are the same as wide string ones");
+
+            const auto wstr = wide(str);
+            const auto view = std::wstring_view(wstr).substr(0, str.size() / 2);
+            assert(equal(Bigrams(view), Bigrams(std::wstring(view))),
+                "String view bigrams are the same as string ones");
+        }
+    }
+
+    /** Matcher UTF-8 input UT */
+    void test_matcher() const {
+        auto matcher = libsdcxx::wsequence_matcher();
+        matcher.emplace_back(libsdcxx::utf8, "S\xc3\xb8rensen");
+        matcher.emplace_back(libsdcxx::utf8, " -", true);
+        matcher.emplace_back(L"Dice");
+
+        const auto pattern = libsdcxx::wbigrams(L"Sørensen");
+        const auto match = matcher.begin(pattern, 0.9);
+        assert(match != matcher.end(), "UTF-8 token matched");
+        assert(match.begin() == 0 && match.end() == 1 && match.sorensen_dice_coef() == 1.0,
+            "UTF-8 token match");
+    }
+
+    public:
+
+    test_utf8(int argc, char * const argv[]): unit_test(argc, argv) {}
+
+    /** Run unit test */
+    void run() const {
+        test_decode();
+
+        seed_rng();
+        test_bigrams<libsdcxx::wbigrams>(500);
+        test_bigrams<libsdcxx::wflat_bigrams>(500);
+        test_matcher();
+    }
+
+};  // end of class test_utf8
+
+
+int main(int argc, char * const argv[]) {
+    return test_utf8(argc, argv).exec();
+}
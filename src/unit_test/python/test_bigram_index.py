@@ -0,0 +1,72 @@
+import random
+import threading
+
+from pysdcxx import BigramIndex, Bigrams
+
+
+def test_empty():
+    index = BigramIndex()
+    assert len(index) == 0
+    assert index.lookup("abcd", 0.5) == []
+
+
+def test_insert():
+    index = BigramIndex(["abcd", Bigrams("bcd")], reserve=3)
+    assert len(index) == 2
+    assert index.insert("xyz") == 2
+    assert len(index) == 3
+
+
+def test_clear():
+    index = BigramIndex(["abcd", "bcd"])
+    index.clear()
+    assert len(index) == 0
+    assert index.insert("xyz") == 0
+
+
+def test_lookup():
+    index = BigramIndex(["Sørensen", "Dice", "coefficient", "Sorensen"])
+    matches = index.lookup("Sørenson", 0.7)
+    assert [match.entry for match in matches] == [0]
+    assert matches[0].score == Bigrams.sorensen_dice_coef(Bigrams("Sørensen"), Bigrams("Sørenson"))
+
+
+def test_lookup_brute_force():
+    rng = random.Random(1)
+    words = ["".join(rng.choice("abcde ") for _ in range(rng.randint(0, 10)))
+             for _ in range(300)]
+    index = BigramIndex(words)
+
+    for query in words[:30]:
+        for threshold in (0.3, 0.6, 0.9):
+            expected = [
+                entry for entry, word in enumerate(words)
+                if Bigrams.sorensen_dice_coef(Bigrams(word), Bigrams(query)) >= threshold
+            ]
+            assert [m.entry for m in index.lookup(query, threshold)] == expected
+
+
+def test_lookup_threads():
+    rng = random.Random(1)
+    words = ["".join(rng.choice("abcde") for _ in range(rng.randint(1, 8)))
+             for _ in range(1000)]
+    index = BigramIndex(words)
+    queries = words[:50]
+    expected = [index.lookup(query, 0.5) for query in queries]
+
+    results = {}
+
+    def lookup(thread):  # lookups run concurrently (the native call releases the GIL)
+        results[thread] = [
+            [index.lookup(query, 0.5) for query in queries] for _ in range(10)
+        ]
+
+    threads = [threading.Thread(target=lookup, args=(thread,)) for thread in range(4)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    assert len(results) == len(threads)
+    for rounds in results.values():
+        assert all(matches == expected for matches in rounds)
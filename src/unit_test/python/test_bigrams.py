@@ -92,3 +92,45 @@ def test_unicode():
     assert str(bgrms_sorensen) == "Bigrams.wbigrams(size: 7, {" \
         "Sø: 1, en: 2, ns: 1, re: 1, se: 1, ør: 1" \
     "})"
+
+
+def test_bulk():
+    strings = ["Sørensen", "Dice", "", "coefficient"]
+    bulk = Bigrams.bulk(strings)
+    assert [dict(bgrms) for bgrms in bulk] == [dict(Bigrams(string)) for string in strings]
+    assert Bigrams.bulk([]) == []
+
+    union = Bigrams.union(strings)
+    assert dict(union) == dict(sum((Bigrams(s) for s in strings), start=Bigrams()))
+    assert len(Bigrams.union([])) == 0
+
+
+def test_unite():
+    strings = ["Sørensen", "Dice", "", "coefficient", "Dice"]
+    bulk = Bigrams.bulk(strings)
+    union = Bigrams.unite(bulk)
+    assert dict(union) == dict(Bigrams.union(strings))
+    assert len(union) == sum(len(bgrms) for bgrms in bulk)
+    assert len(Bigrams.unite([])) == 0
+
+
+def test_utf8():
+    for string in ("", "ø", "Sørensen", "Dice 😀 coefficient"):
+        assert dict(Bigrams(string.encode("utf-8"))) == dict(Bigrams(string))
+
+    assert dict(Bigrams(b"a\xc3")) == dict(Bigrams("a�"))  # malformed sequence
+
+
+def test_binary():
+    for string in ("", "ø", "Sørensen", "Dice 😀 coefficient"):
+        bgrms = Bigrams(string)
+        data = bgrms.to_bytes()
+        assert isinstance(data, bytes)
+        assert dict(Bigrams.from_bytes(data)) == dict(bgrms)
+
+    for data in (b"", b"SDCX", Bigrams("Dice").to_bytes()[:-1]):
+        try:
+            Bigrams.from_bytes(data)
+            assert False, "Malformed binary is rejected"
+        except ValueError:
+            pass
@@ -0,0 +1,94 @@
+from copy import copy, deepcopy
+
+from pysdcxx import FlatBigrams
+
+
+def test_empty():
+    bgrms = FlatBigrams()
+
+    assert isinstance(bgrms, FlatBigrams)
+    assert len(bgrms) == 0
+    assert list(bgrms) == []
+    assert dict(bgrms) == {}
+    assert str(bgrms) == "FlatBigrams.wflat_bigrams(size: 0, {})"
+
+
+def test_copy():
+    bgrms = FlatBigrams()
+    bgrms_copy = copy(bgrms)
+    bgrms_deepcopy = deepcopy(bgrms)
+
+    assert id(bgrms) != id(bgrms_copy)
+    assert id(bgrms) != id(bgrms_deepcopy)
+    assert id(bgrms_copy) != id(bgrms_deepcopy)
+
+    assert id(bgrms._impl) != id(bgrms_copy._impl)
+    assert id(bgrms._impl) != id(bgrms_deepcopy._impl)
+    assert id(bgrms_copy._impl) != id(bgrms_deepcopy._impl)
+
+
+def test_union():
+    bgrms_abcd = FlatBigrams("abcd")
+
+    assert isinstance(bgrms_abcd, FlatBigrams)
+    assert len(bgrms_abcd) == 3
+    assert list(bgrms_abcd) == [("ab", 1), ("bc", 1), ("cd", 1)]
+    assert dict(bgrms_abcd) == {"ab": 1, "bc": 1, "cd": 1}
+    assert str(bgrms_abcd) == "FlatBigrams.wflat_bigrams(size: 3, {ab: 1, bc: 1, cd: 1})"
+
+    bgrms_bcd = FlatBigrams("bcd")
+
+    assert isinstance(bgrms_bcd, FlatBigrams)
+    assert len(bgrms_bcd) == 2
+    assert list(bgrms_bcd) == [("bc", 1), ("cd", 1)]
+    assert dict(bgrms_bcd) == {"bc": 1, "cd": 1}
+    assert str(bgrms_bcd) == "FlatBigrams.wflat_bigrams(size: 2, {bc: 1, cd: 1})"
+
+    bgrms_union = bgrms_abcd + bgrms_bcd
+
+    assert isinstance(bgrms_union, FlatBigrams)
+    assert len(bgrms_union) == 5
+    assert list(bgrms_union) == [("ab", 1), ("bc", 2), ("cd", 2)]
+    assert dict(bgrms_union) == {"ab": 1, "bc": 2, "cd": 2}
+    assert str(bgrms_union) == "FlatBigrams.wflat_bigrams(size: 5, {ab: 1, bc: 2, cd: 2})"
+
+    # Operands are unchanged
+    assert str(bgrms_abcd) == "FlatBigrams.wflat_bigrams(size: 3, {ab: 1, bc: 1, cd: 1})"
+    assert str(bgrms_bcd) == "FlatBigrams.wflat_bigrams(size: 2, {bc: 1, cd: 1})"
+
+    bgrms_abcd += bgrms_bcd
+
+    assert len(bgrms_abcd) == 5
+    assert list(bgrms_abcd) == [("ab", 1), ("bc", 2), ("cd", 2)]
+    assert dict(bgrms_abcd) == {"ab": 1, "bc": 2, "cd": 2}
+    assert str(bgrms_abcd) == "FlatBigrams.wflat_bigrams(size: 5, {ab: 1, bc: 2, cd: 2})"
+
+    # Right operand is unchanged
+    assert str(bgrms_bcd) == "FlatBigrams.wflat_bigrams(size: 2, {bc: 1, cd: 1})"
+
+
+def test_sdc():
+    bgrms_abcd = FlatBigrams("abcd")
+    bgrms_bcd = FlatBigrams("bcd")
+
+    isect_size = FlatBigrams.intersect_size(bgrms_abcd, bgrms_bcd)
+    assert isect_size == 2  # intersection is {bc, cd}
+
+    sdc = FlatBigrams.sorensen_dice_coef(bgrms_abcd, bgrms_bcd)
+    assert sdc == 2 * 2 / (3 + 2)
+
+
+def test_unicode():
+    bgrms_sorensen = FlatBigrams("Sørensen")
+
+    assert isinstance(bgrms_sorensen, FlatBigrams)
+    assert len(bgrms_sorensen) == 7
+    assert list(bgrms_sorensen) == [
+        ("Sø", 1), ("en", 2), ("ns", 1), ("re", 1), ("se", 1), ("ør", 1),
+    ]
+    assert dict(bgrms_sorensen) == {
+        "Sø": 1, "ør": 1, "re": 1, "en": 2, "ns": 1, "se": 1,
+    }
+    assert str(bgrms_sorensen) == "FlatBigrams.wflat_bigrams(size: 7, {" \
+        "Sø: 1, en: 2, ns: 1, re: 1, se: 1, ør: 1" \
+    "})"
@@ -0,0 +1,95 @@
+from copy import copy, deepcopy
+
+from pysdcxx import HashedBigramMultiset
+
+
+def test_empty():
+    bgrms = HashedBigramMultiset()
+
+    assert isinstance(bgrms, HashedBigramMultiset)
+    assert len(bgrms) == 0
+    assert list(bgrms) == []
+    assert dict(bgrms) == {}
+    assert str(bgrms) == \
+        "HashedBigramMultiset.hashed_wbigram_multiset(size: 0, {})"
+
+
+def test_copy():
+    bgrms = HashedBigramMultiset()
+    bgrms_copy = copy(bgrms)
+    bgrms_deepcopy = deepcopy(bgrms)
+
+    assert id(bgrms) != id(bgrms_copy)
+    assert id(bgrms) != id(bgrms_deepcopy)
+    assert id(bgrms_copy) != id(bgrms_deepcopy)
+
+    assert id(bgrms._impl) != id(bgrms_copy._impl)
+    assert id(bgrms._impl) != id(bgrms_deepcopy._impl)
+    assert id(bgrms_copy._impl) != id(bgrms_deepcopy._impl)
+
+
+def test_union():
+    bgrms_abcd = HashedBigramMultiset("abcd")
+
+    assert isinstance(bgrms_abcd, HashedBigramMultiset)
+    assert len(bgrms_abcd) == 3
+    assert sorted(list(bgrms_abcd)) == ["ab", "bc", "cd"]
+    assert str(bgrms_abcd).startswith(
+        "HashedBigramMultiset.hashed_wbigram_multiset(size: 3, {")
+
+    bgrms_bcd = HashedBigramMultiset("bcd")
+
+    assert isinstance(bgrms_bcd, HashedBigramMultiset)
+    assert len(bgrms_bcd) == 2
+    assert sorted(list(bgrms_bcd)) == ["bc", "cd"]
+    assert str(bgrms_bcd).startswith(
+        "HashedBigramMultiset.hashed_wbigram_multiset(size: 2, {")
+
+    bgrms_union = bgrms_abcd + bgrms_bcd
+
+    assert isinstance(bgrms_union, HashedBigramMultiset)
+    assert len(bgrms_union) == 5
+    assert sorted(list(bgrms_union)) == ["ab", "bc", "bc", "cd", "cd"]
+    assert str(bgrms_union).startswith(
+        "HashedBigramMultiset.hashed_wbigram_multiset(size: 5, {")
+
+    # Operands are unchanged
+    assert sorted(list(bgrms_abcd)) == ["ab", "bc", "cd"]
+    assert sorted(list(bgrms_bcd)) == ["bc", "cd"]
+
+    bgrms_abcd += bgrms_bcd
+
+    assert len(bgrms_abcd) == 5
+    assert sorted(list(bgrms_abcd)) == ["ab", "bc", "bc", "cd", "cd"]
+    assert str(bgrms_abcd).startswith(
+        "HashedBigramMultiset.hashed_wbigram_multiset(size: 5, {")
+
+    # Right operand is unchanged
+    assert sorted(list(bgrms_bcd)) == ["bc", "cd"]
+
+
+def test_sdc():
+    bgrms_abcd = HashedBigramMultiset("abcd")
+    bgrms_bcd = HashedBigramMultiset("bcd")
+
+    isect_size = HashedBigramMultiset.intersect_size(bgrms_abcd, bgrms_bcd)
+    assert isect_size == 2  # intersection is {bc, cd}
+
+    sdc = HashedBigramMultiset.sorensen_dice_coef(bgrms_abcd, bgrms_bcd)
+    assert sdc == 2 * 2 / (3 + 2)
+
+    # Repeated bigrams: {ab: 4, ba: 3} and {ab: 2, ba: 1}
+    bgrms_abab = HashedBigramMultiset("abababab")
+    bgrms_ab = HashedBigramMultiset("abab")
+    assert HashedBigramMultiset.intersect_size(bgrms_abab, bgrms_ab) == 3
+    assert HashedBigramMultiset.intersect_size(bgrms_ab, bgrms_abab) == 3
+
+
+def test_unicode():
+    bgrms_sorensen = HashedBigramMultiset("Sørensen")
+
+    assert isinstance(bgrms_sorensen, HashedBigramMultiset)
+    assert len(bgrms_sorensen) == 7
+    assert sorted(list(bgrms_sorensen)) == ["Sø", "en", "en", "ns", "re", "se", "ør"]
+    assert str(bgrms_sorensen).startswith(
+        "HashedBigramMultiset.hashed_wbigram_multiset(size: 7, {")
@@ -0,0 +1,105 @@
+import os
+import random
+import tempfile
+import threading
+
+from pysdcxx import PatternSet, Patterns, SequenceMatcher, Bigrams
+
+
+def test_empty():
+    patterns = PatternSet([])
+    assert len(patterns) == 0
+    assert not patterns.indexed
+
+
+def test_size():
+    patterns = PatternSet(["abcd", Bigrams("bcd")], index=True)
+    assert len(patterns) == 2
+    assert patterns.indexed
+    assert patterns.blob_size % 64 == 0
+
+
+def test_lookup():
+    patterns = PatternSet(["Sørensen", "Dice", "coefficient", "Sorensen"], index=True)
+    matches = patterns.lookup("Sørenson", 0.7)
+    assert [match.entry for match in matches] == [0]
+    assert matches[0].score == Bigrams.sorensen_dice_coef(Bigrams("Sørensen"), Bigrams("Sørenson"))
+
+    try:
+        PatternSet(["Dice"]).lookup("Dice", 0.5)
+        assert False, "Lookup requires index"
+    except ValueError:
+        pass
+
+
+def test_lookup_threads():
+    rng = random.Random(1)
+    words = ["".join(rng.choice("abcde") for _ in range(rng.randint(1, 8)))
+             for _ in range(1000)]
+    patterns = PatternSet(words, index=True)
+    queries = words[:50]
+    expected = [patterns.lookup(query, 0.5) for query in queries]
+
+    results = {}
+
+    def lookup(thread):  # lookups run concurrently (the native call releases the GIL)
+        results[thread] = [
+            [patterns.lookup(query, 0.5) for query in queries] for _ in range(10)
+        ]
+
+    threads = [threading.Thread(target=lookup, args=(thread,)) for thread in range(4)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    assert len(results) == len(threads)
+    for rounds in results.values():
+        assert all(matches == expected for matches in rounds)
+
+
+def test_match_all():
+    rng = random.Random(1)
+    words = ["".join(rng.choice("abcde") for _ in range(rng.randint(1, 8)))
+             for _ in range(100)]
+    patterns = PatternSet(words)
+    prepared = Patterns(words)
+
+    matchers = [SequenceMatcher(rng.sample(words, 10)) for _ in range(10)]
+    for matcher in matchers:  # the set is shared by all the matchers
+        for threshold in (0.5, 0.8):
+            assert matcher.match_all(patterns, threshold) == \
+                matcher.match_all(prepared, threshold)
+
+
+def test_save_load():
+    words = ["Sørensen", "Dice", "coefficient", "Sorensen", ""]
+    patterns = PatternSet(words, index=True)
+    matcher = SequenceMatcher(["Sørenson", "-", "Dice", "coefficient"])
+
+    with tempfile.TemporaryDirectory() as directory:
+        path = os.path.join(directory, "patterns.sdcxxps")
+        patterns.save(path)
+
+        loaded = PatternSet.load(path)
+        assert len(loaded) == len(patterns)
+        assert not loaded.indexed  # the index isn't saved
+        assert matcher.match_all(loaded, 0.7) == matcher.match_all(patterns, 0.7)
+
+        loaded = PatternSet.load(path, index=True)
+        assert [m.entry for m in loaded.lookup("Sørenson", 0.7)] == \
+            [m.entry for m in patterns.lookup("Sørenson", 0.7)]
+
+        with open(path, "r+b") as file:
+            file.write(b"X")
+        try:
+            PatternSet.load(path)
+            assert False, "Malformed file is rejected"
+        except ValueError:
+            pass
+
+        try:
+            PatternSet.load(os.path.join(directory, "missing"))
+            assert False, "Missing file is rejected"
+        except ValueError:
+            pass
@@ -1,7 +1,10 @@
 from typing import List
+from copy import copy
+import ctypes
 import pytest
 
-from pysdcxx import SequenceMatcher, Bigrams
+from pysdcxx import SequenceMatcher, Patterns, Bigrams
+from pysdcxx.libpysdcxx import SequenceMatchRecord
 
 
 def test_empty():
@@ -67,6 +70,27 @@ def test_append():
     assert len(matcher) == 4
 
 
+def test_clear():
+    matcher = SequenceMatcher(["01", "02", "03"])
+    matcher.clear()
+    assert len(matcher) == 0
+
+    matcher.append("04")
+    assert len(matcher) == 1
+
+
+def test_assign():
+    matcher = SequenceMatcher()
+    for _ in range(3):
+        matcher.assign(["Hello", ("  ",True), "world", (" !",True)])
+        assert len(matcher) == 4
+        assert [(m.begin, m.end) for m in matcher.match("world", 0.9)] == [(2, 3)]
+
+        matcher.assign(iter(["Goodbye", "cruel", "world"]))  # size unknown
+        assert len(matcher) == 3
+        assert [(m.begin, m.end) for m in matcher.match("world", 0.9)] == [(2, 3)]
+
+
 def test_match():
     strip = True
     matcher = SequenceMatcher([
@@ -89,3 +113,236 @@ def test_match():
 
     with pytest.raises(StopIteration):
         next(matches)
+
+
+def test_match_all():
+    strip = True
+    matcher = SequenceMatcher([
+        "This", ("  ",strip), "uses", ("  ",strip),
+        "Sørensen", (" -",strip), "Dice", ("  ",strip),
+        "coefficient", (" .",strip),
+    ])
+
+    sorenson_dice = Bigrams("Sørenson") + Bigrams("and") + Bigrams("Dice")
+    patterns = Patterns([sorenson_dice, "coeficient", "uses", "nothing"])
+    threshold = 0.6
+
+    expected = sorted(
+        (match.begin, match.end, pattern)
+        for pattern, bgrms in enumerate(patterns.bigrams)
+        for match in matcher.match(bgrms, threshold)
+    )
+
+    for _ in range(2):  # patterns may be reused
+        matches = matcher.match_all(patterns, threshold)
+        assert [(m.begin, m.end, m.pattern) for m in matches] == expected
+        assert all(m.score >= threshold for m in matches)
+        assert {m.pattern for m in matches} == {0, 1, 2}
+
+    assert matcher.match_all([], threshold) == []
+    assert len(matcher.match_all(["uses", "Dice"], 0.9)) == 2
+
+
+def test_best_matches():
+    matcher = SequenceMatcher([
+        "Hello", ("  ",True), "world", ("  ",True), "hello", ("  ",True), "word",
+    ])
+
+    ranked = sorted(
+        matcher.match(["hello", "world"], 0.3),
+        key=lambda m: (-m.score, m.begin, m.end),
+    )
+
+    best = matcher.best_matches(["hello", "world"], 3, 0.3)
+    assert [(m.begin, m.end, m.score) for m in best] == \
+        [(m.begin, m.end, m.score) for m in ranked[:3]]
+
+    best = matcher.best_matches("hello")
+    assert [(m.begin, m.end) for m in best] == [(4, 5)]
+
+    disjoint = matcher.best_matches(["hello", "world"], 5, 0.3, non_overlapping=True)
+    assert len(disjoint) > 1
+    assert all(m1.score >= m2.score for m1, m2 in zip(disjoint, disjoint[1:]))
+    for ix, m1 in enumerate(disjoint):
+        for m2 in disjoint[ix + 1:]:
+            assert m1.end <= m2.begin or m2.end <= m1.begin
+
+    assert matcher.best_matches("xyz", 3, 0.5) == []
+
+
+def test_bulk():
+    strip = True
+    tokens = ["ab", "abc", ("  ", strip), "ba"] * 20
+
+    matcher = SequenceMatcher(tokens)  # assigned in one native call
+    mixed = SequenceMatcher([Bigrams("ab")] + tokens[1:])  # assigned 1 by 1
+    assert len(matcher) == len(mixed) == len(tokens)
+
+    expected = [
+        (m.begin, m.end, m.score)
+        for m in mixed.match("ab", 0.5, include_bigrams=True)
+    ]
+    assert len(expected) > 64  # match records buffer shall be enlarged
+
+    for _ in range(2):
+        assert [(m.begin, m.end, m.score) for m in matcher.match("ab", 0.5)] == expected
+
+    for m in matcher.match(["ab", "  ", "abc"], 0.9):
+        assert m.score >= 0.9
+
+
+def test_threads():
+    from threading import Thread
+
+    sentences = [[f"tok{i}", ("  ", True), f"en{i % 7}"] * 10 for i in range(20)]
+    expected = [
+        [(m.begin, m.end) for m in SequenceMatcher(sentence).match("tok1", 0.5)]
+        for sentence in sentences
+    ]
+
+    results = [None] * 4
+
+    def work(t: int):
+        matcher = SequenceMatcher()  # one matcher per thread
+        result = []
+        for sentence in sentences:
+            matcher.assign(sentence)
+            result.append([(m.begin, m.end) for m in matcher.match("tok1", 0.5)])
+        results[t] = result
+
+    threads = [Thread(target=work, args=(t, )) for t in range(len(results))]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    assert all(result == expected for result in results)
+
+
+def test_match_records():
+    strip = True
+    matcher = SequenceMatcher(["ab", "abc", ("  ", strip), "ba"] * 20)
+    expected = [(m.begin, m.end, m.score) for m in matcher.match("ab", 0.5)]
+
+    records = matcher.match_records("ab", 0.5)
+    assert len(records) == len(expected)
+    assert [(r.begin, r.end, r.score) for r in records] == expected
+
+    view = memoryview(records)  # buffer protocol (zero-copy access)
+    assert view.shape == (len(expected), )
+    assert view.itemsize == ctypes.sizeof(SequenceMatchRecord)
+
+    assert len(matcher.match_records("xyz", 0.9)) == 0
+
+    patterns = Patterns(["ab", "ba"])
+    records = matcher.match_all_records(patterns, 0.5)
+    assert [(r.pattern, r.begin, r.end, r.score) for r in records] == [
+        (m.pattern, m.begin, m.end, m.score) for m in matcher.match_all(patterns, 0.5)
+    ]
+
+
+def test_subsequence():
+    matcher = SequenceMatcher(["Sørensen", " -", "Dice"])
+
+    view = matcher.subsequence(0, 3)
+    assert view.is_view
+    assert dict(view) == dict(Bigrams("Sørensen") + Bigrams(" -") + Bigrams("Dice"))
+
+    with pytest.raises(TypeError):
+        view += Bigrams("xyz")
+
+    bgrms = copy(view)  # copies are independent
+    assert not bgrms.is_view
+    bgrms += Bigrams("xyz")
+    assert len(bgrms) == len(view) + 2
+
+    match = next(matcher.match("Dice", 0.9, include_bigrams=True))
+    assert match.bigrams.is_view
+    assert dict(match.bigrams) == dict(Bigrams("Dice"))
+
+    with pytest.raises(SequenceMatcher.Error):
+        matcher.subsequence(2, 2)
+
+
+def test_stale_view():
+    matcher = SequenceMatcher(["hello", "world", "foo"])
+    view = next(matcher.match("helloworld", 0.5, include_bigrams=True)).bigrams
+    bgrms = copy(view)
+    assert not view.is_stale and str(view) == str(bgrms)
+
+    for tokens in (["a", "b"], ["hello", "world", "foo"], ["xyz"] * 10):
+        matcher.assign(tokens)
+
+    assert view.is_stale and not bgrms.is_stale  # copies aren't views
+    for use in (len, str, dict, copy, lambda v: Bigrams.sorensen_dice_coef(v, bgrms)):
+        with pytest.raises(Bigrams.Error):
+            use(view)
+
+    view = matcher.subsequence(0, 2)
+    matcher.append("abc")
+    with pytest.raises(Bigrams.Error):
+        len(view)
+
+    view = matcher.subsequence(0, 2)
+    matcher.clear()
+    assert view.is_stale
+
+
+def test_utf8():
+    strip = True
+    tokens = ["This", "  ", "uses", "  ", "Sørensen", " -", "Dice", " ."]
+    strips = [False, strip, False, strip, False, strip, False, strip]
+    matcher = SequenceMatcher(list(zip(tokens, strips)))
+    expected = [(m.begin, m.end, m.score) for m in matcher.match(["Sørenson", "Dice"], 0.5)]
+    assert expected
+
+    text = "".join(tokens).encode("utf-8")
+    offsets = [0]
+    for token in tokens:
+        offsets.append(offsets[-1] + len(token.encode("utf-8")))
+
+    for buffer in (text, bytearray(text), memoryview(text)):
+        utf8_matcher = SequenceMatcher()
+        utf8_matcher.assign_utf8(buffer, offsets, strips)
+        assert len(utf8_matcher) == len(tokens)
+        assert [
+            (m.begin, m.end, m.score)
+            for m in utf8_matcher.match([b"S\xc3\xb8renson", b"Dice"], 0.5)
+        ] == expected
+
+    bytes_matcher = SequenceMatcher([
+        (token.encode("utf-8"), strip) for token, strip in zip(tokens, strips)])
+    assert [(m.begin, m.end, m.score) for m in bytes_matcher.match("Sørensen", 0.5)] == \
+        [(m.begin, m.end, m.score) for m in matcher.match("Sørensen", 0.5)]
+
+    with pytest.raises(SequenceMatcher.Error):
+        SequenceMatcher().assign_utf8(text, [0, 5, 3])
+
+
+def test_stats():
+    words = ["lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing", "elit"]
+    matcher = SequenceMatcher(words)
+    assert matcher.stats() == SequenceMatcher.Stats(0, 0, 0, 0, 0, 0, 0, 0)
+
+    matches = list(matcher.match("lorem", 1e-6))
+    stats = matcher.stats()
+    assert stats.visited == stats.sdc_computations == 36  # all the sub-sequences
+    assert stats.threshold_rejects == stats.sdc_computations - len(matches)
+    assert stats.card_pruned == stats.strip_skips == stats.unions == 0
+    assert stats.sketch_rejects == 0  # the binding bigrams keep no sketches
+
+    matcher.reset_stats()
+    strip = True
+    matcher.assign([("  ", strip)] + words)
+    matcher.best_matches("lorem ipsum", 2, 0.5)  # computes sub-sequence unions
+    stats = matcher.stats()
+    assert stats.strip_skips > 0
+    assert stats.card_pruned > 0
+    assert stats.visited + stats.card_pruned < 45
+    assert stats.unions > 0
+
+    matcher.subsequence(1, len(matcher))  # too big to be stored inline
+    assert matcher.stats().bytes_allocated > 0
+
+    matcher.reset_stats()
+    assert matcher.stats().visited == 0
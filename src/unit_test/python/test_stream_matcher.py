@@ -0,0 +1,50 @@
+import random
+
+from pysdcxx import StreamMatcher, SequenceMatcher, Bigrams
+
+
+def test_attributes():
+    matcher = StreamMatcher(["Sørensen", "Dice"], 0.7, 4)
+    assert matcher.window == 4
+    assert matcher.position == 0
+
+    for window, threshold in ((0, 0.5), (3, 0.0)):
+        try:
+            StreamMatcher(["Dice"], threshold, window)
+            assert False, "Invalid parameters are rejected"
+        except ValueError:
+            pass
+
+
+def test_push():
+    matcher = StreamMatcher(["Sørensen Dice", "coefficient"], 0.8, 4)
+    assert matcher.push("the") == []
+    assert matcher.push("Sørensen".encode("utf-8")) == []
+    assert matcher.push(" ", True) == []
+
+    matches = matcher.push(Bigrams("Dice"))
+    assert [(m.pattern, m.begin, m.end) for m in matches] == [(0, 0, 4), (0, 1, 4)]
+    assert matcher.position == 4
+
+    matcher.reset()
+    assert matcher.position == 0
+    matches = matcher.extend(["Sørensen", (" ", True), "Dice", (" ", True), "coeficient"])
+    assert [(m.pattern, m.begin, m.end) for m in matches] == [(0, 0, 3), (1, 2, 5), (1, 4, 5)]
+
+
+def test_random():
+    rng = random.Random(1)
+    words = ["".join(rng.choice("abcd") for _ in range(rng.randint(1, 6)))
+             for _ in range(20)]
+    patterns = rng.sample(words, 5)
+    stream = [(rng.choice(words), rng.random() < 0.2) for _ in range(200)]
+
+    expected = sorted(
+        (m.end, m.begin, m.pattern)
+        for m in SequenceMatcher(stream).match_all(patterns, 0.6)
+        if m.end - m.begin <= 3
+    )
+
+    matcher = StreamMatcher(patterns, 0.6, 3)
+    matches = matcher.extend(stream)
+    assert [(m.end, m.begin, m.pattern) for m in matches] == expected